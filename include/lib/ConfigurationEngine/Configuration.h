@@ -193,6 +193,16 @@ public:
      */
     std::list<Instance*>* getUnpartitioned(){return &unpartitioned;}
 
+    /**
+     *  @brief Get the partition of an instance
+     *
+     *  @param instance : the Instance to look for
+     *
+     *  @return the Partition of the instance, NULL if the instance is not partitioned
+     *
+     */
+    Partition* getPartition(Instance* instance);
+
     /**
      *  @brief Get partitions of the current configuration
      *
@@ -47,6 +47,7 @@ class Module;
 }
 
 class Actor;
+class Connection;
 class Decoder;
 //------------------------------
 
@@ -102,8 +103,10 @@ private:
      *  Remove every connections and broadcast created in the decoder
      *
      *  @param decoder : the decoder to clean
+     *
+     *  @param keeps : couples of original and new connections whose fifo is kept, can be NULL
      */
-    void clearConnections(Decoder* decoder);
+    void clearConnections(Decoder* decoder, std::list<std::pair<Connection*, Connection*> >* keeps = NULL);
 
     /** Decoder to configure */
     Decoder* decoder;
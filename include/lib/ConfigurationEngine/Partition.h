@@ -89,6 +89,11 @@ public:
      */
     std::list<Instance*>* getInstances(){return &instances;}
 
+    /*!
+     *  @brief Remove all the instances of the partition
+     */
+    void clear(){instances.clear();}
+
 private:
     std::string id;
     std::list<Instance*> instances;
@@ -14,6 +14,8 @@ parallel applications.
 
 #include "HDAGVertex.h"
 
+class HDAGGraph;
+
 /**
  * An edge in a delay-less HDAG graph (no initial token).
  * The base unit of production and consumption is a char (8 bits).
@@ -39,6 +41,12 @@ private :
         */
     HDAGVertex* sink;
 
+    /**
+         The base, i.e. the graph in which current edge is included. The input and output
+         edges of the vertices are only maintained while the edge belongs to a graph
+        */
+    HDAGGraph* base;
+
 public :
     /**
          Constructor
@@ -92,6 +100,21 @@ public :
         */
     void setSink(HDAGVertex* vertex);
 
+    /**
+         Base getter
+
+         @return the graph containing the edge, or NULL
+        */
+    HDAGGraph* getBase();
+
+    /**
+         Setting the base, i.e. the graph in which current edge is included.
+         Registers or unregisters the edge in its source and sink vertices.
+
+         @param graph: the base, or NULL when the edge is removed from its graph
+        */
+    void setBase(HDAGGraph* graph);
+
     // Public for performance sake
 
     /**
@@ -133,6 +156,10 @@ HDAGVertex* HDAGEdge::getSink(){
 */
 INLINE
 void HDAGEdge::setSource(HDAGVertex* vertex){
+    if(base != NULL){
+        if(source != NULL) source->removeEdge(this, false);
+        if(vertex != NULL) vertex->addEdge(this, false);
+    }
     source = vertex;
 }
 
@@ -143,9 +170,42 @@ void HDAGEdge::setSource(HDAGVertex* vertex){
 */
 INLINE
 void HDAGEdge::setSink(HDAGVertex* vertex){
+    if(base != NULL){
+        if(sink != NULL) sink->removeEdge(this, true);
+        if(vertex != NULL) vertex->addEdge(this, true);
+    }
     sink = vertex;
 }
 
+/**
+ Base getter
+
+ @return the graph containing the edge, or NULL
+*/
+INLINE
+HDAGGraph* HDAGEdge::getBase(){
+    return base;
+}
+
+/**
+ Setting the base, i.e. the graph in which current edge is included.
+ Registers or unregisters the edge in its source and sink vertices.
+
+ @param graph: the base, or NULL when the edge is removed from its graph
+*/
+INLINE
+void HDAGEdge::setBase(HDAGGraph* graph){
+    if(base == NULL && graph != NULL){
+        if(source != NULL) source->addEdge(this, false);
+        if(sink != NULL) sink->addEdge(this, true);
+    }
+    else if(base != NULL && graph == NULL){
+        if(source != NULL) source->removeEdge(this, false);
+        if(sink != NULL) sink->removeEdge(this, true);
+    }
+    base = graph;
+}
+
 /**
  TokenRate getter (token rate = production = consumption in HDAG)
 
@@ -12,6 +12,8 @@ parallel applications.
 #ifndef HDAG_GRAPH
 #define HDAG_GRAPH
 #include <list>
+#include <map>
+#include <vector>
 #include <cstddef>
 
 #include "HDAGVertex.h"
@@ -21,8 +23,9 @@ parallel applications.
 #include "SchedulingError.h"
 
 /**
- * A HDAG graph. It contains HDAG vertices and edges. It has a bigger table for vertices and edges than DAG.
+ * A HDAG graph. It contains HDAG vertices and edges. The tables of vertices and edges grow on demand.
  * Each edge production and consumption must be equal. There is no repetition vector for the vertices.
+ * Every vertex keeps the lists of its input and output edges so that neighbours are found without scanning the graph.
  *
  * @author mpelcat
  */
@@ -31,24 +34,24 @@ class HDAGGraph {
 
 private :
     /**
-         number of HDAG vertices
+         table of HDAG vertices
         */
-    int nbVertices;
+    std::vector<HDAGVertex*> vertices;
 
     /**
-         table of HDAG vertices
+         index of each vertex in the table of vertices
         */
-    HDAGVertex* vertices[MAX_HDAG_VERTICES];
+    std::map<HDAGVertex*, int> vertexIndexes;
 
     /**
-         number of HDAG edges
+         table of HDAG edges
         */
-    int nbEdges;
+    std::vector<HDAGEdge*> edges;
 
     /**
-         table of HDAG edges
+         index of each edge in the table of edges
         */
-    HDAGEdge* edges[MAX_HDAG_EDGES];
+    std::map<HDAGEdge*, int> edgeIndexes;
 
     /**
          Precomputes the successor vertices of a given vertex and stores their pointers in it
@@ -122,7 +125,8 @@ public :
     bool removeEdge(HDAGEdge* edge);
 
     /**
-         Returns a set of all edges connecting source vertex to target vertex if such vertices exist in this graph.
+         Returns a set of all edges connecting source vertex to target vertex if such vertices exist in this graph,
+         an empty set if one of the vertices is NULL.
         */
     std::list<HDAGEdge*>* getAllEdges(HDAGVertex* sourceVertex, HDAGVertex* targetVertex);
 
@@ -207,7 +211,7 @@ public :
     std::list<HDAGEdge*> edgesContainer;
 
     /**
-         Gets the input edges of a given vertex. Careful!! Slow!
+         Gets the input edges of a given vertex
 
          @param vertex: input vertex
          @param output: table to store the edges
@@ -216,7 +220,7 @@ public :
     int getInputEdges(HDAGVertex* vertex, HDAGEdge** output);
 
     /**
-         Gets the output edges of a given vertex. Careful!! Slow!
+         Gets the output edges of a given vertex
 
          @param vertex: input vertex
          @param output: table to store the edges
@@ -264,13 +268,11 @@ HDAGVertex* HDAGGraph::getVertex(int index){
 */
 INLINE
 int HDAGGraph::getVertexIndex(HDAGVertex* vertex){
-    int index;
-    for(index=0;index<nbVertices;index++){
-        if(vertex == vertices[index]){
-            return index;
-        }
+    std::map<HDAGVertex*, int>::iterator it = vertexIndexes.find(vertex);
+    if(it == vertexIndexes.end()){
+        return -1;
     }
-    return -1;
+    return it->second;
 }
 
 /**
@@ -281,13 +283,11 @@ int HDAGGraph::getVertexIndex(HDAGVertex* vertex){
 */
 INLINE
 int HDAGGraph::getEdgeIndex(HDAGEdge* edge){
-    int index;
-    for(index=0;index<nbEdges;index++){
-        if(edge == edges[index]){
-            return index;
-        }
+    std::map<HDAGEdge*, int>::iterator it = edgeIndexes.find(edge);
+    if(it == edgeIndexes.end()){
+        return -1;
     }
-    return -1;
+    return it->second;
 }
 
 /**
@@ -297,7 +297,7 @@ int HDAGGraph::getEdgeIndex(HDAGEdge* edge){
 */
 INLINE
 int HDAGGraph::getNbVertices(){
-    return nbVertices;
+    return vertices.size();
 }
 
 /**
@@ -318,7 +318,7 @@ HDAGEdge* HDAGGraph::getEdge(int index){
 */
 INLINE
 int HDAGGraph::getNbEdges(){
-    return nbEdges;
+    return edges.size();
 }
 
 /**
@@ -331,7 +331,7 @@ int HDAGGraph::getNbEdges(){
 INLINE
 int HDAGGraph::getVerticesFromCSDAGReference(CSDAGVertex* RESTRICT ref, HDAGVertex** RESTRICT output){
     int size = 0;
-    for(int i=0; i<nbVertices; i++){
+    for(unsigned int i=0; i<vertices.size(); i++){
         HDAGVertex* vertex = vertices[i];
         if(vertex->getCsDagReference() == ref){
             output[size] = vertex;
@@ -342,7 +342,7 @@ int HDAGGraph::getVerticesFromCSDAGReference(CSDAGVertex* RESTRICT ref, HDAGVert
 }
 
 /**
- Gets the input edges of a given vertex. Careful!! Slow!
+ Gets the input edges of a given vertex
 
  @param vertex: input vertex
  @param output: table to store the edges
@@ -350,20 +350,15 @@ int HDAGGraph::getVerticesFromCSDAGReference(CSDAGVertex* RESTRICT ref, HDAGVert
 */
 INLINE
 int HDAGGraph::getInputEdges(HDAGVertex* vertex, HDAGEdge** output){
-    int nbEdges = 0;
-    for(int i=0; i<this->nbEdges; i++){
-        HDAGEdge* edge = edges[i];
-        HDAGVertex* sink = edge->getSink();
-        if(sink->equals(vertex)){
-            output[nbEdges] = edge;
-            nbEdges++;
-        }
+    std::vector<HDAGEdge*>* inputs = vertex->getInputEdges();
+    for(unsigned int i=0; i<inputs->size(); i++){
+        output[i] = (*inputs)[i];
     }
-    return nbEdges;
+    return inputs->size();
 }
 
 /**
- Gets the output edges of a given vertex. Careful!! Slow!
+ Gets the output edges of a given vertex
 
  @param vertex: input vertex
  @param output: table to store the edges
@@ -371,16 +366,11 @@ int HDAGGraph::getInputEdges(HDAGVertex* vertex, HDAGEdge** output){
 */
 INLINE
 int HDAGGraph::getOutputEdges(HDAGVertex* RESTRICT vertex, HDAGEdge** RESTRICT output){
-    int nbEdges = 0;
-    for(int i=0; i<this->nbEdges; i++){
-        HDAGEdge* edge = edges[i];
-        HDAGVertex* source = edge->getSource();
-        if(source->equals(vertex)){
-            output[nbEdges] = edge;
-            nbEdges++;
-        }
+    std::vector<HDAGEdge*>* outputs = vertex->getOutputEdges();
+    for(unsigned int i=0; i<outputs->size(); i++){
+        output[i] = (*outputs)[i];
     }
-    return nbEdges;
+    return outputs->size();
 }
 
 /**
@@ -393,17 +383,8 @@ int HDAGGraph::getOutputEdges(HDAGVertex* RESTRICT vertex, HDAGEdge** RESTRICT o
 */
 INLINE
 HDAGVertex* HDAGGraph::addVertex(char* name){
-    HDAGVertex* vertex;
-#ifdef _DEBUG
-    if(nbVertices >= MAX_HDAG_VERTICES){
-        // Adding a vertex while the graph is already full
-        exitWithCode(1000);
-    }
-#endif
-    vertex = vertices[nbVertices];
-    vertex->setBase(this);
-    vertex->setName(name);
-    nbVertices++;
+    HDAGVertex* vertex = new HDAGVertex(name);
+    addVertex(vertex);
     return vertex;
 }
 
@@ -416,15 +397,9 @@ HDAGVertex* HDAGGraph::addVertex(char* name){
 */
 INLINE
 void HDAGGraph::addVertex(HDAGVertex* vertex){
-#ifdef _DEBUG
-    if(nbVertices >= MAX_HDAG_VERTICES){
-        // Adding a vertex while the graph is already full
-        exitWithCode(1000);
-    }
-#endif
-    vertices[nbVertices] = vertex ;
+    vertexIndexes[vertex] = vertices.size();
+    vertices.push_back(vertex);
     vertex->setBase(this);
-    nbVertices++;
 }
 
 /**
@@ -17,6 +17,7 @@ class CSDAGVertex;
 class HDAGGraph;
 class HDAGEdge;
 #include <cstring>
+#include <vector>
 
 #include "SchedulerDimensions.h"
 #include "SchedulingError.h"
@@ -69,8 +70,17 @@ public :
          A table of the vertices following the current vertices in the graph. The table is initialized from
          edges information by the precomputeSuccessors method in HDAGGraph
         */
-    HDAGVertex* successors[MAX_HDAG_INPUT_EDGES];
-    int nbSuccessors;
+    std::vector<HDAGVertex*> successors;
+
+    /**
+         The edges having the current vertex for sink, in insertion order. Kept up to date by HDAGEdge
+        */
+    std::vector<HDAGEdge*> inputEdges;
+
+    /**
+         The edges having the current vertex for source, in insertion order. Kept up to date by HDAGEdge
+        */
+    std::vector<HDAGEdge*> outputEdges;
 public :
 
     /**
@@ -203,6 +213,36 @@ public :
         */
     int getSuccessors(HDAGVertex*** successorVertices);
 
+    /**
+         Gets the edges having the current vertex for sink
+
+         @return the input edges
+        */
+    std::vector<HDAGEdge*>* getInputEdges();
+
+    /**
+         Gets the edges having the current vertex for source
+
+         @return the output edges
+        */
+    std::vector<HDAGEdge*>* getOutputEdges();
+
+    /**
+         Adds an edge in the input or output edges of the vertex
+
+         @param edge: the edge to add
+         @param input: true if the vertex is the sink of the edge
+        */
+    void addEdge(HDAGEdge* edge, bool input);
+
+    /**
+         Removes an edge from the input or output edges of the vertex
+
+         @param edge: the edge to remove
+         @param input: true if the vertex is the sink of the edge
+        */
+    void removeEdge(HDAGEdge* edge, bool input);
+
     /**
          Sets the condition when to HDAGVertex are considered as equal.
 
@@ -354,7 +394,7 @@ char* HDAGVertex::getName(){
 */
 INLINE
 void HDAGVertex::flushSuccessors(){
-    nbSuccessors = 0;
+    successors.clear();
 }
 
 /**
@@ -364,14 +404,7 @@ void HDAGVertex::flushSuccessors(){
 */
 INLINE
 void HDAGVertex::addSuccessor(HDAGVertex* vertex){
-#ifdef _DEBUG
-    if(nbSuccessors >= MAX_HDAG_INPUT_EDGES){
-        // Adding a successor vertex in a full table
-        exitWithCode(1044);
-    }
-#endif
-    successors[nbSuccessors] = vertex;
-    nbSuccessors++;
+    successors.push_back(vertex);
 }
 
 /**
@@ -382,8 +415,58 @@ void HDAGVertex::addSuccessor(HDAGVertex* vertex){
 */
 INLINE
 int HDAGVertex::getSuccessors(HDAGVertex*** successorVertices){
-    *successorVertices = successors;
-    return nbSuccessors;
+    *successorVertices = successors.empty() ? NULL : &successors[0];
+    return successors.size();
+}
+
+/**
+ Gets the edges having the current vertex for sink
+
+ @return the input edges
+*/
+INLINE
+std::vector<HDAGEdge*>* HDAGVertex::getInputEdges(){
+    return &inputEdges;
+}
+
+/**
+ Gets the edges having the current vertex for source
+
+ @return the output edges
+*/
+INLINE
+std::vector<HDAGEdge*>* HDAGVertex::getOutputEdges(){
+    return &outputEdges;
+}
+
+/**
+ Adds an edge in the input or output edges of the vertex
+
+ @param edge: the edge to add
+ @param input: true if the vertex is the sink of the edge
+*/
+INLINE
+void HDAGVertex::addEdge(HDAGEdge* edge, bool input){
+    (input ? inputEdges : outputEdges).push_back(edge);
+}
+
+/**
+ Removes an edge from the input or output edges of the vertex. The order of
+ the remaining edges is kept as it gives the order of the ports.
+
+ @param edge: the edge to remove
+ @param input: true if the vertex is the sink of the edge
+*/
+INLINE
+void HDAGVertex::removeEdge(HDAGEdge* edge, bool input){
+    std::vector<HDAGEdge*>& edges = input ? inputEdges : outputEdges;
+
+    for(std::vector<HDAGEdge*>::iterator it = edges.begin(); it != edges.end(); it++){
+        if(*it == edge){
+            edges.erase(it);
+            return;
+        }
+    }
 }
 
 #endif
@@ -42,12 +42,6 @@ parallel applications.
 #define MAX_CSDAG_PATTERN_TABLE_SIZE 2100 // Maximum size of the whole table containing the patterns of one CSDAG graph
 #define MAX_CSDAG_PATTERN_SIZE 100 // Maximum size of one integer pattern (in number of integers)
 
-// Homogeneous DAG
-#define MAX_HDAG_VERTICES 1024
-#define MAX_HDAG_EDGES 1024
-#define MAX_HDAG_INPUT_EDGES 200
-#define MAX_HDAG_OUTPUT_EDGES 200
-
 // DAG
 #define MAX_DAG_VERTEX_REPETITION 100 // The maximum number of repetitions for one vertex
 
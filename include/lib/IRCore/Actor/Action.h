@@ -106,6 +106,13 @@ public:
      */
     void setBody(Procedure* body){this->body = body;}
 
+    /**
+     *  @brief Setter of the tag of the action
+     *
+     *  @param tag : ActionTag of the action
+     */
+    void setTag(ActionTag* tag){this->tag = tag;}
+
     /**
      *  @brief Getter of the scheduler of the action
      *
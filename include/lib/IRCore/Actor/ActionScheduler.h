@@ -41,11 +41,13 @@
 
 #include <string>
 #include <list>
+#include <map>
 
 #include "lib/IRCore/Actor/FSM.h"
 
 namespace llvm {
 class Function;
+class GlobalVariable;
 }
 
 class Procedure;
@@ -60,6 +62,24 @@ class Action;
  */
 class ActionScheduler {
 public:
+    /** Indexes of the counters of the action scheduler, as schedinfo_s in the orcc runtime */
+    enum Counter {
+        CALLS,      // calls of the action scheduler
+        IDLE,       // calls that fired no action
+        STARVED,    // calls that returned waiting for input tokens
+        FULL,       // calls that returned waiting for output room
+        NB_COUNTERS
+    };
+
+    /** Code shared by a group of instances, removed with the last of them */
+    struct SharedCode {
+        /** Shared copies of the functions */
+        std::list<llvm::Function*> functions;
+
+        /** Instances of the group still calling the shared copies */
+        int users;
+    };
+
     /**
      *  @brief Constructor
      *
@@ -72,6 +92,9 @@ public:
         this->actions = actions;
         this->schedulerFunction = NULL;
         this->initializeFunction = NULL;
+        this->counters = NULL;
+        this->context = NULL;
+        this->sharedCode = NULL;
     }
 
     ~ActionScheduler();
@@ -149,6 +172,69 @@ public:
      */
     bool hasInitializeScheduler(){ return initializeFunction != NULL;}
 
+    /**
+     *  @brief Setter of the counters of the action scheduler
+     *
+     *  @param counters : llvm::GlobalVariable of NB_COUNTERS 64 bits integers indexed by Counter
+     */
+    void setCounters(llvm::GlobalVariable* counters){ this->counters = counters;}
+
+    /**
+     *  @brief Getter of the counters of the action scheduler
+     *
+     *  @return llvm::GlobalVariable of the counters, NULL if calls are not counted
+     */
+    llvm::GlobalVariable* getCounters(){ return counters;}
+
+    /**
+     *  @brief Setter of the firing counter of an action
+     *
+     *  @param action : the counted Action
+     *
+     *  @param firings : 64 bits llvm::GlobalVariable that counts firings of the action
+     */
+    void setFirings(Action* action, llvm::GlobalVariable* firings){ this->firings[action] = firings;}
+
+    /**
+     *  @brief Getter of the firing counter of an action
+     *
+     *  @param action : the counted Action
+     *
+     *  @return llvm::GlobalVariable that counts firings of the action, NULL if not counted
+     */
+    llvm::GlobalVariable* getFirings(Action* action){
+        std::map<Action*, llvm::GlobalVariable*>::iterator it = firings.find(action);
+        return it == firings.end() ? NULL : it->second;
+    }
+
+    /**
+     *  @brief Setter of the context of the action scheduler
+     *
+     *  @param context : llvm::GlobalVariable given to the code shared with other instances
+     */
+    void setContext(llvm::GlobalVariable* context){ this->context = context;}
+
+    /**
+     *  @brief Getter of the context of the action scheduler
+     *
+     *  @return llvm::GlobalVariable of the context, NULL if the code of the instance is not shared
+     */
+    llvm::GlobalVariable* getContext(){ return context;}
+
+    /**
+     *  @brief Setter of the code shared with other instances
+     *
+     *  @param sharedCode : SharedCode called with the context of the instance
+     */
+    void setSharedCode(SharedCode* sharedCode){ this->sharedCode = sharedCode;}
+
+    /**
+     *  @brief Getter of the code shared with other instances
+     *
+     *  @return SharedCode of the group of the instance, NULL if the code of the instance is not shared
+     */
+    SharedCode* getSharedCode(){ return sharedCode;}
+
 private:
     /** llvm::Function corresponding to the action scheduler */
     llvm::Function* schedulerFunction;
@@ -160,6 +246,18 @@ private:
     FSM* fsm;
 
     std::list<Action*>* actions;
+
+    /** Counters of the calls of the action scheduler */
+    llvm::GlobalVariable* counters;
+
+    /** Firing counters of the actions */
+    std::map<Action*, llvm::GlobalVariable*> firings;
+
+    /** Globals of the instance used by shared code */
+    llvm::GlobalVariable* context;
+
+    /** Code shared by the group of the instance */
+    SharedCode* sharedCode;
 };
 
 #endif
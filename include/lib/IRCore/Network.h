@@ -46,6 +46,10 @@
 #include "lib/IRCore/Network/Connection.h"
 #include "lib/IRCore/Network/Vertex.h"
 
+namespace llvm{
+class LLVMContext;
+}
+
 class HDAGGraph;
 class Port;
 //------------------------------
@@ -81,6 +85,7 @@ public:
         this->outputs = outputs;
         this->graph = graph;
         this->mapping = NULL;
+        this->context = NULL;
     }
 
 
@@ -114,6 +119,22 @@ public:
      */
     std::string getName() { return name;}
 
+    /**
+     * @brief Getter of context
+     *
+     * Returns the LLVM context the network has been parsed in
+     *
+     * @return the llvm::LLVMContext of the network, NULL if unknown
+     */
+    llvm::LLVMContext* getContext() { return context;}
+
+    /**
+     * @brief Setter of context
+     *
+     * @param context : the llvm::LLVMContext the network has been parsed in
+     */
+    void setContext(llvm::LLVMContext* context) { this->context = context;}
+
     /*!
      *  @brief Print network in a dot file.
      *
@@ -190,7 +211,7 @@ public:
      *
      * @param instance : the Instance to get incoming connections
      *
-     * @return a list of incoming connections
+     * @return a list of incoming connections, empty if the instance is not in the network
      */
     std::list<Connection*> getInConnections(Instance* instance);
 
@@ -199,7 +220,7 @@ public:
      *
      * @param instance : the Instance to get outgoing connections
      *
-     * @return a list of incoming connections
+     * @return a list of outgoing connections, empty if the instance is not in the network
      */
     std::list<Connection*> getOutConnections(Instance* instance);
 
@@ -214,6 +235,8 @@ public:
      * @param source : the source Vertex
      *
      * @param target : the target Vertex
+     *
+     * @return a list of connections, empty if an instance is not in the network
      */
     std::list<Connection*>* getAllConnections(Instance* source, Instance* target);
 
@@ -254,6 +277,9 @@ private:
 
     /** mapping of the network */
     std::map<std::string, std::string>* mapping;
+
+    /** LLVM context the network has been parsed in */
+    llvm::LLVMContext* context;
 };
 
 #endif
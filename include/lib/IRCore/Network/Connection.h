@@ -146,6 +146,16 @@ public:
      */
     int getSize();
 
+    /*!
+     *  @brief Set the size computed for the connection
+     *
+     *  A bufferSize attribute of the connection still takes precedence.
+     *
+     *  @param size : the computed size, 0 for the default size
+     *
+     */
+    void setComputedSize(int size){this->computedSize = size;}
+
     /*!
      *  @brief Get fifo bound to the connection
      *
@@ -185,6 +195,7 @@ private:
     Port* srcPort;              /** Source Port */
     Port* tgtPort;              /** Destination Port */
     Fifo* fifo;                 /** Fifo of the connection */
+    int computedSize;           /** Size computed for the connection */
     HDAGGraph* parent;          /** Graph of this connection */
 };
 
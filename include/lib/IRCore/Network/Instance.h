@@ -134,6 +134,13 @@ public:
      */
     Vertex* getVertex(){return vertex;}
 
+    /**
+     *  @brief Set the Vertex of the instance
+     *
+     * @param vertex : the vertex of the instance in its network
+     */
+    void setVertex(Vertex* vertex){this->vertex = vertex;}
+
     /**
      * @brief Get the internal state variable corresponding to a port
      *
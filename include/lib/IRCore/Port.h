@@ -44,6 +44,7 @@
 #include <set>
 
 namespace llvm {
+class Function;
 class IntegerType;
 class StringRef;
 class GlobalVariable;
@@ -88,6 +89,12 @@ public:
         this->intern = false;
         this->read = false;
         this->write = false;
+        this->concurrent = false;
+        this->id = NULL;
+        this->highWater = NULL;
+        this->openFn = NULL;
+        this->closeFn = NULL;
+        this->readerId = 0;
         this->graph = graph;
         this->instance = NULL;
         this->actor = NULL;
@@ -110,6 +117,12 @@ public:
         this->intern = false;
         this->read = false;
         this->write = false;
+        this->concurrent = false;
+        this->id = NULL;
+        this->highWater = NULL;
+        this->openFn = NULL;
+        this->closeFn = NULL;
+        this->readerId = 0;
         this->graph = NULL;
         this->instance = NULL;
         this->actor = actor;
@@ -132,6 +145,12 @@ public:
         this->intern = false;
         this->read = false;
         this->write = false;
+        this->concurrent = false;
+        this->id = NULL;
+        this->highWater = NULL;
+        this->openFn = NULL;
+        this->closeFn = NULL;
+        this->readerId = 0;
         this->graph = NULL;
         this->instance = instance;
         this->actor = NULL;
@@ -191,6 +210,9 @@ public:
     /**
      * @brief Get the size of the fifo connected to the port
      *
+     * All the readers of an output port share the same fifo, its size
+     * is the largest size required by their connections.
+     *
      * @return the fifo size
      *
      */
@@ -301,6 +323,58 @@ public:
      */
     llvm::GlobalVariable* getId(){return id;}
 
+    /**
+     * @brief Setter of the high-water mark
+     *
+     * Set the llvm::GlobalVariable that records the largest number of tokens
+     * found in the fifo of the port
+     *
+     * @param highWater : llvm::GlobalVariable of the high-water mark
+     */
+    void setHighWater(llvm::GlobalVariable* highWater){this->highWater = highWater;}
+
+    /**
+     * @brief Getter of the high-water mark
+     *
+     * @return llvm::GlobalVariable of the high-water mark, NULL if fifos are not profiled
+     */
+    llvm::GlobalVariable* getHighWater(){return highWater;}
+
+    /**
+     * @brief Setter of the fifo accessors
+     *
+     * Set the llvm::Function called before the actions of the instance to
+     * open the fifo of the port, and the one called after them to close it
+     *
+     * @param openFn : llvm::Function that opens the fifo
+     *
+     * @param closeFn : llvm::Function that closes the fifo
+     */
+    void setAccessors(llvm::Function* openFn, llvm::Function* closeFn){this->openFn = openFn; this->closeFn = closeFn;}
+
+    /**
+     * @brief Getter of the function that opens the fifo of the port
+     *
+     * @return llvm::Function that opens the fifo, NULL if not created
+     */
+    llvm::Function* getOpenFn(){return openFn;}
+
+    /**
+     * @brief Getter of the function that closes the fifo of the port
+     *
+     * @return llvm::Function that closes the fifo, NULL if not created
+     */
+    llvm::Function* getCloseFn(){return closeFn;}
+
+    /**
+     * @brief Return true if a function opens or closes the fifo of the port
+     *
+     * @param function : the llvm::Function
+     *
+     * @return true if the function is an accessor of the fifo
+     */
+    bool isAccessor(llvm::Function* function){return function != NULL && (function == openFn || function == closeFn);}
+
     /**
      * @brief Set access of the port
      *
@@ -334,6 +408,44 @@ public:
      */
     bool isConnected(){ return !connections.empty();}
 
+    /**
+     * @brief Set the port as accessed concurrently
+     *
+     * A concurrent port is bound to a fifo whose other end is executed
+     * by another thread.
+     *
+     * @param concurrent : whether or not the fifo of the port is shared between threads
+     */
+    void setConcurrent(bool concurrent){this->concurrent = concurrent;}
+
+    /**
+     * @brief Return true if the fifo of the port is shared between threads
+     *
+     * @return true if the port is accessed concurrently
+     */
+    bool isConcurrent(){ return concurrent;}
+
+    /**
+     * @brief Set the position of the port among the readers of its fifo
+     *
+     * @param readerId : index of the read index of the port in the fifo
+     */
+    void setReaderId(int readerId){this->readerId = readerId;}
+
+    /**
+     * @brief Get the position of the port among the readers of its fifo
+     *
+     * @return index of the read index of the port in the fifo
+     */
+    int getReaderId(){ return readerId;}
+
+    /**
+     * @brief Get the connections bound to the port
+     *
+     * @return the connections of the port
+     */
+    std::list<Connection*>* getConnections(){ return &connections;}
+
 protected:
 
     /** name of this port. */
@@ -360,6 +472,13 @@ protected:
     /** Corresponding global variable id */
     llvm::GlobalVariable* id;
 
+    /** High-water mark of the fifo of the port */
+    llvm::GlobalVariable* highWater;
+
+    /** Functions that open and close the fifo of the port */
+    llvm::Function* openFn;
+    llvm::Function* closeFn;
+
     /** Whether or not this port can be read*/
     bool read;
 
@@ -369,6 +488,12 @@ protected:
     /** Internal port */
     bool intern;
 
+    /** Fifo shared between threads */
+    bool concurrent;
+
+    /** Read index of the port in its fifo */
+    int readerId;
+
     /** Corresponding global variable fifo*/
     llvm::GlobalVariable* fifoVar;
 
@@ -42,6 +42,7 @@
 #include "lib/IRJit/LLVMExecution.h"
 
 namespace llvm{
+    class Module;
     class tool_output_file;
 }
 
@@ -95,14 +96,26 @@ public:
     /**
      *  @brief Generate native code for the current decoder
      *
+     *  @param IntermediateAssemblyFile : the assembly file to write
+     *
+     *  @param module : the llvm::Module to compile
+     *
+     *  @param pic : whether or not the code must be position independent
      */
-    llvm::tool_output_file* generateNativeCode(std::string IntermediateAssemblyFile);
+    llvm::tool_output_file* generateNativeCode(std::string IntermediateAssemblyFile, llvm::Module* module, bool pic = false);
 
     /**
      *  @brief Link the output file and generate binary code
      *
+     *  @param IntermediateAssemblyFile : the assembly file to link
+     *
+     *  @param IntermediateDecoderFile : the binary file to write
+     *
+     *  @param shared : whether a shared library is built instead of an executable
+     *
+     *  @return the exit code of the compiler
      */
-    void compileAndLink(std::string IntermediateAssemblyFile, std::string IntermediateDecoderFile);
+    int compileAndLink(std::string IntermediateAssemblyFile, std::string IntermediateDecoderFile, bool shared = false);
 
 private:
     /**
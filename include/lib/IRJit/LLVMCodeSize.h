@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the LLVMCodeSize interface
+@author agent
+@file LLVMCodeSize.h
+@version 1.0
+@date 18/10/2026
+*/
+
+//------------------------------
+#ifndef LLVMCODESIZE_H
+#define LLVMCODESIZE_H
+
+#include <map>
+
+#include "llvm/ExecutionEngine/JITEventListener.h"
+//------------------------------
+
+/**
+ * @brief  This class counts the machine code emitted for a decoder.
+ *
+ * Functions emitted by the JIT are counted until their machine code is freed,
+ * objects loaded by MCJIT are counted as a whole.
+ *
+ * @author agent
+ *
+ */
+class LLVMCodeSize : public llvm::JITEventListener {
+public:
+
+    /**
+     *  @brief Constructor
+     */
+    LLVMCodeSize(){size = 0;}
+
+    /**
+     *  @brief Count the machine code of a function emitted by the JIT
+     */
+    void NotifyFunctionEmitted(const llvm::Function &F, void *Code, size_t Size,
+                               const EmittedFunctionDetails &Details);
+
+    /**
+     *  @brief Uncount the machine code of a function freed by the JIT
+     */
+    void NotifyFreeingMachineCode(void *OldPtr);
+
+    /**
+     *  @brief Count an object loaded by MCJIT
+     */
+    void NotifyObjectEmitted(const llvm::ObjectImage &Obj);
+
+    /**
+     *  @brief Get the size of the machine code of the decoder
+     *
+     *  @return the size in bytes
+     */
+    size_t getSize(){return size;}
+
+private:
+
+    /** Size of the machine code of each emitted function */
+    std::map<void*, size_t> functions;
+
+    /** Size of all the machine code */
+    size_t size;
+};
+
+#endif
@@ -40,13 +40,16 @@
 #define LLVMEXECUTION_H
 
 namespace llvm{
+class DataLayout;
 class Function;
 class GlobalValue;
 class ExecutionEngine;
 class Module;
 }
 
+#include <atomic>
 #include <pthread.h>
+#include <string>
 
 #include "llvm/IR/LLVMContext.h"
 #include "lib/RVCEngine/Decoder.h"
@@ -56,6 +59,11 @@ class Procedure;
 class Port;
 class Display;
 class Source;
+class LLVMTieredCompiler;
+class LLVMObjectCache;
+class LLVMCodeSize;
+class LLVMSymbolMap;
+struct orcc_context_s;
 //------------------------------
 
 /**
@@ -86,7 +94,7 @@ public:
      *
      *  Delete the execution engione
      */
-    ~LLVMExecution();
+    virtual ~LLVMExecution();
 
     /**
      *  @brief map a function in the decider
@@ -114,6 +122,30 @@ public:
      */
     virtual int* initialize();
 
+    /**
+     *  @brief Compile the whole decoder ahead of its execution
+     *
+     *  Links the native procedures and emits the code of every function,
+     *    without running any of them.
+     */
+    void compile();
+
+    /**
+     *  @brief Ask the decoder to pause at a quiescent point
+     *
+     *  The main scheduler returns at the end of its round. run() then
+     *    returns if the decoder holds no token, otherwise the decoder
+     *    is resumed. May be called from another thread.
+     */
+    void pause();
+
+    /**
+     *  @brief Return true if the last run() ended on a pause
+     *
+     *  @return true if the decoder has been paused at a quiescent point
+     */
+    bool isPaused(){return paused.load(std::memory_order_acquire);}
+
     /**
      *  @brief run a specific function of the current decoder
      *
@@ -156,6 +188,13 @@ public:
      */
     void* getGVPtr(llvm::GlobalVariable* gv);
 
+    /**
+     *  @brief Return the layout of the data of the compiled decoder
+     *
+     *  @return the llvm::DataLayout of the execution engine
+     */
+    const llvm::DataLayout* getDataLayout();
+
     /**
      *  @brief map a port to a fifo
      *
@@ -177,6 +216,37 @@ public:
      */
     void linkExternalProc(std::list<Procedure*> externs);
 
+    /**
+     *  @brief Return the on-disk cache of the decoder code
+     *
+     *  @return the LLVMObjectCache, or NULL if the code is not cached
+     */
+    LLVMObjectCache* getObjectCache(){return cache;}
+
+    /**
+     *  @brief Return whether the decoder is compiled by MCJIT
+     *
+     *  Globals of a decoder compiled by MCJIT can't be reached, it can't be
+     *    reconfigured in place.
+     *
+     *  @return true if compiled by MCJIT, false if compiled by the legacy JIT or interpreted
+     */
+    bool isMCJIT(){return mcjit;}
+
+    /**
+     *  @brief Set the input file read by the natives of the decoder
+     *
+     *  @param file : the input file, the global input file if empty
+     */
+    void setInputFile(std::string file);
+
+    /**
+     *  @brief Return the memory taken by the compiled decoder
+     *
+     *  @return the size in bytes of the machine code and of the global variables compiled
+     */
+    size_t getMemorySize();
+
 protected:
 
     /**
@@ -192,6 +262,44 @@ protected:
      */
     void launchPartitions(std::map<Partition*, Scheduler*>* parts);
 
+    /**
+     *  @brief Get the symbol of the native code bound to a native procedure
+     *
+     *  @param procedure : the native Procedure
+     *
+     *  @return the name of the symbol in the native library
+     */
+    std::string getNativeSymbol(Procedure* procedure);
+
+    /**
+     *  @brief Bind the native context of the decoder to the current thread
+     */
+    void bindContext();
+
+    /**
+     *  @brief Clear the stop variable and the stop requests of the natives
+     */
+    void clearStop();
+
+    /**
+     *  @brief Clear the stop variable to resume the main scheduler
+     *
+     *  The stop variable is left set if the natives or stop() asked the
+     *    decoder to stop in the meantime.
+     *
+     *  @return true if the main scheduler can be resumed, otherwise false
+     */
+    bool resume();
+
+    /**
+     *  @brief Map a global of the decoder to an address
+     *
+     *  @param gv : the llvm::GlobalValue to map
+     *
+     *  @param addr : address of the global
+     */
+    void mapGlobal(llvm::GlobalValue* gv, void* addr);
+
     /** Sub thread of the decoder */
     std::list<pthread_t*> threads;
 
@@ -213,6 +321,36 @@ protected:
     /** Stop variable */
     int stopVal;
 
+    /** Whether or not the decoder has been asked to stop */
+    std::atomic<bool> stopped;
+
+    /** Whether or not the decoder has been asked to pause */
+    std::atomic<bool> pausing;
+
+    /** Whether or not the last run ended on a pause */
+    std::atomic<bool> paused;
+
+    /** Background recompilation of the hot instances, NULL if disabled */
+    LLVMTieredCompiler* tiering;
+
+    /** Machine code kept on disk, NULL if disabled */
+    LLVMObjectCache* cache;
+
+    /** Symbols mapped in the code compiled by MCJIT, NULL if not compiled by MCJIT */
+    LLVMSymbolMap* symbols;
+
+    /** Whether or not the decoder is compiled by MCJIT */
+    bool mcjit;
+
+    /** Size of the machine code emitted */
+    LLVMCodeSize* codeSize;
+
+    /** State of the natives called by the decoder */
+    orcc_context_s* nativeContext;
+
+    /** Input file of the decoder */
+    std::string inputFile;
+
     /** verbose */
     bool verbose;
 
@@ -220,6 +358,7 @@ protected:
     struct procThread{
         llvm::ExecutionEngine *EE;
         llvm::Function* func;
+        orcc_context_s* context;
     };
 };
 
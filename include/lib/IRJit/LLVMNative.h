@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the LLVMNative interface
+@author agent
+@file LLVMNative.h
+@version 1.0
+@date 18/10/2026
+*/
+
+//------------------------------
+#ifndef LLVMNATIVE_H
+#define LLVMNATIVE_H
+
+#include "llvm/Transforms/Utils/ValueMapper.h"
+
+#include "lib/IRJit/LLVMArmFix.h"
+//------------------------------
+
+/**
+ * @brief  This class builds the decoder ahead of time for the host
+ *
+ * The decoder is compiled into a standalone executable or a shared library
+ * exporting its initialize and main functions. Native procedures are bound
+ * to the runtime library, so no LLVM is needed to run the decoder.
+ *
+ * @author agent
+ *
+ */
+class LLVMNative : public LLVMArmFix {
+public:
+
+    /**
+     *  @brief Constructor
+     *
+     *  @param C : the llvm::Context
+     *
+     *  @param decoder: the decoder to build
+     *
+     *  @param output: the executable or library to write
+     *
+     *  @param shared: build a shared library instead of an executable
+     *
+     *  @param verbose: verbose actions taken
+     */
+    LLVMNative(llvm::LLVMContext& C, Decoder* decoder, std::string output, bool shared = false, bool verbose = false);
+
+    /**
+     *  @brief Build the current decoder
+     *
+     *  The decoder is not executed.
+     */
+    void run();
+
+private:
+    /**
+     *  @brief Bind native procedures of a module to the symbols of the runtime
+     *
+     *  @param module : the copy of the decoder to build
+     *
+     *  @param VMap : values of the decoder and their copies
+     */
+    void bindNatives(llvm::Module* module, llvm::ValueToValueMapTy& VMap);
+
+    /**
+     *  @brief Create the program entry that parses the command line before running the decoder
+     *
+     *  @param module : the copy of the decoder to build
+     */
+    void createEntry(llvm::Module* module);
+
+    /** Executable or library to write */
+    std::string output;
+
+    /** Build a shared library */
+    bool shared;
+};
+
+#endif
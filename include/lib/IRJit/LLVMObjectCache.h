@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the LLVMObjectCache interface
+@author agent
+@file LLVMObjectCache.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef LLVMOBJECTCACHE_H
+#define LLVMOBJECTCACHE_H
+
+#include <string>
+
+#include "llvm/ExecutionEngine/ObjectCache.h"
+
+namespace llvm{
+class MemoryBuffer;
+class Module;
+}
+//------------------------------
+
+/**
+ * @brief  This class keeps the machine code of the decoders on disk.
+ *
+ * Objects are named after a hash of the configured decoder module, before
+ * any optimization, the optimization level and the target. The decoder module
+ * holds the network, the code of the actors and the sizes of the fifos, so a
+ * change in any of them gives a new object.
+ *
+ * @author agent
+ *
+ */
+class LLVMObjectCache : public llvm::ObjectCache {
+public:
+
+    /**
+     *  @brief Constructor
+     *
+     *  @param directory : directory of the cached objects
+     *
+     *  @param module : the decoder module, not yet optimized
+     *
+     *  @param verbose : verbose actions taken
+     */
+    LLVMObjectCache(std::string directory, llvm::Module* module, bool verbose = false);
+
+    /**
+     *  @brief Set the optimization level of the decoder
+     *
+     *  @param optLevel : the optimization level
+     */
+    void setOptLevel(int optLevel){this->optLevel = optLevel;}
+
+    /**
+     *  @brief Check if the object of the decoder is in the cache
+     *
+     *  @return true if the object exists, otherwise false
+     */
+    bool hasObject();
+
+    /**
+     *  @brief Write the object of a module compiled by the execution engine
+     *
+     *  @param M : the compiled llvm::Module
+     *
+     *  @param Obj : the machine code of the module
+     */
+    void notifyObjectCompiled(const llvm::Module* M, const llvm::MemoryBuffer* Obj);
+
+    /**
+     *  @brief Read the object of a module
+     *
+     *  @param M : the llvm::Module to compile
+     *
+     *  @return the machine code of the module, or NULL if not in the cache
+     */
+    llvm::MemoryBuffer* getObject(const llvm::Module* M);
+
+private:
+
+    /**
+     *  @brief Path of the object of the decoder
+     */
+    std::string getPath();
+
+    /** Directory of the cached objects */
+    std::string directory;
+
+    /** Hash of the decoder module */
+    std::string moduleHash;
+
+    /** Target triple of the decoder module */
+    std::string triple;
+
+    /** Optimization level of the decoder */
+    int optLevel;
+
+    /** verbose */
+    bool verbose;
+};
+
+#endif
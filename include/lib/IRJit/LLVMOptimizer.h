@@ -39,6 +39,9 @@
 #ifndef LLVMOPTIMIZER_H
 #define LLVMOPTIMIZER_H
 
+#include <string>
+#include <vector>
+
 #include "llvm/IR/LLVMContext.h"
 
 namespace llvm {
@@ -48,6 +51,7 @@ namespace llvm {
     }
 }
 
+class Decoder;
 //------------------------------
 
 /**
@@ -82,7 +86,27 @@ public:
      *  @param optLevel : optimization level
      */
     void optimize(int optLevel);
+
+    /**
+     *  @brief Get the cpu targeted by the generated code
+     *
+     *  @return the cpu given by -mcpu, otherwise the cpu of the host
+     */
+    static std::string getCPU();
+
+    /**
+     *  @brief Get the features of the cpu targeted by the generated code
+     *
+     *  @return the attributes given by -mattr, otherwise the features detected on the host
+     */
+    static std::vector<std::string> getFeatures();
+
 private:
+    /**
+     *  @brief Print the functions that use vector instructions
+     */
+    void reportVectorization();
+
 
     void AddOptimizationPasses(llvm::legacy::PassManagerBase &MPM, llvm::legacy::FunctionPassManager &FPM, unsigned OptLevel);
     Decoder* decoder;
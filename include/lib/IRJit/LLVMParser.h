@@ -39,6 +39,11 @@
 #ifndef LLVMPARSER_H
 #define LLVMPARSER_H
 
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "llvm/IR/Module.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Support/Signals.h"
@@ -68,7 +73,8 @@ public:
     /**
      *  @brief Load and parse the module file
      *
-     *  Read the specified file as an LLVM module.
+     *  Read the specified file as an LLVM module. Bodies of functions
+     *   are only read when materialized.
      *
      * @param package : the package that contains the actor
      *
@@ -79,6 +85,22 @@ public:
      */
     llvm::Module* loadModule(Package* package, std::string file);
 
+    /**
+     *  @brief Load and parse several module files on a pool of threads
+     *
+     *  Each worker reads files with its own llvm::LLVMContext. Textual files are
+     *  parsed by the worker and written back as bitcode, the bitcode is then read
+     *  lazily in the context of the parser.
+     *
+     * @param files : the files to parse, with the package that contains them
+     *
+     * @param nbThreads : number of workers, 0 for one per core
+     *
+     * @return the corresponding llvm::Modules, in the order of files
+     *
+     */
+    std::vector<llvm::Module*> loadModules(std::vector<std::pair<Package*, std::string> >* files, int nbThreads = 0);
+
     /** default directory of the actor */
     std::string directory;
 
@@ -88,6 +110,23 @@ public:
     /** Print information about actor taken*/
     bool verbose;
 
+private:
+
+    /** Files shared by the workers of loadModules */
+    struct LoadJob{
+        std::vector<std::string> filenames;
+        std::vector<std::string> bitcodes;
+        std::vector<std::string> errors;
+        std::vector<int> times;
+        std::atomic<int> next;
+    };
+
+    /**
+     *  @brief Static method for launching workers of loadModules in threads
+     *
+     */
+    static void* loadProc(void* args);
+
 };
 
 #endif
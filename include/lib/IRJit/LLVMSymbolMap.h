@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the LLVMSymbolMap interface
+@author agent
+@file LLVMSymbolMap.h
+@version 1.0
+@date 18/10/2026
+*/
+
+//------------------------------
+#ifndef LLVMSYMBOLMAP_H
+#define LLVMSYMBOLMAP_H
+
+#include <map>
+#include <string>
+
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+//------------------------------
+
+/**
+ * @brief  This class resolves the globals mapped in a decoder compiled by MCJIT.
+ *
+ * MCJIT links the external symbols of the objects it loads by name and does
+ * not look at the global mappings of the execution engine, the addresses of
+ * the stop variables and of the natives are given here instead.
+ *
+ * @author agent
+ *
+ */
+class LLVMSymbolMap : public llvm::SectionMemoryManager {
+public:
+
+    /**
+     *  @brief Map a symbol to an address
+     *
+     *  @param name : name of the symbol
+     *
+     *  @param addr : address of the symbol
+     */
+    void map(const std::string& name, void* addr);
+
+    /**
+     *  @brief Get the address of a symbol, mapped or found in the process
+     *
+     *  @param name : name of the symbol
+     *
+     *  @return the address of the symbol, 0 if not found
+     */
+    uint64_t getSymbolAddress(const std::string& name);
+
+private:
+
+    /** Address of the mapped symbols */
+    std::map<std::string, void*> symbols;
+};
+
+#endif
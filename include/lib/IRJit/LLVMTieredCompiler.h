@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the LLVMTieredCompiler interface
+@author agent
+@file LLVMTieredCompiler.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef LLVMTIEREDCOMPILER_H
+#define LLVMTIEREDCOMPILER_H
+
+#include <list>
+#include <set>
+#include <pthread.h>
+
+namespace llvm{
+class ExecutionEngine;
+class Function;
+}
+
+class Decoder;
+class Instance;
+//------------------------------
+
+/**
+ * @brief  This class recompiles the hot instances of a running decoder.
+ *
+ * The decoder starts with the code emitted from the unoptimized module.
+ * A background thread looks at the firing counters of the action schedulers
+ * and optimizes the functions of the instances that fired more than a
+ * threshold. The main scheduler is then stopped so that the new code can be
+ * relinked while no action scheduler is running.
+ *
+ * @author agent
+ *
+ */
+class LLVMTieredCompiler {
+public:
+
+    /**
+     *  @brief Constructor
+     *
+     *  @param EE : the llvm::ExecutionEngine running the decoder
+     *
+     *  @param decoder : the decoder to recompile
+     *
+     *  @param stopVar : address of the stop variable of the main scheduler
+     *
+     *  @param verbose : verbose actions taken
+     */
+    LLVMTieredCompiler(llvm::ExecutionEngine* EE, Decoder* decoder, int* stopVar, bool verbose = false);
+
+    /**
+     *  @brief Destructor
+     *
+     *  Stop the background thread if still running
+     */
+    ~LLVMTieredCompiler();
+
+    /**
+     *  @brief Start the background thread
+     */
+    void start();
+
+    /**
+     *  @brief Stop and join the background thread
+     */
+    void stop();
+
+    /**
+     *  @brief Relink the optimized functions
+     *
+     *  Must be called from the thread of the main scheduler once it has returned.
+     *    The stop variable is left set, the caller clears it to resume the scheduler.
+     *
+     *  @return true if the main scheduler has been stopped to relink code, false otherwise
+     */
+    bool relink();
+
+private:
+
+    /**
+     *  @brief Static method for launching the background thread
+     *
+     */
+    static void* threadProc(void* args);
+
+    /**
+     *  @brief Look periodically for hot instances until stopped
+     */
+    void watch();
+
+    /**
+     *  @brief Number of firings of an instance
+     *
+     *  @param instance : the Instance to count firings from
+     *
+     *  @return the sum of the firings of its actions
+     */
+    long long getFirings(Instance* instance);
+
+    /**
+     *  @brief Functions of the actions of an instance
+     *
+     *  @param instance : the Instance, or the SuperInstance whose instances are looked at
+     *
+     *  @param functions : set where the guards and bodies of the actions are added
+     */
+    void getActions(Instance* instance, std::set<llvm::Function*>* functions);
+
+    /**
+     *  @brief Optimize the functions of a hot instance
+     *
+     *  The actions are inlined into the action scheduler before running the function passes.
+     *
+     *  @param instance : the hot Instance
+     *
+     *  @param functions : list where the optimized functions to relink are added
+     */
+    void optimize(Instance* instance, std::list<llvm::Function*>* functions);
+
+    /**
+     *  @brief Inline the actions of an instance into its action scheduler
+     *
+     *  @param scheduler : the action scheduler function
+     *
+     *  @param actions : functions of the guards and bodies of the actions
+     */
+    void inlineActions(llvm::Function* scheduler, std::set<llvm::Function*>* actions);
+
+    /** Execution engine of the decoder */
+    llvm::ExecutionEngine* EE;
+
+    /** Decoder recompiled */
+    Decoder* decoder;
+
+    /** Stop variable of the main scheduler */
+    int* stopVar;
+
+    /** Instances already optimized */
+    std::set<Instance*> promoted;
+
+    /** Optimized functions waiting to be relinked */
+    std::list<llvm::Function*> ready;
+
+    /** Whether or not the main scheduler has been stopped to relink code */
+    bool requested;
+
+    /** Protect the list of functions to relink and the stop request */
+    pthread_mutex_t lock;
+
+    /** Background thread */
+    pthread_t thread;
+
+    /** Whether or not the background thread is running */
+    volatile bool running;
+
+    /** verbose */
+    bool verbose;
+};
+
+#endif
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the LLVMWorkStealing interface
+@author agent
+@file LLVMWorkStealing.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef LLVMWORKSTEALING_H
+#define LLVMWORKSTEALING_H
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include "lib/IRJit/LLVMExecution.h"
+
+class Instance;
+//------------------------------
+
+/**
+ * @brief  This class executes a decoder on a pool of worker threads.
+ *
+ * Action schedulers of the instances are called directly by the workers
+ * instead of the network scheduler. Each worker owns a deque of ready
+ * instances and steals from the other workers when its own deque is empty.
+ * An instance is executed by at most one worker at a time, so no XCF
+ * mapping is needed to use several cores.
+ *
+ * @author agent
+ *
+ */
+class LLVMWorkStealing : public LLVMExecution {
+public:
+
+    /**
+     *  @brief Constructor
+     *
+     *  Initialize the execution engine
+     *
+     *  @param C : the llvm::Context
+     *
+     *  @param decoder: the decoder to execute
+     *
+     *  @param nbThreads: number of worker threads
+     *
+     *  @param verbose: verbose actions taken
+     *
+     */
+    LLVMWorkStealing(llvm::LLVMContext& C, Decoder* decoder, int nbThreads, bool verbose = false);
+
+    /**
+     *  @brief Destructor
+     *
+     *  Delete the workers and the tasks
+     */
+    ~LLVMWorkStealing();
+
+    /**
+     *  @brief Run the current decoder
+     *
+     *  Start the workers and execute the instances until the decoder is stopped.
+     */
+    void run();
+
+private:
+
+    /** Action scheduler of an instance as seen by the workers */
+    struct Task{
+        Instance* instance;
+        int (*scheduler)();
+        std::vector<int> neighbours;
+        std::atomic<bool> queued;
+        std::atomic<bool> running;
+    };
+
+    /** Deque and statistics of a worker thread */
+    struct Worker{
+        LLVMWorkStealing* parent;
+        int id;
+        std::deque<int> tasks;
+        pthread_mutex_t lock;
+        long long calls;
+        long long idleCalls;
+        long long steals;
+    };
+
+    /**
+     *  @brief Static method for launching workers in threads
+     *
+     */
+    static void* workerProc(void* args);
+
+    /**
+     *  @brief Create a task for each instance of the decoder
+     *
+     */
+    void createTasks();
+
+    /**
+     *  @brief Delete the tasks of a previous run
+     *
+     */
+    void clearTasks();
+
+    /**
+     *  @brief Execution loop of a worker
+     *
+     *  @param worker : the Worker to run
+     */
+    void work(Worker* worker);
+
+    /**
+     *  @brief Push a task at the bottom of a worker deque if not already queued
+     *
+     *  @param worker : the Worker that owns the deque
+     *
+     *  @param task : index of the task
+     */
+    void push(Worker* worker, int task);
+
+    /**
+     *  @brief Pop a task from the bottom of the worker deque
+     *
+     *  @param worker : the Worker that owns the deque
+     *
+     *  @param task : index of the popped task
+     *
+     *  @return true if a task has been popped, otherwise false
+     */
+    bool pop(Worker* worker, int& task);
+
+    /**
+     *  @brief Steal a task from the top of another worker deque
+     *
+     *  @param thief : the Worker that is stealing
+     *
+     *  @param task : index of the stolen task
+     *
+     *  @return true if a task has been stolen, otherwise false
+     */
+    bool steal(Worker* thief, int& task);
+
+    /**
+     *  @brief Print per-worker statistics
+     *
+     */
+    void printStatistics();
+
+    /** Number of worker threads */
+    int nbThreads;
+
+    /** Tasks of the decoder */
+    std::vector<Task*> tasks;
+
+    /** Workers of the decoder */
+    std::vector<Worker*> workers;
+};
+
+#endif
@@ -66,8 +66,24 @@ public:
 private:
     /**
      * @brief Merge two instance in a network
+     *
+     * @param src : the source Instance
+     *
+     * @param dst : the destination Instance
+     *
+     * @return the SuperInstance that replaces the two instances, NULL if their rates are not consistent
+     *  or if a port between them has other readers
+     */
+    SuperInstance* mergeInstance(Instance* src, Instance* dst);
+
+    /**
+     * @brief Return true if the instance is static and can be merged
+     *
+     * @param instance : the Instance to test
+     *
+     * @return true if the instance can be merged, otherwise false
      */
-    void mergeInstance(Instance* src, Instance* dst);
+    bool isMergeable(Instance* instance);
 
     /**
      * @brief Get a SuperInstance of the given instance
@@ -104,6 +120,12 @@ private:
     /** Index of merger */
     int index;
 
+    /** Scheduler calls removed by merging */
+    int calls;
+
+    /** Fifos removed by merging */
+    int fifos;
+
     /** Configuration to update */
     Configuration* configuration;
 
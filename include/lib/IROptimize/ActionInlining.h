@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the ActionInlining interface
+@author agent
+@file ActionInlining.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef ACTIONINLINING_H
+#define ACTIONINLINING_H
+
+#include <set>
+
+#include "DecoderTransformation.h"
+
+namespace llvm{
+class Function;
+}
+
+class Instance;
+//------------------------------
+
+/**
+ * @brief  This transformation inlines actions into the action scheduler of each instance of a decoder
+ *
+ * isSchedulable, bodies and fsm functions are inlined into the scheduler and
+ * initialize functions of the instance. Functions that are no longer called
+ * lose their bodies, they are kept as declarations as instances still refer to them.
+ *
+ * Instances sharing their code (-share-actor-code) are left as is: the sharing
+ * runs first, when the decoder is created, and their functions only call the
+ * shared copies. The two transformations exclude each other.
+ *
+ * @author agent
+ *
+ */
+class ActionInlining : public DecoderTransformation{
+public:
+    void transform(Decoder* decoder);
+
+private:
+    void doInline(Instance* instance);
+
+    /**
+     * @brief Get the functions of the actions of an instance
+     *
+     * @param instance : the Instance, a SuperInstance gives the actions of its instances
+     *
+     * @param functions : set filled with the functions
+     */
+    void getActions(Instance* instance, std::set<llvm::Function*>* functions);
+
+    /**
+     * @brief Inline calls to the given functions, including calls brought by inlining
+     *
+     * @param caller : the llvm::Function where calls are inlined
+     *
+     * @param functions : the llvm::Function to inline
+     */
+    void inlineCalls(llvm::Function* caller, std::set<llvm::Function*>* functions);
+};
+
+#endif
@@ -39,18 +39,33 @@
 #ifndef FIFOFNREMOVAL_H
 #define FIFOFNREMOVAL_H
 
+#include "llvm/ADT/StringRef.h"
+
 #include "lib/IROptimize/DecoderTransformation.h"
 //------------------------------
 
 /**
  * @brief  This transformation remove fifo function from a decoder
  *
+ * get_num_Tokens and get_room functions are inlined in their callers,
+ * then removed from the decoder.
+ *
  * @author Jerome Gorin
  *
  */
 class FifoFnRemoval : public DecoderTransformation{
 public:
     void transform(Decoder* decoder);
+
+private:
+    /**
+     * @brief Check if a function is an accessor of the fifo states
+     *
+     * @param name : name of the function
+     *
+     * @return true if the function reads the number of tokens or the room of a fifo
+     */
+    bool isFifoFn(llvm::StringRef name);
 };
 
 #endif
@@ -46,7 +46,7 @@ class Instance;
 class Procedure;
 
 /**
- * @brief  This transformation internalize procedure and isSchedulable of each instance of a decoder
+ * @brief  This transformation internalize isSchedulable and bodies of each instance of a decoder
  *
  * @author Jerome Gorin
  *
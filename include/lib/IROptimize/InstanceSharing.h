@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the InstanceSharing interface
+@author agent
+@file InstanceSharing.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef INSTANCESHARING_H
+#define INSTANCESHARING_H
+
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "DecoderTransformation.h"
+
+namespace llvm{
+class Constant;
+class Function;
+class GlobalValue;
+class GlobalVariable;
+class Instruction;
+class Module;
+class StructType;
+class Value;
+}
+
+class Instance;
+//------------------------------
+
+/**
+ * @brief  This transformation shares the code of the instances of a same actor.
+ *
+ * Instances of an actor with identical parameters have the same functions,
+ * except for the globals of the instance they refer to. The functions of one
+ * of them are copied once with a pointer to a context as first argument, the
+ * context holding the addresses of these globals. Functions of each instance
+ * then only call the shared copy with the context of the instance.
+ *
+ * Shared instances are not inlined by ActionInlining afterwards, the two
+ * transformations exclude each other.
+ *
+ * @author agent
+ *
+ */
+class InstanceSharing : public DecoderTransformation{
+public:
+    InstanceSharing(bool verbose = false);
+
+    void transform(Decoder* decoder);
+
+private:
+    /** Globals of an instance corresponding to the globals of the reference instance */
+    typedef std::map<llvm::GlobalValue*, llvm::GlobalValue*> GlobalMap;
+
+    /** Instances sharing the code of a reference instance */
+    struct Group{
+        Instance* reference;
+        std::list<Instance*> instances;
+        std::map<Instance*, GlobalMap> globals;
+    };
+
+    /**
+     * @brief Functions of an instance, in the same order for all instances of an actor
+     *
+     * @param instance : the Instance
+     *
+     * @return the functions of the instance, NULL where the instance has no such function
+     */
+    std::vector<llvm::Function*> getFunctions(Instance* instance);
+
+    /**
+     * @brief Check that two instances have the same parameter values
+     */
+    bool sameParameters(Instance* reference, Instance* instance);
+
+    /**
+     * @brief Check that the functions of two instances only differ by their globals
+     *
+     * @param reference : the reference Instance
+     *
+     * @param instance : the Instance to compare
+     *
+     * @param globals : filled with the globals of instance used in place of those of reference
+     *
+     * @return true if instance can share the code of reference
+     */
+    bool matchInstance(Instance* reference, Instance* instance, GlobalMap* globals);
+
+    bool matchFunction(llvm::Function* reference, llvm::Function* function,
+                       std::map<llvm::Function*, llvm::Function*>* functions, GlobalMap* globals);
+
+    bool matchValue(llvm::Value* reference, llvm::Value* value, std::map<llvm::Value*, llvm::Value*>* locals,
+                    std::map<llvm::Function*, llvm::Function*>* functions, GlobalMap* globals);
+
+    /**
+     * @brief Create the shared code of a group and the contexts of its instances
+     *
+     * @param group : the Group to share
+     */
+    void share(Group* group);
+
+    /**
+     * @brief Copy a function of the reference instance with a context argument
+     */
+    llvm::Function* createShared(llvm::Function* function, llvm::StructType* contextTy);
+
+    /**
+     * @brief Access globals of the reference instance through the context
+     *
+     * @param shared : the shared copy
+     *
+     * @param entries : index of the globals in the context
+     *
+     * @param functions : shared copies of the functions of the reference instance
+     */
+    void useContext(llvm::Function* shared, std::map<llvm::GlobalValue*, int>* entries,
+                    std::map<llvm::Function*, llvm::Function*>* functions);
+
+    /**
+     * @brief Replace constant expressions that refer to globals of the context by instructions
+     */
+    void expandConstants(llvm::Function* shared, std::map<llvm::GlobalValue*, int>* entries);
+
+    llvm::Value* expandConstant(llvm::Constant* constant, llvm::Instruction* pos, std::map<llvm::GlobalValue*, int>* entries);
+
+    bool usesEntries(llvm::Constant* constant, std::map<llvm::GlobalValue*, int>* entries);
+
+    /**
+     * @brief Replace the body of a function of an instance by a call to the shared code
+     */
+    void createWrapper(llvm::Function* function, llvm::Function* shared, llvm::GlobalVariable* context);
+
+    /** Module of the decoder */
+    llvm::Module* module;
+
+    /** Display information about sharing */
+    bool verbose;
+};
+
+#endif
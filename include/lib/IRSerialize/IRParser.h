@@ -74,8 +74,10 @@ public:
      *
      * @param fifo : AbstractFifo used in actors of the VTL
      *
+     * @param verbose : print loading times of the actors
+     *
      */
-    IRParser(llvm::LLVMContext& C,  std::string VTLDir);
+    IRParser(llvm::LLVMContext& C,  std::string VTLDir, bool verbose = false);
 
     ~IRParser();
 
@@ -92,8 +94,35 @@ public:
      */
     Actor* parseActor(std::string classz);
 
+    /**
+     *  @brief Parse the given actors
+     *
+     *  Load the modules of the actors on a pool of threads and
+     *   create a new Actor for each classz
+     *
+     * @param classzs : classzs corresponding to the actors
+     *
+     * @param nbThreads : number of threads loading modules, 0 for one per core
+     *
+     * @return a map of classz and their actors
+     *
+     */
+    std::map<std::string, Actor*>* parseActors(std::list<std::string>* classzs, int nbThreads = 0);
+
 private:
 
+    /**
+     *  @brief Create an actor from its module
+     *
+     * @param classz : classz corresponding to the actor
+     *
+     * @param module : the llvm::Module of the actor
+     *
+     * @return actor resulting from the module
+     *
+     */
+    Actor* parseActor(std::string classz, llvm::Module* module);
+
     /**
      * @brief parse a state variable
      *
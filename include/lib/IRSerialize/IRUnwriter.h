@@ -153,6 +153,16 @@ private:
      */
     void unwriteActionScheduler(ActionScheduler* actionScheduler);
 
+    /**
+     * @brief Unwrite the code shared with other instances
+     *
+     * Erase the shared copies of the functions once the last instance of the
+     * group calling them is removed.
+     *
+     * @param actionScheduler : the actionScheduler of the removed instance
+     */
+    void unwriteSharedCode(ActionScheduler* actionScheduler);
+
     /**
      * @brief Unwrite a list of actions
      *
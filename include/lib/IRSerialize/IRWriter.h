@@ -40,9 +40,11 @@
 #define IRWRITER_H
 
 #include <map>
+#include <set>
 
 namespace llvm{
 class ConstantInt;
+class Function;
 class Module;
 }
 
@@ -260,7 +262,8 @@ private:
     /**
      * @brief Write a list of procedures
      *
-     * Write the given list of procedure for an Instance.
+     * Write the given list of procedure for an Instance. Only declarations
+     * are written, bodies are linked by linkProcedures.
      *
      * @param procs : the procedures to write
      *
@@ -268,6 +271,18 @@ private:
      */
     std::map<std::string, Procedure*>* writeProcedures(std::map<std::string, Procedure*>* procs);
 
+    /**
+     * @brief Link bodies of the procedures called by the instance
+     *
+     * Procedures never called by the actions of the instance are removed,
+     * so their bodies are never read from the actor.
+     *
+     * @param srcProcs : the procedures of the actor
+     *
+     * @param procs : the corresponding procedures in the decoder
+     */
+    void linkProcedures(std::map<std::string, Procedure*>* srcProcs, std::map<std::string, Procedure*>* procs);
+
     /**
      * @brief Write an action scheduler
      *
@@ -336,6 +351,37 @@ private:
      */
     std::pair<Action*, CSDFMoC*> writeConfiguration(Action* action, CSDFMoC* csdfMoC);
 
+    /**
+     * @brief Specialize the code of the instance for its parameter values
+     *
+     * Parameters become constants of the instance, so that the expressions
+     * depending on them are folded. Actions whose guard is always false for
+     * this instance are removed when the MoC of the instance is dynamic.
+     *
+     * @param actions : the actions of the instance
+     *
+     * @param moc : the MoC of the instance
+     */
+    void specializeParameters(std::list<Action*>* actions, MoC* moc);
+
+    /**
+     * @brief Fold constant instructions and branches of a function
+     *
+     * @param function : the llvm::Function to simplify
+     *
+     * @return true if the function has been modified
+     */
+    bool foldConstants(llvm::Function* function);
+
+    /**
+     * @brief Remove and delete the actions that never fire
+     *
+     * @param actions : the actions of the instance
+     *
+     * @param deads : the Actions to remove
+     */
+    void removeActions(std::list<Action*>* actions, std::set<Action*>* deads);
+
 
     /**
      * @brief Store the action for a later use.
@@ -39,6 +39,8 @@
 #ifndef PACKAGEMNG_H
 #define PACKAGEMNG_H
 
+#include <pthread.h>
+
 #include "lib/IRCore/Actor.h"
 #include "lib/IRCore/Package.h"
 //------------------------------
@@ -201,6 +203,9 @@ private:
     /** Package preloaded */
     static std::map<std::string, Package*>* packages;
 
+    /** Protect the preloaded packages */
+    static pthread_mutex_t packagesLock;
+
 };
 
 #endif
@@ -42,6 +42,7 @@
 #include <string>
 #include <map>
 #include <list>
+#include <ostream>
 #include <pthread.h>
 
 namespace llvm{
@@ -96,6 +97,14 @@ public:
      */
     llvm::Module* getModule(){return module;}
 
+    /**
+     *  @brief Getter of context
+     *
+     *  @return llvm::LLVMContext the decoder is built and executed in
+     *
+     */
+    llvm::LLVMContext& getContext(){return Context;}
+
     /**
      *  @brief Getter of configuration
      *
@@ -116,6 +125,22 @@ public:
      */
     void setConfiguration(Configuration* newConfiguration);
 
+    /**
+     *  @brief Getter of identity
+     *
+     *  @return identity of the network the decoder has been built for, as parsed
+     *
+     */
+    std::string getIdentity(){return identity;}
+
+    /**
+     *  @brief Setter of identity
+     *
+     *  @param identity : identity of the network the decoder is built for, as parsed
+     *
+     */
+    void setIdentity(std::string identity){this->identity = identity;}
+
 
     /**
      *  @brief Returns the external procedures of the decoder
@@ -161,6 +186,15 @@ public:
      */
     void stop();
 
+    /**
+     *  @brief Return true if the decoder holds no token
+     *
+     *  Must be called while no scheduler of the decoder is running.
+     *
+     *  @return true if every compiled fifo of the decoder is empty
+     */
+    bool isQuiescent();
+
     /**
      *  @brief Stop the execution of the decoder
      *
@@ -181,12 +215,45 @@ public:
     std::map<std::string, llvm::Function*>* getFifoFn(){return fifoFn;}
 private:
 
+    /**
+     *  @brief Create the scheduler of a list of instances
+     *
+     *  Create a data-driven scheduler if requested, otherwise a round-robin scheduler.
+     *
+     *  @param instances : the instances to schedule
+     *
+     *  @return the new Scheduler
+     */
+    Scheduler* createScheduler(std::list<Instance*>* instances);
+
+    /**
+     *  @brief Write the high-water marks of the fifos of the decoder
+     *
+     *  Each line of the profile gives the source, the destination, the
+     *  high-water mark and the size of a connection.
+     *
+     *  @param file : name of the profile file
+     */
+    void writeFifoProfile(std::string file);
+
+    /**
+     *  @brief Write the counters of the action schedulers of the decoder
+     *
+     *  @param out : the stream where counters are written
+     *
+     *  @param json : write counters as JSON instead of a table
+     */
+    void writeSchedulerCounters(std::ostream& out, bool json);
+
     /** Module containing the final decoder */
     llvm::Module* module;
 
     /** Configuration of the decoder */
     Configuration* configuration;
 
+    /** Identity of the network before the transformations of the configuration */
+    std::string identity;
+
     /** Scheduler of unpartitionned instance of the decoder */
     Scheduler* scheduler;
 
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the HotReconfiguration interface
+@author agent
+@file HotReconfiguration.h
+@version 1.0
+@date 18/10/2026
+*/
+
+//------------------------------
+#ifndef HOTRECONFIGURATION_H
+#define HOTRECONFIGURATION_H
+
+#include <atomic>
+#include <pthread.h>
+
+class Decoder;
+class Network;
+class RVCEngine;
+//------------------------------
+
+/**
+ * @brief  This class prepares the reconfiguration of a running decoder.
+ *
+ * A background thread parses the actors of the new network, writes and
+ * compiles a new decoder while the current one keeps running. Once the new
+ * decoder is ready, the current one is periodically asked to pause; it
+ * stops at the first round of its main scheduler that leaves all its fifos
+ * empty, where the new decoder takes over. When no such round is found in
+ * time, the current decoder is stopped as in a synchronous reconfiguration.
+ *
+ * @author agent
+ *
+ */
+class HotReconfiguration {
+public:
+
+    /**
+     *  @brief Constructor
+     *
+     *  @param engine : the RVCEngine that builds the new decoder
+     *
+     *  @param decoder : the running Decoder to replace
+     *
+     *  @param network : the new Network of the decoder
+     *
+     *  @param optLevel : the level of optimization of the new decoder
+     *
+     *  @param verbose : verbose actions taken
+     */
+    HotReconfiguration(RVCEngine* engine, Decoder* decoder, Network* network, int optLevel = 0, bool verbose = false);
+
+    /**
+     *  @brief Destructor
+     *
+     *  Wait for the background thread if still running
+     */
+    ~HotReconfiguration();
+
+    /**
+     *  @brief Start the background thread
+     */
+    void start();
+
+    /**
+     *  @brief Return true if the new decoder is compiled
+     *
+     *  @return true if the new decoder can replace the current one
+     */
+    bool isReady(){return ready.load(std::memory_order_acquire);}
+
+    /**
+     *  @brief Return true if the current decoder never paused and has been stopped
+     *
+     *  @return true if the new decoder replaces a stopped decoder
+     */
+    bool isExpired(){return expired.load(std::memory_order_acquire);}
+
+    /**
+     *  @brief Wait for the new decoder and stop pausing the current one
+     *
+     *  @return the new Decoder
+     */
+    Decoder* finish();
+
+    /**
+     *  @brief Get the decoder to replace
+     *
+     *  @return the current Decoder
+     */
+    Decoder* getDecoder(){return decoder;}
+
+private:
+
+    /**
+     *  @brief Static method for launching the background thread
+     *
+     */
+    static void* threadProc(void* args);
+
+    /**
+     *  @brief Build the new decoder, then pause the current one until finished
+     */
+    void prepare();
+
+    /** Engine building the new decoder */
+    RVCEngine* engine;
+
+    /** Decoder to replace */
+    Decoder* decoder;
+
+    /** New network */
+    Network* network;
+
+    /** Level of optimization of the new decoder */
+    int optLevel;
+
+    /** Decoder built from the new network */
+    Decoder* next;
+
+    /** Background thread */
+    pthread_t thread;
+
+    /** Whether or not the background thread has been started */
+    bool started;
+
+    /** Whether or not the new decoder is compiled, publishes next */
+    std::atomic<bool> ready;
+
+    /** Whether or not the new decoder has been taken */
+    std::atomic<bool> finished;
+
+    /** Whether or not the current decoder has been stopped without pausing */
+    std::atomic<bool> expired;
+
+    /** verbose */
+    bool verbose;
+};
+
+#endif
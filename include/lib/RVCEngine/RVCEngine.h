@@ -52,7 +52,9 @@ class Actor;
 class IRParser;
 class Package;
 class Configuration;
+class HotReconfiguration;
 
+#include <list>
 #include <map>
 #include <string>
 #include <pthread.h>
@@ -91,6 +93,18 @@ public:
      */
     int load(Network* network);
 
+    /*!
+     *  @brief Build the decoder of a network
+     *
+     *  Parse the actors of the network and create its decoder, without
+     *  loading it in the engine.
+     *
+     *  @param network : the Network to build
+     *
+     *  @return the new Decoder
+     */
+    Decoder* build(Network* network);
+
     /*!
      *  @brief Unload the given network
      *
@@ -110,11 +124,14 @@ public:
     /*!
      *  @brief Run the given network
      *
+     *  Decoders of different networks have their own native state, each one
+     *  can be run on its own thread.
+     *
      *  @param network : the Network to run
      *
-     *  @param thread : the thread where network is execute
+     *  @param input : the input file of the decoder, the global input file if empty
      */
-    int run(Network* network);
+    int run(Network* network, std::string input = "");
 
     /*!
      *  @brief Reconfigure a network into another network
@@ -123,8 +140,10 @@ public:
      *
      *  @param newNetwork : the new network
      *
+     *  @param optLevel : the level of optimization of a decoder built for the new network
+     *
      */
-    int reconfigure(Network* oldNetwork, Network* newNetwork);
+    int reconfigure(Network* oldNetwork, Network* newNetwork, int optLevel = 0);
 
     /*!
      *  @brief Print the given network into a file
@@ -165,6 +184,8 @@ public:
     /*!
      *  @brief Parse and returns actors requiered by the configuration
      *
+     *  Actors are parsed in the LLVM context of the network of the configuration.
+     *
      *  @param configuration : the Configuration thats contains actors indication
      *
      *  @return a map of actors requiered by the configuration
@@ -182,12 +203,60 @@ private:
      */
     void doOptimizeDecoder(Decoder* decoder);
 
-    IRParser* irParser;
+    /*!
+     *  @brief Replace the decoder of a network by the one prepared in background
+     *
+     *  @param network : the Network of the decoder
+     *
+     *  @return the new Decoder of the network
+     */
+    Decoder* switchDecoder(Network* network);
 
-    /** Map of actors loaded */
-    std::map<std::string, Actor*> actors;
+    /*!
+     *  @brief Get the identity of a network
+     *
+     *  Networks with the same identity are decoded by the same decoder.
+     *
+     *  @param network : the Network to identify
+     *
+     *  @return a string made of the instances and connections of the network, as parsed
+     */
+    std::string getIdentity(Network* network);
 
-    /** LLVM Context */
+    /*!
+     *  @brief Stop a decoder and keep it in the pool of compiled decoders
+     *
+     *  Least recently used decoders are deleted to stay within the memory budget.
+     *
+     *  @param decoder : the Decoder to keep
+     */
+    void keepDecoder(Decoder* decoder);
+
+    /*!
+     *  @brief Take the decoder compiled for a network out of the pool
+     *
+     *  @param network : the Network to decode
+     *
+     *  @return the Decoder of the network, or NULL if not in the pool
+     */
+    Decoder* takeDecoder(Network* network);
+
+    /*!
+     *  @brief Return the LLVM context to build the decoder of a network in
+     *
+     *  @param network : the Network to decode
+     *
+     *  @return the context of the network, or the context of the engine
+     */
+    llvm::LLVMContext& getContext(Network* network);
+
+    /** Parsers of actors, by LLVM context */
+    std::map<llvm::LLVMContext*, IRParser*> irParsers;
+
+    /** Map of actors loaded, by LLVM context */
+    std::map<llvm::LLVMContext*, std::map<std::string, Actor*> > actors;
+
+    /** LLVM Context of the networks parsed without context */
     llvm::LLVMContext &Context;
 
     /** Library location */
@@ -196,6 +265,24 @@ private:
     /** Map of decoder loaded in the decoder engine */
     std::map<Network*, Decoder*> decoders;
 
+    /** Reconfigurations prepared in background for the loaded decoders */
+    std::map<Decoder*, HotReconfiguration*> reconfigurations;
+
+    /** Compiled decoders not in use, by identity of their network */
+    std::map<std::string, Decoder*> pool;
+
+    /** Identities of the pooled decoders, most recently used first */
+    std::list<std::string> poolOrder;
+
+    /** Memory taken by the pooled decoders */
+    size_t poolMemory;
+
+    /** Protect the maps of parsers, actors and locks of the contexts */
+    pthread_mutex_t parseLock;
+
+    /** Protect the parser and the actors loaded of each context */
+    std::map<llvm::LLVMContext*, pthread_mutex_t*> contextLocks;
+
     /** Writing directory */
     std::string outputDir;
 
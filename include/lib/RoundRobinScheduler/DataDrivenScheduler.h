@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the DataDrivenScheduler class interface
+@author agent
+@file DataDrivenScheduler.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef DATADRIVENSCHEDULER_H
+#define DATADRIVENSCHEDULER_H
+
+#include <list>
+#include <map>
+#include <vector>
+
+namespace llvm{
+class BasicBlock;
+class CallInst;
+class Function;
+class GlobalVariable;
+class Instruction;
+class LLVMContext;
+class Type;
+}
+
+class Decoder;
+class Instance;
+class LLVMExecution;
+
+#include "lib/Scheduler/Scheduler.h"
+//------------------------------
+
+/**
+ * @brief  This class defines a data-driven scheduler of a decoder.
+ *
+ * Instead of calling every action scheduler on each pass, the generated main
+ * function keeps a worklist of instances. An instance is only called when one
+ * of its neighbours has fired since its last call, i.e. when new tokens may be
+ * available on its inputs or new rooms on its outputs. When the worklist is
+ * empty, every instance is pushed again, which is equivalent to one
+ * round-robin pass.
+ *
+ * @author agent
+ *
+ */
+class DataDrivenScheduler : public Scheduler {
+public:
+    /**
+     *  @brief Constructor
+     *
+     *  Create a new data-driven scheduler for the given decoder
+     *
+     *  @param C : the LLVM Context
+     *
+     *  @param decoder : the Decoder to insert the scheduler into
+     *
+     *  @param instances : the Instance managed by this scheduler
+     *
+     *  @param optimized : whether or not use optimized action schedulers
+     *
+     *  @param verbose : print actions taken
+     */
+    DataDrivenScheduler(llvm::LLVMContext& C, Decoder* decoder, std::list<Instance*>* instances, bool optimized = true, bool verbose = false);
+    ~DataDrivenScheduler();
+
+    /**
+     *  @brief Return the main function of the scheduler
+     *
+     *  @return the main llvm::Function of scheduler
+     */
+    llvm::Function* getMainFunction(){return scheduler;}
+
+    /**
+     *  @brief Return the initialize function of the scheduler
+     *
+     *  @return the initialize llvm::Function of scheduler
+     */
+    llvm::Function* getInitFunction(){return initialize;}
+
+    /**
+     *  @brief Return the stop GV
+     *
+     *  @return the stop GV
+     */
+    llvm::GlobalVariable* getStopGV(){return stopGV;}
+
+    /**
+     *  @brief Add an instance in the scheduler
+     *
+     *  The main function is regenerated and must be recompiled.
+     *
+     *  @param instance : the Instance to add
+     */
+    void addInstance(Instance* instance);
+
+    /**
+     *  @brief Remove an instance in the scheduler
+     *
+     *  The main function is regenerated and must be recompiled.
+     *
+     *  @param instance : the Instance to remove
+     */
+    void removeInstance(Instance* instance);
+
+    /**
+     *  @brief Print the scheduling statistics of the last execution
+     *
+     *  Print the number of calls made to the action schedulers and the
+     *   number of calls that a round-robin scheduler would have made.
+     *
+     *  @param executionEngine : the LLVMExecution that runs the decoder
+     */
+    void printStatistics(LLVMExecution* executionEngine);
+
+private:
+    /**
+     *  @brief Create the network initializer
+     */
+    void createNetworkInitialize();
+
+    /**
+     *  @brief Create the action scheduler of an instance and call its initializer
+     *
+     *  @param instance : the Instance to schedule
+     */
+    void createActionScheduler(Instance* instance);
+
+    /**
+     *  @brief Create the network scheduler
+     *
+     *  (Re)create the body of the main function from the current list of instances.
+     */
+    void createNetworkScheduler();
+
+    /**
+     *  @brief Create the function that pushes an instance index in the worklist
+     *
+     *  @param size : the size of the worklist
+     */
+    void createPushFunction(int size);
+
+    /**
+     *  @brief Create calls that push all instances in the worklist
+     *
+     *  @param BB : llvm::BasicBlock where calls are added
+     */
+    void createPushAll(llvm::BasicBlock* BB);
+
+    /**
+     *  @brief Create the call of an instance and the notification of its neighbours
+     *
+     *  @param instance : the Instance to call
+     *
+     *  @param BB : llvm::BasicBlock where the call is added
+     *
+     *  @param loopBB : llvm::BasicBlock to branch after the call
+     *
+     *  @param idleBB : llvm::BasicBlock to branch when the instance did not fire
+     */
+    void createCall(Instance* instance, llvm::BasicBlock* BB, llvm::BasicBlock* loopBB, llvm::BasicBlock* idleBB);
+
+    /**
+     *  @brief Return the instances of this scheduler connected to the given instance
+     *
+     *  @param instance : the Instance to get neighbours from
+     *
+     *  @return the list of neighbour indexes
+     */
+    std::list<int> getNeighbours(Instance* instance);
+
+    /**
+     *  @brief Create an internal global variable of the scheduler
+     */
+    llvm::GlobalVariable* createGV(llvm::Type* type, std::string name);
+
+    /**
+     *  @brief Increment an i64 counter
+     */
+    void createIncrement(llvm::GlobalVariable* counter, llvm::BasicBlock* BB);
+
+    /**
+     *  @brief Remove the generated worklist elements
+     */
+    void clearWorklist();
+
+    /** Decoder bound to the scheduler */
+    Decoder* decoder;
+
+    /** Instances managed by the scheduler */
+    std::vector<Instance*> instances;
+
+    /** Index of the instances in the worklist */
+    std::map<Instance*, int> indexes;
+
+    /** Main scheduling function */
+    llvm::Function* scheduler;
+
+    /** Initialize function */
+    llvm::Function* initialize;
+
+    /** Insertion point of the initialize function */
+    llvm::Instruction* initInst;
+
+    /** Function that pushes an instance into the worklist */
+    llvm::Function* pushFn;
+
+    /** Worklist of instance indexes */
+    llvm::GlobalVariable* listGV;
+
+    /** Whether or not an instance is in the worklist */
+    llvm::GlobalVariable* inListGV;
+
+    /** Tail of the worklist */
+    llvm::GlobalVariable* tailGV;
+
+    /** Initialize calls of the instances */
+    std::map<llvm::Function*, llvm::CallInst*> initCalls;
+
+    /** Worklist elements */
+    std::list<llvm::GlobalVariable*> worklistGVs;
+
+    /** Stop scheduler GV */
+    llvm::GlobalVariable* stopGV;
+
+    /** Number of calls of the action schedulers */
+    llvm::GlobalVariable* callsGV;
+
+    /** Number of calls that did not fire any action */
+    llvm::GlobalVariable* idleCallsGV;
+
+    /** Number of worklist generations, each one equivalent to a round-robin pass */
+    llvm::GlobalVariable* roundsGV;
+
+    /** LLVM Context */
+    llvm::LLVMContext &Context;
+
+    /** Print all actions made by LLVM execution engine*/
+    bool verbose;
+
+    /** Optimized schedulers*/
+    bool optimized;
+};
+
+#endif
@@ -44,7 +44,11 @@ namespace llvm{
 class BasicBlock;
 class Constant;
 class ConstantInt;
+class DataLayout;
 class IntegerType;
+class Instruction;
+class LoadInst;
+class StoreInst;
 class GlobalVariable;
 class GetElementPtrInst;
 class Function;
@@ -70,14 +74,29 @@ class Port;
 
 class Fifo {
 public:
-    Fifo(llvm::LLVMContext& C, llvm::Module* module, llvm::Type* type, int size);
+    /**
+     * @brief Creates a new fifo
+     *
+     * @param C : the llvm::LLVMContext
+     *
+     * @param module : the llvm::Module where the fifo is created
+     *
+     * @param type : type of the tokens
+     *
+     * @param size : number of tokens of the fifo
+     *
+     * @param readers : number of readers of the fifo, each one with its own read index
+     *
+     * @param concurrent : whether or not the writer and the readers run on different threads
+     */
+    Fifo(llvm::LLVMContext& C, llvm::Module* module, llvm::Type* type, int size, int readers = 1, bool concurrent = false);
 
     ~Fifo();
 
 public:
-    static llvm::StructType* getOrInsertFifoStruct(llvm::Module* module, llvm::IntegerType* connectionType);
-    static llvm::Function* getOrInsertRoomFn(llvm::Module* module, llvm::IntegerType* connectionType);
-    static llvm::Function* getOrInsertNumTokensFn(llvm::Module* module, llvm::IntegerType* connectionType);
+    static llvm::StructType* getOrInsertFifoStruct(llvm::Module* module, llvm::IntegerType* connectionType, bool concurrent = false);
+    static llvm::Function* getOrInsertRoomFn(llvm::Module* module, llvm::IntegerType* connectionType, bool concurrent = false);
+    static llvm::Function* getOrInsertNumTokensFn(llvm::Module* module, llvm::IntegerType* connectionType, bool concurrent = false);
     static llvm::Function* initializeIn(llvm::Module* module, Port* port);
     static llvm::Function* initializeOut(llvm::Module* module, Port* port);
 
@@ -85,6 +104,33 @@ public:
     static llvm::Function* closeOut(llvm::Module* module, Port* port);
     llvm::GlobalVariable* getGV(){return fifoGV;}
 
+    /**
+     * @brief Release the fifo for one of its readers
+     *
+     * @return the number of readers still bound to the fifo
+     */
+    int release(){return --references;}
+
+    /**
+     * @brief Whether or not all the tokens of the fifo have been read
+     *
+     * @param compiled : address of the fifo structure in the compiled decoder
+     *
+     * @param layout : the llvm::DataLayout the fifo structure is compiled with
+     *
+     * @return true if every reader has reached the write index
+     */
+    bool isEmpty(void* compiled, const llvm::DataLayout* layout);
+
+    /**
+     * @brief Distance between two read indexes in read_inds
+     *
+     * @param concurrent : whether or not the fifo is shared between threads
+     *
+     * @return the stride of the read indexes
+     */
+    static int getReadIndStride(bool concurrent);
+
     /**
      * @brief Creates read/write/peek accesses
      *
@@ -157,8 +203,58 @@ private:
      * @param port : the port to get the variable from
      *
      * @parm procedure : the procedure to get var from
+     *
+     * @param numTokens : number of tokens of the pattern
+     *
+     * @param write : whether or not the pattern writes tokens
      */
-    static llvm::Value* replaceAccess (Port* port, Procedure* proc);
+    static llvm::Value* replaceAccess (Port* port, Procedure* proc, llvm::ConstantInt* numTokens, bool write);
+
+    /**
+     * @brief Give a contiguous access to the tokens of a pattern
+     *
+     * Tokens are accessed in place when they do not cross the end of the ring,
+     * otherwise they are copied in two spans from or to a local buffer.
+     *
+     * @param port : the port accessed
+     *
+     * @param numTokens : number of tokens of the pattern
+     *
+     * @param indexVal : index of the first token
+     *
+     * @param contents : pointer to the contents of the fifo
+     *
+     * @param pos : instruction before which tokens must be available
+     *
+     * @param write : whether or not tokens are written back at the end of the procedure
+     *
+     * @return a pointer to the first token
+     */
+    static llvm::Value* createBulkAccess(Port* port, llvm::ConstantInt* numTokens, llvm::Value* indexVal, llvm::Value* contents, llvm::Instruction* pos, bool write);
+
+    /**
+     * @brief Load the read or write index of a fifo
+     *
+     * @param ptr : pointer to the index
+     *
+     * @param concurrent : whether or not the index is written by another thread
+     *
+     * @param BB : llvm::BasicBlock where the load is added
+     */
+    static llvm::LoadInst* createIndexLoad(llvm::Value* ptr, bool concurrent, llvm::BasicBlock* BB);
+
+    /**
+     * @brief Store the read or write index of a fifo
+     *
+     * @param value : the new index
+     *
+     * @param ptr : pointer to the index
+     *
+     * @param concurrent : whether or not the index is read by another thread
+     *
+     * @param BB : llvm::BasicBlock where the store is added
+     */
+    static llvm::StoreInst* createIndexStore(llvm::Value* value, llvm::Value* ptr, bool concurrent, llvm::BasicBlock* BB);
 
 
     /**
@@ -177,6 +273,12 @@ private:
     llvm::GlobalVariable* gv_array;
     llvm::GlobalVariable* gv_read_inds;
 
+    // Readers still bound to the fifo
+    int references;
+
+    // Whether or not the writer and the readers run on different threads
+    bool concurrent;
+
     // Display debugging information
     static bool debug;
 };
@@ -46,6 +46,7 @@ class LLVMContext;
 }
 
 class Decoder;
+class StaticRegion;
 
 #include "lib/Scheduler/Scheduler.h"
 #include "lib/IRJit/LLVMExecution.h"
@@ -129,6 +130,18 @@ private:
      */
     void createCall(Instance* instance);
 
+    /**
+     *  @brief Replace the calls of the instances of static regions by a call to their region
+     */
+    void createRegions();
+
+    /**
+     *  @brief Remove a static region and call its instances one by one
+     *
+     *  @param region : the StaticRegion to remove
+     */
+    void removeRegion(StaticRegion* region);
+
     /**
      *  @brief Remove a call
      *
@@ -155,6 +168,12 @@ private:
     /** Function calls */
     std::map<llvm::Function*, llvm::CallInst*> functionCall;
 
+    /** Calls of the static regions */
+    std::map<StaticRegion*, llvm::CallInst*> regions;
+
+    /** Static region of the instances */
+    std::map<Instance*, StaticRegion*> instanceRegions;
+
     /** Stop scheduler GV */
     llvm::GlobalVariable* stopGV;
 
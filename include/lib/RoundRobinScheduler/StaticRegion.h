@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the StaticRegion class interface
+@author agent
+@file StaticRegion.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef STATICREGION_H
+#define STATICREGION_H
+
+#include <list>
+#include <map>
+#include <string>
+
+class Connection;
+class Instance;
+class Port;
+//------------------------------
+
+/**
+ * @brief  This class defines a static region of a network.
+ *
+ * A static region is a connected set of CSDF instances with consistent
+ * rates. The region is fired as a whole: each iteration fires every
+ * instance as many times as given by the repetition vector of the region,
+ * following a precomputed order, so that tokens exchanged inside the
+ * region never have to be tested.
+ *
+ * @author agent
+ *
+ */
+class StaticRegion {
+public:
+    /**
+     *  @brief Create an empty static region.
+     *
+     * @param id : identifier of the region
+     */
+    StaticRegion(std::string id);
+
+    ~StaticRegion(){}
+
+    /**
+     *  @brief Find the static regions of a list of instances.
+     *
+     *  Regions are maximal connected sets of CSDF instances of the list with
+     *  consistent rates. Regions of a single instance, regions with cycles and
+     *  regions that are connected to themselves through an instance outside
+     *  of the region are discarded.
+     *
+     * @param instances : the instances to analyze
+     *
+     * @return the list of static regions found
+     */
+    static std::list<StaticRegion*> findRegions(std::list<Instance*>* instances);
+
+    /**
+     *  @brief Get the identifier of the region
+     *
+     * @return identifier of the region
+     */
+    std::string getId(){return id;}
+
+    /**
+     *  @brief Get the instances of the region in firing order
+     *
+     * @return the list of instances of the region
+     */
+    std::list<Instance*>* getInstances(){return &instances;}
+
+    /**
+     *  @brief Get the number of firings of an instance per iteration of the region
+     *
+     * @param instance : an Instance of the region
+     *
+     * @return the repetition of the instance, 0 if the instance is not in the region
+     */
+    int getRepetition(Instance* instance);
+
+    /**
+     *  @brief Return true if the instance is in the region
+     *
+     * @param instance : the Instance to look for
+     *
+     * @return true if the instance is in the region, otherwise false
+     */
+    bool contains(Instance* instance){return repetitions.find(instance) != repetitions.end();}
+
+    /**
+     *  @brief Return true if both sides of a connection are in the region
+     *
+     * @param connection : the Connection to test
+     *
+     * @return true if the connection is internal, otherwise false
+     */
+    bool isInternal(Connection* connection);
+
+    /**
+     *  @brief Get the number of tokens of a port per iteration of the region
+     *
+     * @param port : a Port of an instance of the region
+     *
+     * @return the number of tokens read or written on the port
+     */
+    int getTokens(Port* port);
+
+    /**
+     *  @brief Return true if fifos of internal connections can hold the tokens
+     *   of one iteration of the region and the tokens of the initialize actions
+     *
+     * @return true if the region can be fired as a whole, otherwise false
+     */
+    bool fitsFifos();
+
+    /**
+     *  @brief Get the number of tokens written on a port by the initialize actions
+     *
+     * @param port : an output Port of an instance
+     *
+     * @return the number of initial tokens of the port
+     */
+    static int getInitialTokens(Port* port);
+
+private:
+    /**
+     *  @brief Compute the repetition vector of the region
+     *
+     *  Rates are propagated from the instance given in parameter to all the CSDF
+     *  instances of the list connected to it.
+     *
+     * @param start : the first Instance of the region
+     *
+     * @param candidates : the instances that may be in the region
+     *
+     * @return true if rates of the region are consistent, otherwise false
+     */
+    bool computeRepetitions(Instance* start, std::list<Instance*>* candidates);
+
+    /**
+     *  @brief Sort the instances of the region in firing order
+     *
+     * @return false if the region has a cycle, otherwise true
+     */
+    bool computeOrder();
+
+    /**
+     *  @brief Verify that no path leaves the region and comes back to it
+     *
+     * @return true if the region is convex, otherwise false
+     */
+    bool isConvex();
+
+    /** Identifier of the region */
+    std::string id;
+
+    /** Instances in firing order */
+    std::list<Instance*> instances;
+
+    /** Repetition vector of the region */
+    std::map<Instance*, int> repetitions;
+};
+
+#endif
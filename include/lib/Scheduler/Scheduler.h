@@ -44,6 +44,8 @@ class Function;
 class GlobalVariable;
 }
 
+class LLVMExecution;
+
 #include <string>
 //------------------------------
 
@@ -70,6 +72,7 @@ public:
     virtual llvm::GlobalVariable* getStopGV(){return NULL;}
     virtual void addInstance(Instance* instance){}
     virtual void removeInstance(Instance* instance){}
+    virtual void printStatistics(LLVMExecution* executionEngine){}
 };
 
 #endif
@@ -142,6 +142,17 @@ private:
      */
     TiXmlElement* writeEntry(std::string name, Expr* expr);
 
+    /**
+     *  @brief Returns an Entry parent that represents the given integer entry.
+     *
+     *  @param name : the entry name
+     *
+     *  @param value : the entry value
+     *
+     *  @return an entry xml element parent
+     */
+    TiXmlElement* writeEntry(std::string name, int value);
+
 
     /** Path of the xdf output file */
     std::string filename;
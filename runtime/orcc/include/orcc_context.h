@@ -0,0 +1,104 @@
+
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ORCC_CONTEXT_H
+#define ORCC_CONTEXT_H
+
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * Native state of a decoder. Each decoder of a process has its own context,
+ * bound to the threads that execute it. Natives called outside of any
+ * decoder use a default context.
+ */
+typedef struct orcc_context_s {
+    // input file of the source, the global input_file if NULL
+    char *input_file;
+
+    // stop variable of the main scheduler, the global stopVar if NULL
+    int *stop;
+
+    // set once the natives asked the main scheduler to stop
+    volatile int stop_requested;
+
+    // source
+    FILE *file;
+    int nb;
+    int stopped;
+    int genetic;
+    clock_t startTime;
+    unsigned int nbByteRead;
+    unsigned int loopsCount;
+
+    // display, owned by the display backend
+    void *display;
+    void (*display_close)(void *display);
+
+    // fpsPrint
+    unsigned int fpsStartTime;
+    unsigned int fpsRelativeStartTime;
+    int lastNumPic;
+    int numPicturesDecoded;
+} orcc_context;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// create an empty context
+orcc_context *orcc_context_create();
+
+// release the files and the display of a context
+void orcc_context_destroy(orcc_context *context);
+
+// bind a context to the current thread
+void orcc_context_bind(orcc_context *context);
+
+// context bound to the current thread, or the default context
+orcc_context *orcc_context_current();
+
+// set the input file of the source
+void orcc_context_set_input(orcc_context *context, char *input_file);
+
+// set the stop variable of the main scheduler and clear the stop request
+void orcc_context_set_stop(orcc_context *context, int *stop);
+
+// ask the main scheduler to stop
+void orcc_context_stop(orcc_context *context);
+
+// return non-zero if the natives asked the main scheduler to stop
+int orcc_context_is_stopped(orcc_context *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,106 @@
+
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "orcc_context.h"
+
+#ifdef _MSC_VER
+#include <windows.h>
+#define ORCC_THREAD_LOCAL __declspec(thread)
+#define ORCC_MEMORY_BARRIER() MemoryBarrier()
+#else
+#define ORCC_THREAD_LOCAL __thread
+#define ORCC_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+// stop variable of the scheduler of native decoders
+int* stopVar;
+
+static orcc_context default_context;
+
+static ORCC_THREAD_LOCAL orcc_context *current_context = NULL;
+
+orcc_context *orcc_context_create() {
+    orcc_context *context = (orcc_context *) malloc(sizeof(orcc_context));
+    memset(context, 0, sizeof(orcc_context));
+    return context;
+}
+
+void orcc_context_destroy(orcc_context *context) {
+    if (context->display_close != NULL) {
+        context->display_close(context->display);
+    }
+
+    if (context->file != NULL) {
+        fclose(context->file);
+    }
+
+    if (current_context == context) {
+        current_context = NULL;
+    }
+
+    free(context);
+}
+
+void orcc_context_bind(orcc_context *context) {
+    current_context = context;
+}
+
+orcc_context *orcc_context_current() {
+    return current_context != NULL ? current_context : &default_context;
+}
+
+void orcc_context_set_input(orcc_context *context, char *input_file) {
+    context->input_file = input_file;
+}
+
+void orcc_context_set_stop(orcc_context *context, int *stop) {
+    context->stop = stop;
+    context->stop_requested = 0;
+}
+
+void orcc_context_stop(orcc_context *context) {
+    int *stop = context->stop != NULL ? context->stop : stopVar;
+
+    // the request is seen by whoever clears the stop variable afterwards
+    context->stop_requested = 1;
+    ORCC_MEMORY_BARRIER();
+
+    if (stop != NULL) {
+        *stop = 1;
+    }
+}
+
+int orcc_context_is_stopped(orcc_context *context) {
+    ORCC_MEMORY_BARRIER();
+    return context->stop_requested;
+}
@@ -29,17 +29,49 @@
 
 #include <SDL.h>
  
+#include "orcc_context.h"
 #include "orcc_util.h"
 
-static SDL_Surface *m_screen;
-static SDL_Surface *m_image;
-static SDL_Overlay *m_overlay;
+// Display of a decoder
+struct display_s {
+    SDL_Surface *m_screen;
+    SDL_Surface *m_image;
+    SDL_Overlay *m_overlay;
+
+    int x, y, onclick;
+    SDL_Rect rect;
+
+    unsigned int lastWidth;
+    unsigned int lastHeight;
+};
 
 static int init = 0;
 
-static int x, y , onclick = 0;
-static SDL_Rect rect;
 
+static void display_close(void *display) {
+    struct display_s *d = (struct display_s *) display;
+
+    if (d->m_overlay != NULL) {
+        SDL_FreeYUVOverlay(d->m_overlay);
+    }
+
+    if (d->m_image != NULL) {
+        SDL_FreeSurface(d->m_image);
+    }
+
+    free(d);
+}
+
+static struct display_s *get_display() {
+    orcc_context *context = orcc_context_current();
+
+    if (context->display == NULL) {
+        context->display = calloc(1, sizeof(struct display_s));
+        context->display_close = display_close;
+    }
+
+    return (struct display_s *) context->display;
+}
 
 static void press_a_key(int code) {
     char buf[2];
@@ -60,21 +92,22 @@ char displayYUV_getFlags(){
 
 
 static void displayYUV_setSize(int width, int height) {
+    struct display_s *d = get_display();
     printf("set display to %ix%i\n", width, height);
 
-    m_screen = SDL_SetVideoMode(width, height, 32, SDL_HWSURFACE);
-    if (m_screen == NULL) {
+    d->m_screen = SDL_SetVideoMode(width, height, 32, SDL_HWSURFACE);
+    if (d->m_screen == NULL) {
         fprintf(stderr, "Couldn't set %ix%ix24 video mode: %s\n", width,
                 height, SDL_GetError());
         press_a_key(-1);
     }
 
-    if (m_overlay != NULL) {
-        SDL_FreeYUVOverlay(m_overlay);
+    if (d->m_overlay != NULL) {
+        SDL_FreeYUVOverlay(d->m_overlay);
     }
 
-    m_overlay = SDL_CreateYUVOverlay(width, height, SDL_YV12_OVERLAY, m_screen);
-    if (m_overlay == NULL) {
+    d->m_overlay = SDL_CreateYUVOverlay(width, height, SDL_YV12_OVERLAY, d->m_screen);
+    if (d->m_overlay == NULL) {
         fprintf(stderr, "Couldn't create overlay: %s\n", SDL_GetError());
         press_a_key(-1);
     }
@@ -83,32 +116,31 @@ static void displayYUV_setSize(int width, int height) {
 void displayYUV_displayPicture(unsigned char *pictureBufferY,
         unsigned char *pictureBufferU, unsigned char *pictureBufferV,
         unsigned int   pictureWidth, unsigned int pictureHeight) {
-    static unsigned int lastWidth = 0;
-    static unsigned int lastHeight = 0;
+    struct display_s *d = get_display();
     SDL_Event event;
     //SDL_Rect rect = { 0, 0, pictureWidth, pictureHeight };
-    rect.x = 0;
-    rect.y = 0;
-    rect.w = pictureWidth;
-    rect.h = pictureHeight;
+    d->rect.x = 0;
+    d->rect.y = 0;
+    d->rect.w = pictureWidth;
+    d->rect.h = pictureHeight;
 
-    if ((pictureHeight != lastHeight) || (pictureWidth != lastWidth)) {
+    if ((pictureHeight != d->lastHeight) || (pictureWidth != d->lastWidth)) {
         displayYUV_setSize(pictureWidth, pictureHeight);
-        lastHeight = pictureHeight;
-        lastWidth = pictureWidth;
+        d->lastHeight = pictureHeight;
+        d->lastWidth = pictureWidth;
     }
 
-    if (SDL_LockYUVOverlay(m_overlay) < 0) {
+    if (SDL_LockYUVOverlay(d->m_overlay) < 0) {
         fprintf(stderr, "Can't lock screen: %s\n", SDL_GetError());
         press_a_key(-1);
     }
 
-    memcpy(m_overlay->pixels[0], pictureBufferY, pictureWidth * pictureHeight);
-    memcpy(m_overlay->pixels[1], pictureBufferV, pictureWidth * pictureHeight / 4);
-    memcpy(m_overlay->pixels[2], pictureBufferU, pictureWidth * pictureHeight / 4);
+    memcpy(d->m_overlay->pixels[0], pictureBufferY, pictureWidth * pictureHeight);
+    memcpy(d->m_overlay->pixels[1], pictureBufferV, pictureWidth * pictureHeight / 4);
+    memcpy(d->m_overlay->pixels[2], pictureBufferU, pictureWidth * pictureHeight / 4);
 
-    SDL_UnlockYUVOverlay(m_overlay);
-    SDL_DisplayYUVOverlay(m_overlay, &rect);
+    SDL_UnlockYUVOverlay(d->m_overlay);
+    SDL_DisplayYUVOverlay(d->m_overlay, &d->rect);
 
     /* Grab all the events off the queue. */
     while (SDL_PollEvent(&event)) {
@@ -140,22 +172,23 @@ void displayYUV_init() {
  * displayYUV444_setSize
  ******************************************************************************/
 static void displayYUV444_setSize(int winWidth, int winHeight, int pictureWidth, int pictureHeight) {
+    struct display_s *d = get_display();
     printf("set display to %ix%i\n", winWidth, winHeight);
 
-    m_screen = SDL_SetVideoMode(winWidth, winHeight, 24, SDL_ANYFORMAT);
-    if (m_screen == NULL) {
+    d->m_screen = SDL_SetVideoMode(winWidth, winHeight, 24, SDL_ANYFORMAT);
+    if (d->m_screen == NULL) {
         fprintf(stderr, "Couldn't set %ix%ix24 video mode: %s\n", winWidth,
                 winHeight, SDL_GetError());
         press_a_key(-1);
     }
-    if (m_image != NULL) {
-        SDL_FreeSurface(m_image);
+    if (d->m_image != NULL) {
+        SDL_FreeSurface(d->m_image);
     }
 
-    m_image = SDL_CreateRGBSurface(SDL_SWSURFACE,  pictureWidth, pictureHeight, m_screen->format->BitsPerPixel,
-                     m_screen->format->Rmask, m_screen->format->Gmask, m_screen->format->Bmask, m_screen->format->Amask);
+    d->m_image = SDL_CreateRGBSurface(SDL_SWSURFACE,  pictureWidth, pictureHeight, d->m_screen->format->BitsPerPixel,
+                     d->m_screen->format->Rmask, d->m_screen->format->Gmask, d->m_screen->format->Bmask, d->m_screen->format->Amask);
 
-    if (m_image == NULL) {
+    if (d->m_image == NULL) {
         fprintf(stderr, "Couldn't create overlay: %s\n", SDL_GetError());
         press_a_key(-1);
     }
@@ -164,8 +197,9 @@ static void displayYUV444_setSize(int winWidth, int winHeight, int pictureWidth,
  * displayYUV444_init
  ******************************************************************************/
 void displayYUV444_init(int winWidth, int winHeight, int pictureWidth, int pictureHeight) {
+    struct display_s *d = get_display();
+
     if (!init) {
-        m_overlay = NULL;
         init = 1;
         // First, initialize SDL's video subsystem.
         if (SDL_Init(SDL_INIT_VIDEO) < 0) {
@@ -174,10 +208,14 @@ void displayYUV444_init(int winWidth, int winHeight, int pictureWidth, int pictu
         }
         SDL_WM_SetCaption("display", NULL);
         atexit(SDL_Quit);
+    }
+
+    if (d->m_screen == NULL) {
+        d->m_overlay = NULL;
         displayYUV444_setSize(winWidth, winHeight, pictureWidth, pictureHeight);
-        x = 0;
-        y = 0;
-        onclick = 0;
+        d->x = 0;
+        d->y = 0;
+        d->onclick = 0;
     }
 }
 /*******************************************************************************
@@ -197,7 +235,11 @@ void  convertYUV444_to_RGB(unsigned char *pictureBufferY,
     unsigned int h, w;
     int red, green, blue;
     int pixel, idx_pixel;
-    SDL_PixelFormat *format = m_image->format;
+    SDL_PixelFormat *format = get_display()->m_image->format;
+    char *pixels = (char *) get_display()->m_image->pixels;
+    int bytesPerPixel = format->BytesPerPixel;
+    Uint8 rshift = format->Rshift, gshift = format->Gshift, bshift = format->Bshift;
+    Uint32 rmask = format->Rmask, gmask = format->Gmask, bmask = format->Bmask;
 
     for (h = 0; h < pictureHeight; h++) {
         for (w = 0; w < pictureWidth; w++) {    //start from lower-left corner
@@ -205,10 +247,10 @@ void  convertYUV444_to_RGB(unsigned char *pictureBufferY,
             red       = (256 * pictureBufferY[idx_pixel]                                           + 359 * (pictureBufferV[idx_pixel] - 128)) >> 8;
             green     = (256 * pictureBufferY[idx_pixel] -  87 * (pictureBufferU[idx_pixel] - 128) - 182 * (pictureBufferV[idx_pixel] - 128)) >> 8;
             blue      = (256 * pictureBufferY[idx_pixel] + 452 * (pictureBufferU[idx_pixel] - 128)                                          ) >> 8;
-            pixel     = ((clip255(red)   << format->Rshift) & format->Rmask) |
-                        ((clip255(green) << format->Gshift) & format->Gmask) |
-                        ((clip255(blue)  << format->Bshift) & format->Bmask) ;
-            * (int *) &((char *)m_image->pixels)[idx_pixel * format->BytesPerPixel] = pixel;
+            pixel     = ((clip255(red)   << rshift) & rmask) |
+                        ((clip255(green) << gshift) & gmask) |
+                        ((clip255(blue)  << bshift) & bmask) ;
+            * (int *) &pixels[idx_pixel * bytesPerPixel] = pixel;
         }
     }
 }
@@ -218,43 +260,45 @@ void  convertYUV444_to_RGB(unsigned char *pictureBufferY,
 void displayYUV444_displayPicture(unsigned char *pictureBufferY,
                   unsigned char *pictureBufferU, unsigned char *pictureBufferV,
                   unsigned int   pictureWidth, unsigned int pictureHeight) {
-    rect.x = x;
-    rect.y = y;
-    rect.w = pictureWidth;
-    rect.h = pictureHeight;
+    struct display_s *d = get_display();
+    d->rect.x = d->x;
+    d->rect.y = d->y;
+    d->rect.w = pictureWidth;
+    d->rect.h = pictureHeight;
 
     convertYUV444_to_RGB(pictureBufferY, pictureBufferU, pictureBufferV, pictureWidth, pictureHeight);
 
-    SDL_BlitSurface(m_image, NULL, m_screen, &rect);
-    SDL_UpdateRects(m_screen, 1, &rect);
+    SDL_BlitSurface(d->m_image, NULL, d->m_screen, &d->rect);
+    SDL_UpdateRects(d->m_screen, 1, &d->rect);
 }
 /*******************************************************************************
  * displayYUV_getEvent
  ******************************************************************************/
 void displayYUV_getEvent() {
+    struct display_s *d = get_display();
     SDL_Event event;
     /* Grab all the events off the queue. */
     while (SDL_PollEvent(&event)) {
         switch (event.type) {
         case SDL_QUIT:
-            SDL_FreeSurface(m_screen);
+            SDL_FreeSurface(d->m_screen);
             SDL_Quit();
             exit(0);
             break;
-        case SDL_MOUSEBUTTONDOWN : onclick = 1; break;
-        case SDL_MOUSEBUTTONUP   : onclick = 0; break;
+        case SDL_MOUSEBUTTONDOWN : d->onclick = 1; break;
+        case SDL_MOUSEBUTTONUP   : d->onclick = 0; break;
         case SDL_MOUSEMOTION     :
-            if (onclick == 1) {
-                x += event.motion.xrel;
-                y += event.motion.yrel;
-                rect.x = x ; rect.y = y;
-                SDL_FillRect(m_screen,NULL,SDL_MapRGB(m_screen->format,0,0,0));
-                SDL_Flip(m_screen);
-                if(m_overlay != NULL)
-                    SDL_DisplayYUVOverlay(m_overlay, &rect);
-                if(m_image != NULL) {
-                    SDL_BlitSurface(m_image, NULL, m_screen, &rect);
-                    SDL_UpdateRects(m_screen, 1, &rect);
+            if (d->onclick == 1) {
+                d->x += event.motion.xrel;
+                d->y += event.motion.yrel;
+                d->rect.x = d->x ; d->rect.y = d->y;
+                SDL_FillRect(d->m_screen,NULL,SDL_MapRGB(d->m_screen->format,0,0,0));
+                SDL_Flip(d->m_screen);
+                if(d->m_overlay != NULL)
+                    SDL_DisplayYUVOverlay(d->m_overlay, &d->rect);
+                if(d->m_image != NULL) {
+                    SDL_BlitSurface(d->m_image, NULL, d->m_screen, &d->rect);
+                    SDL_UpdateRects(d->m_screen, 1, &d->rect);
                 }
             }
             break;
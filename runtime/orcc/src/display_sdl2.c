@@ -29,30 +29,73 @@
 
 #include <SDL.h>
 
+#include "orcc_context.h"
 #include "orcc_util.h"
 
-static SDL_Window        *pWindow1;
-static SDL_Renderer      *pRenderer1;
-static SDL_Texture       *bmpTex1;
-static uint8_t           *pixels1;
-static int               pitch1, size1;
+// Display of a decoder
+struct display_s {
+    SDL_Window        *pWindow1;
+    SDL_Renderer      *pRenderer1;
+    SDL_Texture       *bmpTex1;
+    uint8_t           *pixels1;
+    int               pitch1, size1;
+
+    unsigned int lastWidth;
+    unsigned int lastHeight;
+};
 
 static int init = 0;
 
+static void display_free(struct display_s *d) {
+    if (d->bmpTex1 != NULL) {
+        SDL_DestroyTexture(d->bmpTex1);
+    }
+    if (d->pRenderer1 != NULL) {
+        SDL_DestroyRenderer(d->pRenderer1);
+    }
+    if (d->pWindow1 != NULL) {
+        SDL_DestroyWindow(d->pWindow1);
+    }
+
+    d->bmpTex1 = NULL;
+    d->pRenderer1 = NULL;
+    d->pWindow1 = NULL;
+}
+
+static void display_destroy(void *display) {
+    display_free((struct display_s *) display);
+    free(display);
+}
+
+static struct display_s *get_display() {
+    orcc_context *context = orcc_context_current();
+
+    if (context->display == NULL) {
+        context->display = calloc(1, sizeof(struct display_s));
+        context->display_close = display_destroy;
+    }
+
+    return (struct display_s *) context->display;
+}
+
 char displayYUV_getFlags(){
     return display_flags;
 }
 
 static void displayYUV_setSize(int width, int height) {
+    struct display_s *d = get_display();
     printf("set display to %ix%i\n", width, height);
 
+    // each decoder has its own window
+    display_free(d);
+
     // allocate window, renderer, texture
-    pWindow1    = SDL_CreateWindow( "display", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+    d->pWindow1    = SDL_CreateWindow( "display", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
                     width, height, SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL);
-    pRenderer1  = SDL_CreateRenderer(pWindow1, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    bmpTex1     = SDL_CreateTexture(pRenderer1, SDL_PIXELFORMAT_YV12,
+    d->pRenderer1  = SDL_CreateRenderer(d->pWindow1, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    d->bmpTex1     = SDL_CreateTexture(d->pRenderer1, SDL_PIXELFORMAT_YV12,
                     SDL_TEXTUREACCESS_STREAMING, width, height);
-    if(pWindow1==NULL || pRenderer1==NULL || bmpTex1==NULL) {
+    if(d->pWindow1==NULL || d->pRenderer1==NULL || d->bmpTex1==NULL) {
         fprintf(stderr, "Could not open window1\n");
     }
 }
@@ -60,28 +103,27 @@ static void displayYUV_setSize(int width, int height) {
 void displayYUV_displayPicture(unsigned char *pictureBufferY,
                                unsigned char *pictureBufferU, unsigned char *pictureBufferV,
                                unsigned int   pictureWidth,   unsigned int   pictureHeight) {
-    static unsigned int lastWidth = 0;
-    static unsigned int lastHeight = 0;
+    struct display_s *d = get_display();
     SDL_Event event;
 
-    if ((pictureHeight != lastHeight) || (pictureWidth != lastWidth)) {
+    if ((pictureHeight != d->lastHeight) || (pictureWidth != d->lastWidth)) {
         displayYUV_setSize(pictureWidth, pictureHeight);
-        lastHeight = pictureHeight;
-        lastWidth = pictureWidth;
+        d->lastHeight = pictureHeight;
+        d->lastWidth = pictureWidth;
     }
 
-    size1 = pictureWidth * pictureHeight;
+    d->size1 = pictureWidth * pictureHeight;
 
-    SDL_LockTexture(bmpTex1, NULL, (void **)&pixels1, &pitch1);
-    memcpy(pixels1,             pictureBufferY, size1  );
-    memcpy(pixels1 + size1,     pictureBufferV, size1/4);
-    memcpy(pixels1 + size1*5/4, pictureBufferU, size1/4);
-    SDL_UnlockTexture(bmpTex1);
-    SDL_UpdateTexture(bmpTex1, NULL, pixels1, pitch1);
+    SDL_LockTexture(d->bmpTex1, NULL, (void **)&d->pixels1, &d->pitch1);
+    memcpy(d->pixels1,                pictureBufferY, d->size1  );
+    memcpy(d->pixels1 + d->size1,     pictureBufferV, d->size1/4);
+    memcpy(d->pixels1 + d->size1*5/4, pictureBufferU, d->size1/4);
+    SDL_UnlockTexture(d->bmpTex1);
+    SDL_UpdateTexture(d->bmpTex1, NULL, d->pixels1, d->pitch1);
     // refresh screen
     //    SDL_RenderClear(pRenderer1);
-    SDL_RenderCopy(pRenderer1, bmpTex1, NULL, NULL);
-    SDL_RenderPresent(pRenderer1);
+    SDL_RenderCopy(d->pRenderer1, d->bmpTex1, NULL, NULL);
+    SDL_RenderPresent(d->pRenderer1);
 
     /* Grab all the events off the queue. */
     while (SDL_PollEvent(&event)) {
@@ -33,38 +33,38 @@
 #include <time.h>
 
 #include "fpsPrint.h"
-
-static unsigned int startTime;
-static unsigned int relativeStartTime;
-static int lastNumPic;
-static int numPicturesDecoded;
+#include "orcc_context.h"
 
 
 void print_fps_avg(void) {
+    orcc_context *context = orcc_context_current();
     unsigned int endTime = SDL_GetTicks();
 
-    printf("%i images in %f seconds: %f FPS\n", numPicturesDecoded,
-        (float) (endTime - startTime)/ 1000.0f,
-        1000.0f * (float) numPicturesDecoded / (float) (endTime -startTime));
+    printf("%i images in %f seconds: %f FPS\n", context->numPicturesDecoded,
+        (float) (endTime - context->fpsStartTime)/ 1000.0f,
+        1000.0f * (float) context->numPicturesDecoded / (float) (endTime - context->fpsStartTime));
 }
 
 void fpsPrintInit() {
-    startTime = SDL_GetTicks();
-    relativeStartTime = startTime;
-    numPicturesDecoded = 0;
-    lastNumPic = 0;
+    orcc_context *context = orcc_context_current();
+
+    context->fpsStartTime = SDL_GetTicks();
+    context->fpsRelativeStartTime = context->fpsStartTime;
+    context->numPicturesDecoded = 0;
+    context->lastNumPic = 0;
 }
 
 void fpsPrintNewPicDecoded(void) {
+    orcc_context *context = orcc_context_current();
     unsigned int endTime;
-    numPicturesDecoded++;
+    context->numPicturesDecoded++;
     endTime = SDL_GetTicks();
-    if ((endTime - relativeStartTime) / 1000.0f >= 5) {
+    if ((endTime - context->fpsRelativeStartTime) / 1000.0f >= 5) {
         printf("%f images/sec\n",
-                1000.0f * (float) (numPicturesDecoded - lastNumPic)
-                        / (float) (endTime - relativeStartTime));
+                1000.0f * (float) (context->numPicturesDecoded - context->lastNumPic)
+                        / (float) (endTime - context->fpsRelativeStartTime));
 
-        relativeStartTime = endTime;
-        lastNumPic = numPicturesDecoded;
+        context->fpsRelativeStartTime = endTime;
+        context->lastNumPic = context->numPicturesDecoded;
     }
 }
@@ -32,6 +32,7 @@
 #include <sys/stat.h>
 #include <time.h>
 
+#include "orcc_context.h"
 #include "orcc_util.h"
 #include "fpsPrint.h"
 
@@ -50,54 +51,47 @@
 
 const int PRINT_SPEED = 0;
 
-static FILE *file = NULL;
-static int nb;
-static int stop;
-static int genetic = 0;
-static clock_t startTime;
-static unsigned int nbByteRead = 0;
-
-int* stopVar;
-// count number of times file were read
-unsigned int loopsCount;
-
 void printSpeed(void) {
+    orcc_context *context = orcc_context_current();
     double executionTime;
     double speed;
 
-    executionTime = (double)(clock() - startTime)/CLOCKS_PER_SEC;
-    speed = nbByteRead / executionTime;
+    executionTime = (double)(clock() - context->startTime)/CLOCKS_PER_SEC;
+    speed = context->nbByteRead / executionTime;
     speed /= 1024;
     printf("Speed : %f Kib/s\n",speed);
 }
 
 // Called before any *_scheduler function.
 void source_init() {
-    stop = 0;
-    nb = 0;
+    orcc_context *context = orcc_context_current();
+    char *input = context->input_file != NULL ? context->input_file : input_file;
 
-    if (input_file == NULL) {
+    context->stopped = 0;
+    context->nb = 0;
+
+    if (input == NULL) {
         print_usage();
         fprintf(stderr, "No input file given!\n");
         wait_for_key();
         exit(1);
     }
 
-    file = fopen(input_file, "rb");
-    if (file == NULL) {
-        if (input_file == NULL) {
-            input_file = "<null>";
-        }
+    if (context->file != NULL) {
+        fclose(context->file);
+    }
 
-        fprintf(stderr, "could not open file \"%s\"\n", input_file);
+    context->file = fopen(input, "rb");
+    if (context->file == NULL) {
+        fprintf(stderr, "could not open file \"%s\"\n", input);
         wait_for_key();
         exit(1);
     }
     if(PRINT_SPEED) {
         atexit(printSpeed);
     }
-    startTime = clock();
-    loopsCount = nbLoops;
+    context->startTime = clock();
+    context->loopsCount = nbLoops;
 }
 
 unsigned int source_getNbLoop(void)
@@ -107,47 +101,55 @@ unsigned int source_getNbLoop(void)
 
 void source_exit(int exitCode)
 {
+    orcc_context *context = orcc_context_current();
     print_fps_avg();
 
     //Stop scheduler
-    *stopVar = 1;
+    orcc_context_stop(context);
 }
 
 int source_sizeOfFile() {
     struct stat st;
-    fstat(fileno(file), &st);
+    fstat(fileno(orcc_context_current()->file), &st);
     return st.st_size;
 }
 
 int source_is_stopped() {
-    return stop;
+    return orcc_context_current()->stopped;
 }
 
 void source_active_genetic() {
-    genetic = 1;
+    orcc_context_current()->genetic = 1;
 }
 
 void source_rewind() {
-    if(file != NULL) {
-        rewind(file);
-        if (genetic){
-            if(nb < LOOP_NUMBER) {
-                nb++;
+    orcc_context *context = orcc_context_current();
+
+    if(context->file != NULL) {
+        rewind(context->file);
+        if (context->genetic){
+            if(context->nb < LOOP_NUMBER) {
+                context->nb++;
             }
             else{
-                stop = 1;
+                context->stopped = 1;
             }
         }
     }
 }
 
 void source_close() {
-    if(file != NULL) {
-        int n = fclose(file);
+    orcc_context *context = orcc_context_current();
+
+    if(context->file != NULL) {
+        int n = fclose(context->file);
+        context->file = NULL;
     }
 }
 
 unsigned int source_readByte(){
+    orcc_context *context = orcc_context_current();
+    FILE *file = context->file;
     unsigned char buf[1];
     int n = fread(&buf, 1, 1, file);
 
@@ -155,38 +157,40 @@ unsigned int source_readByte(){
         if (feof(file)) {
             printf("warning\n");
             rewind(file);
-            if (!genetic || (genetic && nb < LOOP_NUMBER)) {
+            if (!context->genetic || (context->genetic && context->nb < LOOP_NUMBER)) {
                 n = fread(&buf, 1, 1, file);
-                nb++;
+                context->nb++;
             }
             else{
                 n = fclose(file);
-                stop = 1;
+                context->file = NULL;
+                context->stopped = 1;
             }
         }
         else {
             fprintf(stderr,"Problem when reading input file.\n");
         }
     }
-    nbByteRead += 8;
+    context->nbByteRead += 8;
     return buf[0];
 }
 
 
 void source_readNBytes(unsigned char *outTable, unsigned int nbTokenToRead){
-    int n = fread(outTable, 1, nbTokenToRead, file);
+    orcc_context *context = orcc_context_current();
+    int n = fread(outTable, 1, nbTokenToRead, context->file);
 
     if(n < nbTokenToRead) {
         fprintf(stderr,"Problem when reading input file.\n");
         exit(-4);
     }
-    nbByteRead += nbTokenToRead * 8;
+    context->nbByteRead += nbTokenToRead * 8;
 }
 
 void source_decrementNbLoops(){
-    --loopsCount;
+    --orcc_context_current()->loopsCount;
 }
 
 int source_isMaxLoopsReached(){
-    return nbLoops != DEFAULT_INFINITE_LOOP && loopsCount <= 0;
+    return nbLoops != DEFAULT_INFINITE_LOOP && orcc_context_current()->loopsCount <= 0;
 }
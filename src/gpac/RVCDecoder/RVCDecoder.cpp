@@ -115,7 +115,8 @@ void rvc_init(char *XDF, char* VTLFolder, int isAVCFile){
     llvm_start_multithreaded();
     InitializeNativeTarget();
     InitializeNativeTargetAsmPrinter();
-    LLVMContext &Context = getGlobalContext();
+    //Each decoder owns its context
+    LLVMContext &Context = *new LLVMContext();
 
 
     //Parsing XDF
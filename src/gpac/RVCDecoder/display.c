@@ -41,6 +41,7 @@
 #include <string.h>
 
 #include "display.h"
+#include "orcc_context.h"
 
 #define DISPLAY_READY 1
 #define DISPLAY_ENABLE 2
@@ -53,8 +54,6 @@ extern int bufferBusy;
 static RVCFRAME Frame;
 extern int safeguardFrameEmpty;
 
-extern int* stopVar;
-
 
 void displayYUV_prepare(char* Address){
     outBuffer = Address;
@@ -96,7 +95,7 @@ void displayYUV_displayPicture(unsigned char *pictureBufferY, unsigned char *pic
 
         display_flag = DISPLAY_ENABLE;
 
-        *stopVar = 1;
+        orcc_context_stop(orcc_context_current());
     }
 }
 
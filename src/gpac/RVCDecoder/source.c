@@ -40,6 +40,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "orcc_context.h"
 #include "orcc_util.h"
 #include "source.h"
 
@@ -52,7 +53,6 @@ static unsigned char* data;
 static int nbTokenSend;
 extern int nalState;
 
-int* stopVar;
 // count number of times file were read
 unsigned int loopsCount;
 
@@ -69,7 +69,7 @@ void source_init() {
 int source_sizeOfFile() { 
     if(!data_length){
         //Stop scheduler
-        *stopVar = 1;
+        orcc_context_stop(orcc_context_current());
         return 0;
     }else{
         return data_length + startCodeSize;
@@ -180,6 +180,9 @@ cl::list<const PassInfo*, bool, PassNameParser> PassList(cl::desc("Optimizations
 
 cl::opt<bool> ArmFix("arm-fix", cl::desc("Fix execution for ARM platform (Linux only)"));
 
+// Tiered compilation optimizes hot instances while running
+extern cl::opt<bool> TieredJit;
+
 bool enableTrace = false;
 char **environnement;
 
@@ -267,7 +270,8 @@ void setTraces(Network* network){
 
 //Command line decoder control
 void startCmdLine(){
-    LLVMContext &Context = getGlobalContext();
+    //The decoder owns the context of its network
+    LLVMContext &Context = *new LLVMContext();
 
     for (unsigned int i =0 ; i < PassList.size(); i++ ){
         cout << "Pass added: "<< PassList[i]->getPassName() << endl;
@@ -300,8 +304,8 @@ void startCmdLine(){
     //Load network
     engine->load(network);
 
-    // Optimizing decoder
-    if (optLevel > 0){
+    // Optimizing decoder, hot instances only when compilation is tiered
+    if (optLevel > 0 && !TieredJit){
         engine->optimize(network, optLevel);
     }
 
@@ -319,7 +323,7 @@ void startCmdLine(){
     }
 
     //Run network
-    engine->run(network);
+    engine->run(network, VidFile);
 
     cout << "End of Jade" << endl;
     cout << "Total time: " << (clock() - timer) * 1000 / CLOCKS_PER_SEC << " ms" << endl;
@@ -331,7 +335,7 @@ void startCmdLine(){
 
 int main(int argc, char **argv, char **envp) {
     clock_t start = clock ();
-    LLVMContext &Context = getGlobalContext();
+    LLVMContext Context;
     environnement = envp;
 
     // Print a stack trace if we signal out.
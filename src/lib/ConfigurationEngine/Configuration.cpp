@@ -103,6 +103,12 @@ void Configuration::setPartition(Instance* instance){
 
 void Configuration::setInstances(){
     instances.clear();
+    unpartitioned.clear();
+
+    map<string, Partition*>::iterator itPartition;
+    for (itPartition = partitions.begin(); itPartition != partitions.end(); itPartition++){
+        itPartition->second->clear();
+    }
 
     // Create list of instance and actor
     HDAGGraph* graph = network->getGraph();
@@ -170,6 +176,25 @@ void Configuration::insertSpecific(Actor* actor){
     specificActors.push_back(actor);
 }
 
+Partition* Configuration::getPartition(Instance* instance){
+    map<string, string>::iterator itMapping;
+    map<string, string>* mapping = network->getMapping();
+
+    itMapping = mapping->find(instance->getId());
+
+    if (itMapping == mapping->end()){
+        return NULL;
+    }
+
+    map<string, Partition*>::iterator itPartition = partitions.find(itMapping->second);
+
+    if (itPartition == partitions.end()){
+        return NULL;
+    }
+
+    return itPartition->second;
+}
+
 Instance* Configuration::getInstance(std::string name){
     map<string, Instance*>::iterator it;
 
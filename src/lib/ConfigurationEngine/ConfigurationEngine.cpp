@@ -39,9 +39,12 @@
 #include <map>
 #include <iostream>
 
+#include "llvm/Support/CommandLine.h"
+
 #include "Reconfiguration.h"
 #include "Connector.h"
 #include "Initializer.h"
+#include "FifoSizer.h"
 
 #include "lib/RVCEngine/Decoder.h"
 #include "lib/IRActor/BroadcastAdder.h"
@@ -59,6 +62,10 @@
 using namespace std;
 using namespace llvm;
 
+cl::opt<bool> BroadcastActors("broadcast-actors",
+                              cl::desc("Copy tokens of ports with several readers through broadcast actors instead of sharing their fifo"),
+                              cl::init(false));
+
 ConfigurationEngine::ConfigurationEngine(llvm::LLVMContext& C, bool verbose) : Context(C){
     this->verbose = verbose;
 }
@@ -67,16 +74,18 @@ void ConfigurationEngine::configure(Decoder* decoder){
     map<string, Instance*>::iterator it;
     Configuration* configuration = decoder->getConfiguration();
 
-    // Adding broadcast
-    BroadcastAdder broadAdder(Context,configuration, decoder);
-    broadAdder.transform();
+    // Adding broadcast, otherwise readers share the fifo of the port
+    if (BroadcastActors){
+        BroadcastAdder broadAdder(Context,configuration, decoder);
+        broadAdder.transform();
+    }
 
     //Merge static actors together if needed
-    /*  if (configuration->mergeActors()){
+    if (configuration->mergeActors()){
         Merger merger(Context, configuration, verbose);
         merger.transform();
     }
-*/
+
     //Write instance
     IRWriter writer(Context, decoder);
     map<string, Instance*>* instances = configuration->getInstances();
@@ -85,6 +94,10 @@ void ConfigurationEngine::configure(Decoder* decoder){
         writer.write(it->second);
     }
 
+    // Size fifos before they are created
+    FifoSizer sizer(Context, configuration, verbose);
+    sizer.transform();
+
     // Setting connections of the decoder
     Connector connector(Context, decoder);
     connector.setConnections(configuration);
@@ -93,11 +106,22 @@ void ConfigurationEngine::configure(Decoder* decoder){
 void ConfigurationEngine::reconfigure(Decoder* decoder, Configuration* configuration){
     list<Instance*>::iterator it;
 
-    //Clear connections of the decoder
-    clearConnections(decoder);
+    // Adding new broadcast before comparing the connections of both configurations
+    BroadcastAdder broadAdder(Context, configuration, decoder);
+    if (BroadcastActors){
+        broadAdder.transform();
+    }
 
     //Process reconfiguration scenario
     Reconfiguration reconfiguration(decoder, configuration, verbose);
+    list<pair<Connection*, Connection*> >* keepConnections = reconfiguration.getConnectionsToKeep();
+
+    if (verbose){
+        cout << "Detected " << keepConnections->size() << " connection to keep with their fifo." << endl;
+    }
+
+    //Clear connections of the decoder
+    clearConnections(decoder, keepConnections);
 
     //Remove unused instances
     IRUnwriter unwriter(decoder);
@@ -116,9 +140,7 @@ void ConfigurationEngine::reconfigure(Decoder* decoder, Configuration* configura
     //Write new instances
     IRWriter writer(Context, decoder);
 
-    // Adding new broadcast
-    BroadcastAdder broadAdder(Context, configuration, decoder);
-    broadAdder.transform();
+    // Write new broadcast
     list<Instance*>* broads = broadAdder.getBroads();
     for (it = broads->begin(); it != broads->end(); it++){
         writer.write(*it);
@@ -146,16 +168,23 @@ void ConfigurationEngine::reconfigure(Decoder* decoder, Configuration* configura
     IRLinker linker(decoder);
     linker.link(keeps);
 
+    // Size fifos before they are created, as when the decoder is built
+    FifoSizer sizer(Context, configuration, verbose);
+    sizer.transform(keepConnections);
+
     Initializer initializer(Context, decoder);
     for (itKeep = keeps->begin(); itKeep != keeps->end(); itKeep++){
-        initializer.add((*itKeep).second);
+        // Instances with all their fifos kept go on from their current state
+        if (reconfiguration.isDisturbed((*itKeep).second)){
+            initializer.add((*itKeep).second);
+        }
     }
 
     initializer.initialize();
 
     // Setting connections of the decoder
     Connector connector(Context, decoder);
-    connector.setConnections(configuration, decoder->getEE());
+    connector.setConnections(configuration, decoder->getEE(), keepConnections);
 
     // Add the new instances to the scheduler
     Scheduler* scheduler = decoder->getScheduler();
@@ -191,13 +220,13 @@ void ConfigurationEngine::reinit(Decoder* decoder){
     connector.setConnections(configuration, decoder->getEE());
 }
 
-void ConfigurationEngine::clearConnections(Decoder* decoder){
+void ConfigurationEngine::clearConnections(Decoder* decoder, list<pair<Connection*, Connection*> >* keeps){
     //Retrieve orignal configuration from the decoder
     Configuration* configuration = decoder->getConfiguration();
 
     //Remove connections
     Connector connector(Context, decoder);
-    connector.unsetConnections(configuration);
+    connector.unsetConnections(configuration, keeps);
 
     //Unwrite broadcasts
     list<Actor*>::iterator itActor;
@@ -41,17 +41,21 @@
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
 
 #include "Connector.h"
 #include "lib/RVCEngine/Decoder.h"
 #include "lib/ConfigurationEngine/Configuration.h"
 #include "lib/IRCore/Network.h"
+#include "lib/IRCore/Network/Instance.h"
 #include "lib/IRJit/LLVMExecution.h"
 //------------------------------
 
 using namespace std;
 using namespace llvm;
 
+extern cl::opt<int> WorkStealingThreads;
+
 Connector::Connector(llvm::LLVMContext& C, Decoder* decoder) : Context(C){
     this->decoder = decoder;
     this->module = decoder->getModule();
@@ -66,21 +70,47 @@ void Connector::setConnections(Configuration* configuration){
     HDAGGraph* graph = network->getGraph();
 
     int edges = graph->getNbEdges();
+    examineConnections(graph);
 
     for (int i = 0; i < edges; i++){
         setConnection((Connection*)graph->getEdge(i));
     }
 }
 
-void Connector::unsetConnections(Configuration* configuration){
+void Connector::examineConnections(HDAGGraph* graph){
+    int edges = graph->getNbEdges();
+
+    fifos.clear();
+    readers.clear();
+    readerIds.clear();
+
+    // Readers of each output port share the same fifo
+    for (int i = 0; i < edges; i++){
+        Connection* connection = (Connection*)graph->getEdge(i);
+        readers[connection->getSourcePort()].push_back(connection);
+    }
+}
+
+void Connector::unsetConnections(Configuration* configuration, list<pair<Connection*, Connection*> >* keeps){
     Network* network = configuration->getNetwork();
     HDAGGraph* graph = network->getGraph();
 
     int edges = graph->getNbEdges();
 
+    set<Connection*> kept;
+    if (keeps != NULL){
+        list<pair<Connection*, Connection*> >::iterator it;
+        for (it = keeps->begin(); it != keeps->end(); it++){
+            kept.insert(it->first);
+        }
+    }
+
     for (int i = 0; i < edges; i++){
         Connection* connection = ((Connection*)graph->getEdge(i));
-        connection->unsetFifo();
+
+        if (kept.find(connection) == kept.end()){
+            connection->unsetFifo();
+        }
     }
 }
 
@@ -102,35 +132,134 @@ void Connector::connect(Port* port, Fifo* fifo){
     var->setInitializer(fifo->getGV());
 }
 
+bool Connector::isConcurrent(Connection* connection){
+    // Every instance may be executed by any worker
+    if (WorkStealingThreads > 0){
+        return true;
+    }
+
+    Instance* src = connection->getSourcePort()->getInstance();
+    Instance* dst = connection->getDestinationPort()->getInstance();
+
+    if (src == NULL || dst == NULL){
+        return false;
+    }
+
+    // Unpartitioned instances are all executed by the main thread
+    Configuration* configuration = src->getConfiguration();
+    return configuration->getPartition(src) != configuration->getPartition(dst);
+}
+
+Fifo* Connector::getFifo(Port* src){
+    map<Port*, Fifo*>::iterator it = fifos.find(src);
+
+    if (it != fifos.end()){
+        return it->second;
+    }
+
+    // The fifo is shared between threads if one of the readers is
+    list<Connection*>* connections = &readers[src];
+    list<Connection*>::iterator itConn;
+    bool concurrent = false;
+    for (itConn = connections->begin(); itConn != connections->end(); itConn++){
+        concurrent |= isConcurrent(*itConn);
+    }
+
+    // Ports already compiled keep the kind of fifo they have been written for
+    if (src->getFifoVar() != NULL){
+        concurrent = src->isConcurrent();
+    }
+
+    src->setConcurrent(concurrent);
+
+    //Initialize source port with a new fifo
+    Fifo* fifo = new Fifo(Context, module, src->getType(), src->getFifoSize(), connections->size(), concurrent);
+    connect(src, fifo);
+
+    fifos.insert(pair<Port*, Fifo*>(src, fifo));
+    readerIds.insert(pair<Port*, int>(src, 0));
+
+    return fifo;
+}
+
 void Connector::setConnection(Connection* connection){
     //Source port is choosen as the reference type
     Port* src = connection->getSourcePort();
     Port* dst = connection->getDestinationPort();
+    Fifo* fifo = getFifo(src);
+
+    if (dst->getFifoVar() != NULL && dst->isConcurrent() != src->isConcurrent()){
+        cerr << "Error: ports " << src->getName() << " and " << dst->getName() << " are bound to different kinds of fifo." << endl;
+        exit(1);
+    }
+
+    // Each reader has its own read index in the fifo
+    int readerId = readerIds[src]++ * Fifo::getReadIndStride(src->isConcurrent());
+    dst->setConcurrent(src->isConcurrent());
+    dst->setReaderId(readerId);
+
+    if (dst->getId() != NULL){
+        dst->getId()->setInitializer(ConstantInt::get(Type::getInt32Ty(Context), readerId));
+    }
 
-    //Initialize ports with a new fifo
-    Fifo* fifo = new Fifo(Context, decoder->getModule(), src->getType(), connection->getSize());
-    connect(src, fifo);
     connect(dst, fifo);
 
-    // Set the new fifo to the connection
+    // Set the fifo to the connection
     connection->setFifo(fifo);
 }
 
-void Connector::setConnections(Configuration* configuration, LLVMExecution* executionEngine){
+void Connector::setConnections(Configuration* configuration, LLVMExecution* executionEngine,
+                               list<pair<Connection*, Connection*> >* keeps){
     Network* network = configuration->getNetwork();
     HDAGGraph* graph = network->getGraph();
 
     int edges = graph->getNbEdges();
+    examineConnections(graph);
+
+    set<Connection*> kept;
+    if (keeps != NULL){
+        list<pair<Connection*, Connection*> >::iterator it;
+        for (it = keeps->begin(); it != keeps->end(); it++){
+            keepConnection(it->first, it->second);
+            kept.insert(it->second);
+        }
+    }
 
     for (int i = 0; i < edges; i++){
-        setConnection((Connection*)graph->getEdge(i), executionEngine);
+        Connection* connection = (Connection*)graph->getEdge(i);
+
+        if (kept.find(connection) == kept.end()){
+            setConnection(connection, executionEngine);
+        }
     }
 }
 
+void Connector::keepConnection(Connection* ref, Connection* connection){
+    Port* src = connection->getSourcePort();
+    Port* dst = connection->getDestinationPort();
+    Port* refDst = ref->getDestinationPort();
+    Fifo* fifo = ref->getFifo();
+
+    // Compiled ports still address the fifo with their former read index
+    src->setConcurrent(ref->getSourcePort()->isConcurrent());
+    dst->setConcurrent(refDst->isConcurrent());
+    dst->setReaderId(refDst->getReaderId());
+
+    fifos[src] = fifo;
+    connection->setFifo(fifo);
+    ref->setFifo(NULL);
+}
+
 void Connector::setConnection(Connection* connection, LLVMExecution* executionEngine){
     setConnection(connection);
 
     //Source port is choosen as the reference type
     executionEngine->mapFifo(connection->getSourcePort(), connection->getFifo());
     executionEngine->mapFifo(connection->getDestinationPort(), connection->getFifo());
+
+    // Update the reader id of a compiled port
+    GlobalVariable* id = connection->getDestinationPort()->getId();
+    if (id != NULL && executionEngine->isCompiledGV(id)){
+        *(int*)executionEngine->getGVPtr(id) = connection->getDestinationPort()->getReaderId();
+    }
 }
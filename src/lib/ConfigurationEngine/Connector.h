@@ -46,9 +46,14 @@ class Module;
 class Connection;
 class Configuration;
 class Decoder;
+class HDAGGraph;
 class LLVMExecution;
 class Port;
 
+#include <list>
+#include <map>
+#include <set>
+
 #include "llvm/IR/LLVMContext.h"
 #include "lib/RoundRobinScheduler/Fifo.h"
 //------------------------------
@@ -90,8 +95,11 @@ public:
      * @param configuration : the Configuration where connections are printed.
      *
      * @param executionEngine : the Execution Engine that can retrieve fifo pointer
+     *
+     * @param keeps : couples of original and new connections that keep their fifo, can be NULL
      */
-    void setConnections(Configuration* configuration, LLVMExecution* executionEngine);
+    void setConnections(Configuration* configuration, LLVMExecution* executionEngine,
+                        std::list<std::pair<Connection*, Connection*> >* keeps = NULL);
 
     /**
      * @brief Remove connections
@@ -99,8 +107,11 @@ public:
      * Remove connections from the given configuration.
      *
      * @param configuration : the Configuration where connections are removed
+     *
+     * @param keeps : couples of original and new connections whose fifo is not removed, can be NULL
      */
-    void unsetConnections(Configuration* configuration);
+    void unsetConnections(Configuration* configuration,
+                          std::list<std::pair<Connection*, Connection*> >* keeps = NULL);
 
 
 private:
@@ -120,6 +131,35 @@ private:
      */
     void setConnection(Connection* connection, LLVMExecution* executionEngine);
 
+    /**
+     * @brief Move the fifo of an original connection to a new connection
+     *
+     * The buffer and the indexes of the fifo are left untouched.
+     *
+     * @param ref : the Connection of the original configuration
+     *
+     * @param connection : the Connection of the new configuration
+     */
+    void keepConnection(Connection* ref, Connection* connection);
+
+    /**
+     * @brief List the readers of each output port of a graph
+     *
+     * @param graph : the HDAGGraph to connect
+     */
+    void examineConnections(HDAGGraph* graph);
+
+    /**
+     * @brief Get the fifo written by an output port
+     *
+     * The fifo is created with one read index for each reader of the port.
+     *
+     * @param src : the output Port
+     *
+     * @return the fifo of the port
+     */
+    Fifo* getFifo(Port* src);
+
     /**
      * @brief Connect a port to a fifo
      *
@@ -129,6 +169,15 @@ private:
      */
     void connect(Port* port, Fifo* fifo);
 
+    /**
+     * @brief Return true if the ends of a connection run on different threads
+     *
+     * @param connection : the Connection to check
+     *
+     * @return true if the connection crosses a partition
+     */
+    bool isConcurrent(Connection* connection);
+
     /** LLVM Context */
     llvm::LLVMContext &Context;
 
@@ -138,6 +187,15 @@ private:
     /** Decoder to print connection */
     Decoder* decoder;
 
+    /** Connections reading each output port */
+    std::map<Port*, std::list<Connection*> > readers;
+
+    /** Fifo created for each output port */
+    std::map<Port*, Fifo*> fifos;
+
+    /** Next reader id of each output port */
+    std::map<Port*, int> readerIds;
+
 };
 
 #endif
@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class FifoSizer
+@author agent
+@file FifoSizer.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <set>
+
+#include "llvm/IR/Constants.h"
+#include "llvm/Support/CommandLine.h"
+
+#include "FifoSizer.h"
+#include "lib/ConfigurationEngine/Configuration.h"
+#include "lib/IRCore/Network.h"
+#include "lib/IRCore/Network/Connection.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/IRCore/Actor.h"
+#include "lib/IRCore/Actor/Action.h"
+#include "lib/IRCore/Actor/Pattern.h"
+#include "lib/IRCore/MoC/CSDFMoC.h"
+#include "lib/RoundRobinScheduler/StaticRegion.h"
+//------------------------------
+
+using namespace std;
+using namespace llvm;
+
+extern cl::opt<int> FifoSize;
+extern cl::opt<bool> StaticRegions;
+
+cl::opt<bool> FifoAutoSize("fifo-auto-size",
+                           cl::desc("Size fifos from the rates of static links and from a profile of dynamic links"),
+                           cl::init(true));
+
+cl::opt<int> FifoSizeMin("fifo-size-min",
+                         cl::desc("Smallest size given to a fifo by automatic sizing"),
+                         cl::init(64));
+
+cl::opt<std::string> FifoProfile("fifo-profile",
+                                 cl::desc("Size dynamic links from the high-water marks of a profile"),
+                                 cl::value_desc("profile file"),
+                                 cl::init(""));
+
+// Patterns of instances linked by a reconfiguration refer to the ports of
+// the previous configuration, their ports are also found by name
+static ConstantInt* getNumTokens(Pattern* pattern, Port* port){
+    ConstantInt* numTokens = pattern->getNumTokens(port);
+
+    if (numTokens != NULL){
+        return numTokens;
+    }
+
+    map<Port*, ConstantInt*>::iterator it;
+    map<Port*, ConstantInt*>* numTokensMap = pattern->getNumTokensMap();
+    for (it = numTokensMap->begin(); it != numTokensMap->end(); it++){
+        if (it->first->getName() == port->getName()){
+            return it->second;
+        }
+    }
+
+    return NULL;
+}
+
+// Instances linked by a reconfiguration have the MoC of their actor
+static MoC* getMoC(Instance* instance){
+    if (instance->getMoC() != NULL || instance->getActor() == NULL){
+        return instance->getMoC();
+    }
+
+    return instance->getActor()->getMoC();
+}
+
+static int gcd(int a, int b){
+    while (b != 0){
+        int r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+FifoSizer::FifoSizer(LLVMContext& C, Configuration* configuration, bool verbose) : Context(C){
+    this->configuration = configuration;
+    this->verbose = verbose;
+}
+
+FifoSizer::~FifoSizer(){
+
+}
+
+void FifoSizer::transform(list<pair<Connection*, Connection*> >* keeps){
+    if (!FifoAutoSize){
+        return;
+    }
+
+    // Fifos kept from a previous configuration keep their size
+    set<Connection*> kept;
+    if (keeps != NULL){
+        list<pair<Connection*, Connection*> >::iterator it;
+        for (it = keeps->begin(); it != keeps->end(); it++){
+            kept.insert(it->second);
+        }
+    }
+
+    if (!FifoProfile.empty()){
+        loadProfile(FifoProfile);
+    }
+
+    if (StaticRegions && configuration->mergeActors()){
+        findRegions();
+    }
+
+    findCycles();
+
+    HDAGGraph* graph = configuration->getNetwork()->getGraph();
+    int edges = graph->getNbEdges();
+    int sized = 0;
+    long long before = 0;
+    long long after = 0;
+
+    for (int i = 0; i < edges; i++){
+        Connection* connection = (Connection*)graph->getEdge(i);
+        int previous = connection->getSize();
+        before += previous;
+
+        // Sizes given by the network are kept, computed sizes are not added to them
+        connection->setComputedSize(0);
+        if (connection->getAttribute("bufferSize") != NULL || kept.find(connection) != kept.end()){
+            after += previous;
+            continue;
+        }
+
+        int size = getStaticSize(connection);
+        if (size == 0){
+            size = getProfiledSize(connection);
+        }
+
+        if (size == 0){
+            after += previous;
+            continue;
+        }
+
+        connection->setComputedSize(size);
+        after += connection->getSize();
+        sized++;
+    }
+
+    if (verbose){
+        cout << "--> " << sized << " fifos sized automatically, fifo tokens reduced from "
+             << before << " to " << after << "." << endl;
+    }
+}
+
+void FifoSizer::findRegions(){
+    // Regions are found in each partition, as in the schedulers of the decoder
+    list<list<Instance*>*> partitions;
+    partitions.push_back(configuration->getUnpartitioned());
+
+    map<string, Partition*>::iterator itPartition;
+    map<string, Partition*>* configPartitions = configuration->getPartitions();
+    for (itPartition = configPartitions->begin(); itPartition != configPartitions->end(); itPartition++){
+        partitions.push_back(itPartition->second->getInstances());
+    }
+
+    list<list<Instance*>*>::iterator it;
+    for (it = partitions.begin(); it != partitions.end(); it++){
+        list<StaticRegion*> regions = StaticRegion::findRegions(*it);
+
+        list<StaticRegion*>::iterator itRegion;
+        for (itRegion = regions.begin(); itRegion != regions.end(); itRegion++){
+            StaticRegion* region = *itRegion;
+            list<Instance*>::iterator itInst;
+            list<Instance*>* instances = region->getInstances();
+
+            for (itInst = instances->begin(); itInst != instances->end(); itInst++){
+                map<string, Port*>::iterator itPort;
+                map<string, Port*>* outputs = (*itInst)->getOutputs();
+
+                for (itPort = outputs->begin(); itPort != outputs->end(); itPort++){
+                    list<Connection*>::iterator itConn;
+                    list<Connection*>* connections = itPort->second->getConnections();
+
+                    for (itConn = connections->begin(); itConn != connections->end(); itConn++){
+                        if (region->isInternal(*itConn)){
+                            regionTokens[*itConn] = region->getTokens(itPort->second);
+                        }
+                    }
+                }
+            }
+
+            delete region;
+        }
+    }
+}
+
+void FifoSizer::findCycles(){
+    HDAGGraph* graph = configuration->getNetwork()->getGraph();
+    int edges = graph->getNbEdges();
+
+    for (int i = 0; i < edges; i++){
+        Connection* connection = (Connection*)graph->getEdge(i);
+        Instance* src = connection->getSourcePort()->getInstance();
+        Instance* dst = connection->getDestinationPort()->getInstance();
+
+        if (src != NULL && dst != NULL){
+            successors[src].push_back(dst);
+            successors[dst];
+        }
+    }
+
+    // Strongly connected components of Tarjan, in one pass over the network
+    int index = 0;
+    map<Instance*, int> indexes;
+    map<Instance*, int> lowLinks;
+    list<Instance*> stack;
+    set<Instance*> onStack;
+
+    map<Instance*, list<Instance*> >::iterator it;
+    for (it = successors.begin(); it != successors.end(); it++){
+        if (indexes.find(it->first) == indexes.end()){
+            findComponent(it->first, index, indexes, lowLinks, stack, onStack);
+        }
+    }
+}
+
+void FifoSizer::findComponent(Instance* instance, int& index, map<Instance*, int>& indexes,
+                              map<Instance*, int>& lowLinks, list<Instance*>& stack, set<Instance*>& onStack){
+    indexes[instance] = index;
+    lowLinks[instance] = index;
+    index++;
+    stack.push_back(instance);
+    onStack.insert(instance);
+
+    list<Instance*>::iterator it;
+    list<Instance*>& next = successors[instance];
+    for (it = next.begin(); it != next.end(); it++){
+        if (indexes.find(*it) == indexes.end()){
+            findComponent(*it, index, indexes, lowLinks, stack, onStack);
+            lowLinks[instance] = min(lowLinks[instance], lowLinks[*it]);
+        }else if (onStack.find(*it) != onStack.end()){
+            lowLinks[instance] = min(lowLinks[instance], indexes[*it]);
+        }
+    }
+
+    if (lowLinks[instance] != indexes[instance]){
+        return;
+    }
+
+    // Instances of the component are numbered by their root
+    Instance* member;
+    do{
+        member = stack.back();
+        stack.pop_back();
+        onStack.erase(member);
+        components[member] = indexes[instance];
+    }while (member != instance);
+}
+
+bool FifoSizer::isInCycle(Connection* connection){
+    Instance* src = connection->getSourcePort()->getInstance();
+    Instance* dst = connection->getDestinationPort()->getInstance();
+
+    // A self-loop is a cycle on its own
+    return src == dst || components[src] == components[dst];
+}
+
+void FifoSizer::loadProfile(string file){
+    ifstream profileFile(file.c_str());
+
+    if (!profileFile.is_open()){
+        cerr << "Error opening fifo profile " << file << endl;
+        exit(1);
+    }
+
+    // Each line is: source port destination port high-water size
+    string srcInstance, srcPort, dstInstance, dstPort;
+    int highWater, size;
+    while (profileFile >> srcInstance >> srcPort >> dstInstance >> dstPort >> highWater >> size){
+        string key = srcInstance + " " + srcPort + " " + dstInstance + " " + dstPort;
+        profile[key] = pair<int, int>(highWater, size);
+    }
+}
+
+int FifoSizer::getStaticSize(Connection* connection){
+    Port* srcPort = connection->getSourcePort();
+    Port* dstPort = connection->getDestinationPort();
+    Instance* src = srcPort->getInstance();
+    Instance* dst = dstPort->getInstance();
+
+    if (src == NULL || dst == NULL || getMoC(src) == NULL || getMoC(dst) == NULL){
+        return 0;
+    }
+
+    // Bounds of isolated links do not hold on cycles, their fifos keep the default size
+    if (isInCycle(connection)){
+        return 0;
+    }
+
+    if (!getMoC(src)->isCSDF() || !getMoC(dst)->isCSDF()){
+        return 0;
+    }
+
+    ConstantInt* prod = getNumTokens(((CSDFMoC*)getMoC(src))->getOutputPattern(), srcPort);
+    ConstantInt* cons = getNumTokens(((CSDFMoC*)getMoC(dst))->getInputPattern(), dstPort);
+
+    if (prod == NULL || cons == NULL){
+        return 0;
+    }
+
+    // Minimum deadlock-free size of an isolated link with d initial tokens
+    int p = prod->getLimitedValue();
+    int c = cons->getLimitedValue();
+    int d = StaticRegion::getInitialTokens(srcPort);
+    int g = gcd(p, c);
+    int size = p + c - g + d % g;
+
+    if (d > size){
+        size = d;
+    }
+
+    // Doubled so that both sides can fire without waiting for each other
+    size = 2 * size;
+
+    // Links inside a static region hold the tokens of a whole iteration and the initial tokens
+    map<Connection*, int>::iterator it = regionTokens.find(connection);
+    if (it != regionTokens.end() && it->second + d > size){
+        size = it->second + d;
+    }
+
+    return size < FifoSizeMin ? (int)FifoSizeMin : size;
+}
+
+int FifoSizer::getProfiledSize(Connection* connection){
+    map<string, pair<int, int> >::iterator it = profile.find(getKey(connection));
+
+    if (it == profile.end()){
+        return 0;
+    }
+
+    // A full fifo may have throttled the link, keep its size
+    int highWater = it->second.first;
+    if (highWater >= it->second.second){
+        return 0;
+    }
+
+    // Largest patterns of both sides must fit in the fifo
+    Port* srcPort = connection->getSourcePort();
+    Port* dstPort = connection->getDestinationPort();
+    int size = getMaxRate(srcPort->getInstance(), srcPort) + getMaxRate(dstPort->getInstance(), dstPort);
+
+    if (highWater > size){
+        size = highWater;
+    }
+
+    return size < FifoSizeMin ? (int)FifoSizeMin : size;
+}
+
+int FifoSizer::getMaxRate(Instance* instance, Port* port){
+    int rate = 1;
+
+    if (instance == NULL){
+        return rate;
+    }
+
+    list<Action*>::iterator it;
+    list<Action*>* actions = instance->getActions();
+    for (it = actions->begin(); it != actions->end(); it++){
+        Action* action = *it;
+        Pattern* patterns[3] = {action->getInputPattern(), action->getOutputPattern(), action->getPeekPattern()};
+
+        for (int i = 0; i < 3; i++){
+            ConstantInt* numTokens = getNumTokens(patterns[i], port);
+            if (numTokens != NULL && (int)numTokens->getLimitedValue() > rate){
+                rate = numTokens->getLimitedValue();
+            }
+        }
+    }
+
+    return rate;
+}
+
+string FifoSizer::getKey(Connection* connection){
+    Port* srcPort = connection->getSourcePort();
+    Port* dstPort = connection->getDestinationPort();
+    string src = srcPort->getInstance() != NULL ? srcPort->getInstance()->getId() : "";
+    string dst = dstPort->getInstance() != NULL ? dstPort->getInstance()->getId() : "";
+
+    return src + " " + srcPort->getName() + " " + dst + " " + dstPort->getName();
+}
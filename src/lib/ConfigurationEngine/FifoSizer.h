@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the FifoSizer class interface
+@author agent
+@file FifoSizer.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef FIFOSIZER_H
+#define FIFOSIZER_H
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+
+#include "llvm/IR/LLVMContext.h"
+
+class Configuration;
+class Connection;
+class Instance;
+class Port;
+//------------------------------
+
+/**
+ * @class FifoSizer
+ *
+ * @brief This class chooses the size of the fifos of a configuration.
+ *
+ * Links between two CSDF instances outside of a cycle get the minimum
+ * deadlock-free size computed from their patterns and initial tokens,
+ * other links are sized from the high-water marks of a previous run when a
+ * profile is given. Chosen sizes are set on the connections without being
+ * added to their attributes, connections with a bufferSize given by the
+ * network or that keep their fifo are left unchanged.
+ *
+ * @author agent
+ *
+ */
+class FifoSizer {
+public:
+
+    /**
+     * @brief Constructor of fifo sizer.
+     *
+     * @param C : the LLVMContext
+     *
+     * @param configuration : the Configuration to size
+     *
+     * @param verbose : verbose actions taken
+     */
+    FifoSizer(llvm::LLVMContext& C, Configuration* configuration, bool verbose = false);
+
+    ~FifoSizer();
+
+    /**
+     * @brief Set the size of the connections of the configuration
+     *
+     * @param keeps : couples of original and new connections that keep their fifo, can be NULL
+     */
+    void transform(std::list<std::pair<Connection*, Connection*> >* keeps = NULL);
+
+private:
+    /**
+     * @brief Find the links inside static regions
+     *
+     * Links of a region scheduled as a whole must hold the tokens of an
+     * iteration of the region.
+     */
+    void findRegions();
+
+    /**
+     * @brief Find the strongly connected components of the network
+     */
+    void findCycles();
+
+    /**
+     * @brief Number the instances of the component of an instance
+     *
+     * @param instance : the Instance to visit
+     *
+     * @param index : the next index of a visited instance
+     *
+     * @param indexes : the indexes of the visited instances
+     *
+     * @param lowLinks : the smallest index reached from each visited instance
+     *
+     * @param stack : the instances of the components being visited
+     *
+     * @param onStack : the instances in stack
+     */
+    void findComponent(Instance* instance, int& index, std::map<Instance*, int>& indexes,
+                       std::map<Instance*, int>& lowLinks, std::list<Instance*>& stack, std::set<Instance*>& onStack);
+
+    /**
+     * @brief Return true if a connection is part of a cycle of the network
+     *
+     * @param connection : the Connection
+     *
+     * @return true if the destination of the connection reaches its source
+     */
+    bool isInCycle(Connection* connection);
+
+    /**
+     * @brief Load the high-water marks of the profile file
+     *
+     * @param file : name of the profile file
+     */
+    void loadProfile(std::string file);
+
+    /**
+     * @brief Compute the size of a link between two CSDF instances
+     *
+     * @param connection : the Connection to size
+     *
+     * @return the size of the connection, 0 if the link is not static
+     */
+    int getStaticSize(Connection* connection);
+
+    /**
+     * @brief Compute the size of a link from its profiled high-water mark
+     *
+     * @param connection : the Connection to size
+     *
+     * @return the size of the connection, 0 if the link has not been profiled
+     */
+    int getProfiledSize(Connection* connection);
+
+    /**
+     * @brief Get the largest number of tokens an action of an instance
+     *  reads or writes on a port
+     *
+     * @param instance : the Instance of the port
+     *
+     * @param port : the Port
+     *
+     * @return the largest rate of the port
+     */
+    int getMaxRate(Instance* instance, Port* port);
+
+    /**
+     * @brief Get the identifier of a connection in a profile
+     *
+     * @param connection : the Connection
+     *
+     * @return the identifier of the connection
+     */
+    std::string getKey(Connection* connection);
+
+    /** LLVM Context */
+    llvm::LLVMContext &Context;
+
+    /** Configuration to size */
+    Configuration* configuration;
+
+    /** Successors of each instance in the network */
+    std::map<Instance*, std::list<Instance*> > successors;
+
+    /** Strongly connected component of each instance */
+    std::map<Instance*, int> components;
+
+    /** Tokens of an iteration of the links inside static regions */
+    std::map<Connection*, int> regionTokens;
+
+    /** High-water marks and size of the profiled connections */
+    std::map<std::string, std::pair<int, int> > profile;
+
+    /** Verbose actions taken */
+    bool verbose;
+};
+
+#endif
@@ -42,9 +42,17 @@
 #include "Reconfiguration.h"
 
 #include "lib/RVCEngine/Decoder.h"
+#include "lib/IRCore/Expression.h"
+#include "lib/IRCore/Network.h"
+#include "lib/RoundRobinScheduler/StaticRegion.h"
+
+#include "llvm/Support/CommandLine.h"
 //------------------------------
 
 using namespace std;
+using namespace llvm;
+
+extern cl::opt<bool> SpecializeParams;
 
 Reconfiguration::Reconfiguration(Decoder* decoder, Configuration* configuration, bool verbose){
     this->verbose = verbose;
@@ -63,6 +71,9 @@ Reconfiguration::Reconfiguration(Decoder* decoder, Configuration* configuration,
 
     //Couple similar instances
     detectInstances(&intersect);
+
+    //Couple connections between kept instances
+    detectConnections();
 }
 
 void Reconfiguration::comparePackages(map<string, Package*>* ref,
@@ -163,6 +174,13 @@ void Reconfiguration::detectInstances(map<string, Actor*>* actors){
 
         //Couple instances
         for (itRef = refChilds.begin(), itCur = newChilds.begin(); itRef != refChilds.end() && itCur != newChilds.end() ; itRef++, itCur++){
+            // The code of a specialized instance only holds for its parameter values
+            if (SpecializeParams && !sameParameters(*itRef, *itCur)){
+                toRemove.push_back(*itRef);
+                toAdd.push_back(*itCur);
+                continue;
+            }
+
             toKeep.push_back(pair<Instance*, Instance*>(*itRef, *itCur));
         }
 
@@ -179,3 +197,159 @@ void Reconfiguration::detectInstances(map<string, Actor*>* actors){
     }
 
 }
+
+bool Reconfiguration::sameParameters(Instance* ref, Instance* cur){
+    map<string, Expr*>::iterator itRef;
+    map<string, Expr*>* refValues = ref->getParameterValues();
+    map<string, Expr*>* curValues = cur->getParameterValues();
+
+    if (refValues->size() != curValues->size()){
+        return false;
+    }
+
+    for (itRef = refValues->begin(); itRef != refValues->end(); itRef++){
+        map<string, Expr*>::iterator itCur = curValues->find(itRef->first);
+
+        if (itCur == curValues->end()){
+            return false;
+        }
+
+        Expr* refExpr = itRef->second;
+        Expr* curExpr = itCur->second;
+
+        if (refExpr->isIntExpr() && curExpr->isIntExpr()){
+            if (refExpr->evaluateAsInteger() != curExpr->evaluateAsInteger()){
+                return false;
+            }
+        }else if (refExpr->getConstant() != curExpr->getConstant()){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+typedef pair<pair<Instance*, string>, pair<Instance*, string> > Ends;
+
+void Reconfiguration::detectConnections(){
+    map<Instance*, Instance*> kept;
+    list<pair<Instance*, Instance*> >::iterator itKeep;
+
+    for (itKeep = toKeep.begin(); itKeep != toKeep.end(); itKeep++){
+        kept.insert(*itKeep);
+    }
+
+    //Index original connections by their ends in the new configuration
+    map<Ends, Connection*> refEnds;
+    map<Port*, unsigned> refReaders;
+    HDAGGraph* refGraph = refConfiguration->getNetwork()->getGraph();
+
+    for (int i = 0; i < refGraph->getNbEdges(); i++){
+        Connection* connection = (Connection*)refGraph->getEdge(i);
+        Port* src = connection->getSourcePort();
+        Port* dst = connection->getDestinationPort();
+        map<Instance*, Instance*>::iterator itSrc = kept.find(src->getInstance());
+        map<Instance*, Instance*>::iterator itDst = kept.find(dst->getInstance());
+
+        refReaders[src]++;
+
+        if (itSrc == kept.end() || itDst == kept.end()){
+            continue;
+        }
+
+        Ends ends(make_pair(itSrc->second, src->getName()), make_pair(itDst->second, dst->getName()));
+        refEnds.insert(make_pair(ends, connection));
+    }
+
+    //Match the readers of each output port of the new configuration
+    map<Port*, list<pair<Connection*, Connection*> > > matches;
+    set<Port*> changed;
+    HDAGGraph* curGraph = curConfiguration->getNetwork()->getGraph();
+
+    for (int i = 0; i < curGraph->getNbEdges(); i++){
+        Connection* connection = (Connection*)curGraph->getEdge(i);
+        Port* src = connection->getSourcePort();
+        Port* dst = connection->getDestinationPort();
+
+        Ends ends(make_pair(src->getInstance(), src->getName()), make_pair(dst->getInstance(), dst->getName()));
+        map<Ends, Connection*>::iterator itRef = refEnds.find(ends);
+
+        if (itRef == refEnds.end() || itRef->second->getSize() != connection->getSize()){
+            changed.insert(src);
+            continue;
+        }
+
+        matches[src].push_back(make_pair(itRef->second, connection));
+    }
+
+    //Keep the fifo of ports with exactly the same readers
+    set<Connection*> keptRefs;
+    set<Connection*> keptCurs;
+    map<Port*, list<pair<Connection*, Connection*> > >::iterator itMatch;
+
+    for (itMatch = matches.begin(); itMatch != matches.end(); itMatch++){
+        list<pair<Connection*, Connection*> >* pairs = &itMatch->second;
+        Port* refSrc = pairs->front().first->getSourcePort();
+
+        if (changed.find(itMatch->first) != changed.end() || refReaders[refSrc] != pairs->size()){
+            continue;
+        }
+
+        list<pair<Connection*, Connection*> >::iterator itPair;
+        for (itPair = pairs->begin(); itPair != pairs->end(); itPair++){
+            keptRefs.insert(itPair->first);
+            keptCurs.insert(itPair->second);
+            keepConnections.push_back(*itPair);
+        }
+    }
+
+    //Kept instances with a connection added or removed are disturbed
+    for (int i = 0; i < refGraph->getNbEdges(); i++){
+        Connection* connection = (Connection*)refGraph->getEdge(i);
+
+        if (keptRefs.find(connection) == keptRefs.end()){
+            map<Instance*, Instance*>::iterator it;
+
+            it = kept.find(connection->getSourcePort()->getInstance());
+            if (it != kept.end()){
+                disturbed.insert(it->second);
+            }
+
+            it = kept.find(connection->getDestinationPort()->getInstance());
+            if (it != kept.end()){
+                disturbed.insert(it->second);
+            }
+        }
+    }
+
+    for (int i = 0; i < curGraph->getNbEdges(); i++){
+        Connection* connection = (Connection*)curGraph->getEdge(i);
+
+        if (keptCurs.find(connection) == keptCurs.end()){
+            disturbed.insert(connection->getSourcePort()->getInstance());
+            disturbed.insert(connection->getDestinationPort()->getInstance());
+        }
+    }
+
+    //Disturbed instances produce their initial tokens again, fifos of these ports are not
+    //kept and their readers become disturbed in turn
+    bool dropped = true;
+    while (dropped){
+        dropped = false;
+        list<pair<Connection*, Connection*> >::iterator itConn = keepConnections.begin();
+
+        while (itConn != keepConnections.end()){
+            Port* refSrc = itConn->first->getSourcePort();
+            Instance* src = itConn->second->getSourcePort()->getInstance();
+
+            if (!isDisturbed(src) || StaticRegion::getInitialTokens(refSrc) == 0){
+                itConn++;
+                continue;
+            }
+
+            disturbed.insert(itConn->second->getDestinationPort()->getInstance());
+            itConn = keepConnections.erase(itConn);
+            dropped = true;
+        }
+    }
+}
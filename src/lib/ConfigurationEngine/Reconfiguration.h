@@ -39,8 +39,11 @@
 #ifndef RECONFIGURATION_H
 #define RECONFIGURATION_H
 
+#include <set>
+
 #include "lib/ConfigurationEngine/Configuration.h"
 
+class Connection;
 class Decoder;
 //------------------------------
 
@@ -88,6 +91,29 @@ public:
         return &toKeep;
     }
 
+    /**
+     *  @brief Get connections whose fifo is kept in the decoder
+     *
+     *  @return a list of couple of original and new connections
+     *
+     */
+    std::list<std::pair<Connection*, Connection*> >* getConnectionsToKeep(){
+        return &keepConnections;
+    }
+
+    /**
+     *  @brief Check if a kept instance has a connection added or removed
+     *
+     *  An undisturbed instance keeps its state along with the tokens of its fifos.
+     *
+     *  @param instance : the Instance of the new configuration
+     *
+     *  @return true if one of the connections of the instance changes
+     */
+    bool isDisturbed(Instance* instance){
+        return disturbed.find(instance) != disturbed.end();
+    }
+
 private:
 
     /**
@@ -154,6 +180,26 @@ private:
      */
     void detectInstances(std::map<std::string, Actor*>* actors);
 
+    /**
+     *  @brief Detect the connections that can keep their fifo
+     *
+     *  The fifo of an output port of a kept instance is kept when the port has
+     *  the same readers with the same sizes in both configurations, unless the
+     *  instance is initialized again and writes initial tokens on the port.
+     */
+    void detectConnections();
+
+    /**
+     *  @brief Check that two instances have the same parameter values
+     *
+     *  @param ref : the Instance of the reference configuration
+     *
+     *  @param cur : the Instance of the new configuration
+     *
+     *  @return true if all parameters have the same values
+     */
+    bool sameParameters(Instance* ref, Instance* cur);
+
     /** Reference configuration*/
     Configuration* refConfiguration;
 
@@ -170,6 +216,10 @@ private:
     std::list<Instance*> toAdd;
     std::list<std::pair<Instance*, Instance*> > toKeep;
 
+    /** Connections to keep and kept instances with changed connections*/
+    std::list<std::pair<Connection*, Connection*> > keepConnections;
+    std::set<Instance*> disturbed;
+
     /** Display messages */
     bool verbose;
 };
@@ -29,6 +29,9 @@ HDAGEdge::HDAGEdge()
 {
     prevInSinkOrder = NULL;
     nextInSinkOrder = NULL;
+    source = NULL;
+    sink = NULL;
+    base = NULL;
 }
 
 /**
@@ -10,7 +10,7 @@ parallel applications.
  *********************************************************/
 
 /**
- * A HDAG graph. It contains HDAG vertices and edges. It has a bigger table for vertices and edges than DAG.
+ * A HDAG graph. It contains HDAG vertices and edges. The tables of vertices and edges grow on demand.
  * Each edge production and consumption must be equal. There is no repetition vector for the vertices.
  *
  * @author mpelcat
@@ -30,9 +30,7 @@ using namespace std;
 */
 HDAGGraph::HDAGGraph()
 {
-    // There is no dynamic allocation of graph members
-    nbVertices = 0;
-    nbEdges = 0;
+    firstVertex = NULL;
 }
 
 /**
@@ -52,18 +50,9 @@ HDAGGraph::~HDAGGraph()
  @return the created edge
 */
 HDAGEdge* HDAGGraph::addEdge(HDAGVertex* source, int tokenRate, HDAGVertex* sink){
-    HDAGEdge* edge;
-#ifdef _DEBUG
-    if(nbEdges >= MAX_HDAG_EDGES){
-        // Adding an edge while the graph is already full
-        exitWithCode(1001);
-    }
-#endif
-    edge = edges[nbEdges];
-    edge->setSource(source);
+    HDAGEdge* edge = new HDAGEdge();
+    addEdge(source, sink, edge);
     edge->setTokenRate(tokenRate);
-    edge->setSink(sink);
-    nbEdges++;
     return edge;
 }
 
@@ -77,17 +66,12 @@ HDAGEdge* HDAGGraph::addEdge(HDAGVertex* source, int tokenRate, HDAGVertex* sink
  @return the created edge
 */
 void HDAGGraph::addEdge(HDAGVertex* source, HDAGVertex* sink, HDAGEdge* edge){
-#ifdef _DEBUG
-    if(nbEdges >= MAX_HDAG_EDGES){
-        // Adding an edge while the graph is already full
-        exitWithCode(1001);
-    }
-#endif
     edge->setSource(source);
     edge->setTokenRate(0);
     edge->setSink(sink);
-    edges[nbEdges] = edge;
-    nbEdges++;
+    edge->setBase(this);
+    edgeIndexes[edge] = edges.size();
+    edges.push_back(edge);
 }
 
 
@@ -95,8 +79,11 @@ void HDAGGraph::addEdge(HDAGVertex* source, HDAGVertex* sink, HDAGEdge* edge){
  Removes the last added edge
 */
 void HDAGGraph::removeLastEdge(){
-    if(nbEdges > 0){
-        nbEdges--;
+    if(!edges.empty()){
+        HDAGEdge* edge = edges.back();
+        edge->setBase(NULL);
+        edgeIndexes.erase(edge);
+        edges.pop_back();
     }
     else{
         // Removing an edge from an empty graph
@@ -105,24 +92,29 @@ void HDAGGraph::removeLastEdge(){
 }
 
 bool HDAGGraph::removeVertex(HDAGVertex* vertex){
-    int i = 0;
+    map<HDAGVertex*, int>::iterator it = vertexIndexes.find(vertex);
 
-    for(;i<nbVertices; i++){
-        HDAGVertex* currentVertex = vertices[i];
+    if (it == vertexIndexes.end()){
+        //Vertex has not been found
+        return false;
+    }
 
-        if (currentVertex->equals(vertex)){
-            delete vertices[i];
-            break;
-        }
+    // Fill the current position with the last vertex
+    int i = it->second;
+    vertexIndexes.erase(it);
+    HDAGVertex* last = vertices.back();
+    vertices.pop_back();
+
+    if (last != vertex){
+        vertices[i] = last;
+        vertexIndexes[last] = i;
     }
 
-    if ( i == nbVertices - 1){
-        //Vertex has not been found
-        return false;
+    if (firstVertex == vertex){
+        firstVertex = NULL;
     }
 
-    // Fill the current position with the last edge
-    vertices[i] = vertices[--nbVertices];
+    delete vertex;
 
     return true;
 }
@@ -133,7 +125,7 @@ bool HDAGGraph::removeVertex(HDAGVertex* vertex){
 bool HDAGGraph::removeAllEdges(HDAGEdge** edges, int nbRemEdges){
     bool graphChanged = false;
 
-    for(int i=0; i<nbEdges; i++){
+    for(int i=0; i<nbRemEdges; i++){
         graphChanged |= removeEdge(edges[i]);
     }
 
@@ -148,42 +140,47 @@ bool HDAGGraph::removeAllEdges(HDAGEdge** edges, int nbRemEdges){
  Refresh edges of the graph. This method MUST be called when edge are changed in the graph.
 */
 void HDAGGraph::refreshEdges(){
-    int newNbEdges = 0;
+    unsigned int newNbEdges = 0;
 
-    for(int i=0; i<nbEdges; i++){
+    for(unsigned int i=0; i<edges.size(); i++){
         if (edges[i] != NULL){
             if(newNbEdges != i){
                 edges[newNbEdges]= edges[i];
+                edgeIndexes[edges[i]] = newNbEdges;
                 edges[i] = NULL;
             }
             newNbEdges++;
         }
     }
 
-    nbEdges = newNbEdges;
+    edges.resize(newNbEdges);
 }
 
 /**
  Removes an edge in the graph.
 */
 bool HDAGGraph::removeEdge(HDAGEdge* edge){
-    int i = 0;
-    for(; i<nbEdges; i++){
-        if (edge == edges[i]){
-            // Edge found
-            break;
-        }
-    }
+    map<HDAGEdge*, int>::iterator it = edgeIndexes.find(edge);
 
-    if ( i == nbEdges - 1){
+    if (it == edgeIndexes.end()){
         //Edge has not been found
         return false;
     }
 
     // Fill the current position with the last edge
-    edges[i] = edges[--nbEdges];
+    int i = it->second;
+    edgeIndexes.erase(it);
+    HDAGEdge* last = edges.back();
+    edges.pop_back();
+
+    if (last != edge){
+        edges[i] = last;
+        edgeIndexes[last] = i;
+    }
+
+    // Unregister the edge from its vertices
+    edge->setBase(NULL);
 
-    // edge not found
     return true;
 }
 
@@ -193,14 +190,20 @@ bool HDAGGraph::removeEdge(HDAGEdge* edge){
 list<HDAGEdge*>* HDAGGraph::getAllEdges(HDAGVertex* sourceVertex, HDAGVertex* targetVertex){
     edgesContainer.clear();
 
-    for(int i=0; i<nbEdges; i++){
-        HDAGEdge* curEgde = edges[i];
+    if (sourceVertex == NULL || targetVertex == NULL){
+        // Vertices are not in the graph
+        return &edgesContainer;
+    }
 
-        if (getEdgeSource(curEgde)->equals(sourceVertex)){
-            if (getEdgeTarget(curEgde)->equals(targetVertex)){
-                // Store current edge
-                edgesContainer.push_back(curEgde);
-            }
+    vector<HDAGEdge*>* outputs = sourceVertex->getOutputEdges();
+
+    for(unsigned int i=0; i<outputs->size(); i++){
+        HDAGEdge* curEgde = (*outputs)[i];
+        HDAGVertex* target = curEgde->getSink();
+
+        if (target != NULL && target->equals(targetVertex)){
+            // Store current edge
+            edgesContainer.push_back(curEgde);
         }
     }
 
@@ -209,31 +212,21 @@ list<HDAGEdge*>* HDAGGraph::getAllEdges(HDAGVertex* sourceVertex, HDAGVertex* ta
 }
 
 HDAGVertex* HDAGGraph::getEdgeTarget(HDAGEdge* edge){
-    if (edge->getSink() == NULL)
-        return NULL;
+    HDAGVertex* sink = edge->getSink();
 
-    for(int i=0; i<nbVertices; i++){
-        HDAGVertex* currentVertex = vertices[i];
-        if(edge->getSink()->equals(currentVertex)){
-            return currentVertex;
-        }
-    }
+    if (sink == NULL || getVertexIndex(sink) == -1)
+        return NULL;
 
-    return NULL;
+    return sink;
 }
 
 HDAGVertex* HDAGGraph::getEdgeSource(HDAGEdge* edge){
-    if (edge->getSource() == NULL)
-        return NULL;
+    HDAGVertex* source = edge->getSource();
 
-    for(int i=0; i<nbVertices; i++){
-        HDAGVertex* currentVertex = vertices[i];
-        if(edge->getSource()->equals(currentVertex)){
-            return currentVertex;
-        }
-    }
+    if (source == NULL || getVertexIndex(source) == -1)
+        return NULL;
 
-    return NULL;
+    return source;
 }
 
 
@@ -241,7 +234,15 @@ HDAGVertex* HDAGGraph::getEdgeSource(HDAGEdge* edge){
  Removes all edges and vertices
 */
 void HDAGGraph::flush(){
-    nbVertices = nbEdges = 0;
+    for(unsigned int i=0; i<edges.size(); i++){
+        edges[i]->setBase(NULL);
+    }
+
+    vertices.clear();
+    vertexIndexes.clear();
+    edges.clear();
+    edgeIndexes.clear();
+    firstVertex = NULL;
     HDAGEdge::firstInSinkOrder = NULL;
 }
 
@@ -303,7 +304,7 @@ void HDAGGraph::sortEdges(int startIndex){
     HDAGEdge* currentNewEdge, *currentOldEdge;
     HDAGVertex* currentNewSink;
 
-    for(int i=startIndex; i<nbEdges; i++){
+    for(unsigned int i=startIndex; i<edges.size(); i++){
         currentNewEdge = edges[i];
 
         // Adding the first edge
@@ -358,7 +359,7 @@ void HDAGGraph::sortEdges(int startIndex){
  Precomputes the successor vertices of all vertices to speed up the access
 */
 void HDAGGraph::precomputeSuccessors(){
-    for(int i=0; i<nbVertices; i++){
+    for(unsigned int i=0; i<vertices.size(); i++){
         HDAGVertex* currentVertex = vertices[i];
         currentVertex->flushSuccessors();
         precomputeSuccessors(currentVertex);
@@ -372,9 +373,10 @@ void HDAGGraph::precomputeSuccessors(){
 */
 void HDAGGraph::precomputeSuccessors(HDAGVertex* vertex){
     // Retrieving all edges having vertex for source
-    for(int i=0; i<nbEdges; i++){
-        HDAGEdge* currentEdge = edges[i];
-        if(currentEdge->getSource()->equals(vertex)){
+    vector<HDAGEdge*>* outputs = vertex->getOutputEdges();
+    for(unsigned int i=0; i<outputs->size(); i++){
+        HDAGEdge* currentEdge = (*outputs)[i];
+        if(currentEdge->getSink() != NULL){
             vertex->addSuccessor(currentEdge->getSink());
         }
     }
@@ -18,7 +18,6 @@ parallel applications.
 */
 HDAGVertex::HDAGVertex()
 {
-    nbSuccessors = 0;
 }
 
 /**
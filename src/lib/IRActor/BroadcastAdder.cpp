@@ -38,6 +38,7 @@
 //------------------------------
 #include <map>
 #include <sstream>
+#include <vector>
 
 #include "lib/RVCEngine/Decoder.h"
 #include "lib/IRActor/BroadcastActor.h"
@@ -69,13 +70,12 @@ struct ltstr
 };
 
 
-//maximum number of edge that can be connected to a vertex
-#define MAX_EDGE 500
-
 void BroadcastAdder::examineVertex(Vertex* vertex){
-    Connection* connections[MAX_EDGE];
+    // Copy the output edges as the broadcasts added below connect to this vertex
+    vector<HDAGEdge*> edges(*vertex->getOutputEdges());
+    Connection** connections = edges.empty() ? NULL : (Connection**)&edges[0];
 
-    int nbEdges = graph->getOutputEdges(vertex, (HDAGEdge**)connections);
+    int nbEdges = edges.size();
     map<Port*, list<Connection*>*, ltstr>* outMap = new map<Port*, list<Connection*>*, ltstr>();
     map<Port*, list<Connection*>*, ltstr>::iterator it;
     list<Connection*>* outList = NULL;
@@ -130,6 +130,7 @@ void BroadcastAdder::examineConnections(Vertex* vertex, Connection** connections
 
                 //Set a new vertex in the graph
                 Vertex* vertextBCast = new Vertex(newInstance);
+                newInstance->setVertex(vertextBCast);
                 graph->addVertex(vertextBCast);
 
                 //Connect the broadcast vertex in the graph
@@ -42,6 +42,7 @@
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MathExtras.h"
 
 #include "lib/IRCore/Network/Connection.h"
 #include "lib/IRCore/Expression.h"
@@ -54,6 +55,9 @@ using namespace std;
 using namespace llvm;
 
 extern cl::opt<int> FifoSize;
+cl::opt<bool> FifoPowerOfTwo("fifo-pow2",
+                             cl::desc("Round fifo sizes up to a power of two so that tokens are indexed with a mask"),
+                             cl::init(true));
 
 Connection::Connection(HDAGGraph* graph, Vertex* source, Port* srcPort, Vertex* target, Port* tgtPort, std::map<std::string, IRAttribute*>* attributes): HDAGEdge()
 {   
@@ -62,6 +66,7 @@ Connection::Connection(HDAGGraph* graph, Vertex* source, Port* srcPort, Vertex*
     this->srcPort = srcPort;
     this->tgtPort = tgtPort;
     this->fifo = NULL;
+    this->computedSize = 0;
     this->source = source;
     this->target = target;
 
@@ -80,18 +85,24 @@ Connection::Connection(HDAGGraph* graph, Vertex* source, Port* srcPort, Vertex*
 
 int Connection::getSize(){
     IRAttribute* attribute = getAttribute("bufferSize");
+    int size = computedSize > 0 ? computedSize : (int)FifoSize;
 
-    if (attribute == NULL){
-        return FifoSize;
-    }
+    if (attribute != NULL){
+        if (!attribute->isValue()){
+            cerr<< "Error when parsing type of a connection";
+            exit(0);
+        }
 
-    if (attribute->isValue()){
         Expr* expr = ((ValueAttribute*)attribute)->getValue();
-        return expr->evaluateAsInteger();
+        size = expr->evaluateAsInteger();
+    }
+
+    // Free-running indexes also stay consistent when they overflow
+    if (FifoPowerOfTwo && size > 0 && !isPowerOf2_32(size)){
+        size = NextPowerOf2(size);
     }
 
-    cerr<< "Error when parsing type of a connection";
-    exit(0);
+    return size;
 }
 
 IRAttribute* Connection::getAttribute(std::string name){
@@ -115,9 +126,11 @@ void Connection::unsetFifo(){
     srcVar->setInitializer(NULL);
     dstVar->setInitializer(NULL);
 
-    //Delete the fifo
+    //Delete the fifo once all its readers are disconnected
     if (fifo != NULL){
-        delete fifo;
+        if (fifo->release() == 0){
+            delete fifo;
+        }
         fifo = NULL;
     }
 }
@@ -83,6 +83,7 @@ Instance::Instance(std::string id, Actor* actor)  : Entity(new map<std::string,
     this->arguments = new map<string, Expr*>();
     this->attributes = new map<string, IRAttribute*>();
     this->enableTrace = false;
+    this->vertex = NULL;
 
     if (actor != NULL){
         actor->addInstance(this);
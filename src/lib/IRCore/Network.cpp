@@ -43,8 +43,6 @@
 
 using namespace std;
 
-#define MAX_CONNECTION 100
-
 Network::~Network(){
     delete graph;
     delete inputs;
@@ -83,13 +81,14 @@ void Network::computeSuccessorsMaps(){
 
 list<Instance*> Network::getSuccessorsOf(Instance* instance){
     Vertex* vertex = getVertex(instance);
-    int nbSucc = vertex->nbSuccessors;
+    HDAGVertex** succs;
+    int nbSucc = vertex->getSuccessors(&succs);
 
     // Add all successor in list
     list<Instance*> successors;
 
     for (int i = 0; i < nbSucc; i++){
-        Vertex* succ = (Vertex*)vertex->successors[i];
+        Vertex* succ = (Vertex*)succs[i];
         if (succ->isInstance()){
             successors.push_back(succ->getInstance());
         }
@@ -101,30 +100,31 @@ list<Instance*> Network::getSuccessorsOf(Instance* instance){
 }
 
 Vertex* Network::getVertex(Instance* instance){
-    int nbVertex = graph->getNbVertices();
+    Vertex* vertex = instance->getVertex();
 
-    for (int i = 0; i < nbVertex; i++){
-        Vertex* vertex = (Vertex*)graph->getVertex(i);
-        if (vertex->isInstance()){
-            if (vertex->getInstance() == instance){
-                // Vertex has been found
-                return vertex;
-            }
-        }
+    if (vertex == NULL || graph->getVertexIndex(vertex) == -1){
+        // No vertex found
+        return NULL;
     }
 
-    // No vertex found
-    return NULL;
+    return vertex;
 }
 
 bool Network::removeInstance(Instance* instance){
     instances.remove(instance);
     Vertex* vertex = getVertex(instance);
+
+    if (vertex == NULL){
+        return false;
+    }
+
+    instance->setVertex(NULL);
     return graph->removeVertex(vertex);
 }
 
 Vertex* Network::addInstance(Instance* instance){
     Vertex* vertex = new Vertex(instance);
+    instance->setVertex(vertex);
     instances.push_back(instance);
     graph->addVertex(vertex);
 
@@ -148,18 +148,24 @@ list<Connection*>* Network::getConnections(){
 }
 
 list<Connection*>* Network::getAllConnections(Instance* source, Instance* target){  
-    return (list<Connection*>*)graph->getAllEdges(new Vertex(source), new Vertex(target));
+    // Vertices of instances outside of the network are NULL, no edge is found
+    return (list<Connection*>*)graph->getAllEdges(getVertex(source), getVertex(target));
 }
 
 list<Connection*> Network::getInConnections(Instance* instance){
     list<Connection*> ins;
-    HDAGEdge* inEdges[MAX_CONNECTION];
+    Vertex* vertex = getVertex(instance);
+
+    if (vertex == NULL){
+        // Instance is not in the network
+        return ins;
+    }
 
-    int nbEdges = graph->getInputEdges(new Vertex(instance), inEdges);
+    vector<HDAGEdge*>* inEdges = vertex->getInputEdges();
 
     // Insert edge found in result
-    for (int i = 0; i < nbEdges; i++){
-        ins.push_back((Connection*)inEdges[i]);
+    for (unsigned int i = 0; i < inEdges->size(); i++){
+        ins.push_back((Connection*)(*inEdges)[i]);
     }
 
     return ins;
@@ -167,14 +173,18 @@ list<Connection*> Network::getInConnections(Instance* instance){
 
 list<Connection*> Network::getOutConnections(Instance* instance){
     list<Connection*> outs;
+    Vertex* vertex = getVertex(instance);
 
-    HDAGEdge* outEdges[MAX_CONNECTION];
+    if (vertex == NULL){
+        // Instance is not in the network
+        return outs;
+    }
 
-    int nbEdges = graph->getOutputEdges(new Vertex(instance), outEdges);
+    vector<HDAGEdge*>* outEdges = vertex->getOutputEdges();
 
     // Insert edge found in result
-    for (int i = 0; i < nbEdges; i++){
-        outs.push_back((Connection*)outEdges[i]);
+    for (unsigned int i = 0; i < outEdges->size(); i++){
+        outs.push_back((Connection*)(*outEdges)[i]);
     }
 
     return outs;
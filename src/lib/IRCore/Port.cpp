@@ -47,7 +47,20 @@ int Port::getFifoSize(){
         return 0;
     }
 
-    return connections.front()->getSize();
+    // Readers use the fifo of the source port
+    Port* source = connections.front()->getSourcePort();
+    list<Connection*>* outs = source->getConnections();
+    list<Connection*>::iterator it;
+    int size = 0;
+
+    for (it = outs->begin(); it != outs->end(); it++){
+        int connectionSize = (*it)->getSize();
+        if (connectionSize > size){
+            size = connectionSize;
+        }
+    }
+
+    return size;
 }
 
 void Port::setAccess(bool read, bool write){
@@ -42,6 +42,7 @@
 
 
 #include "lib/IRJit/LLVMArmFix.h"
+#include "lib/IRJit/LLVMOptimizer.h"
 #include "lib/IRUtil/FunctionMng.h"
 
 #include "llvm/IR/LLVMContext.h"
@@ -68,9 +69,8 @@ using namespace llvm;
 using namespace std;
 
 extern cl::opt<std::string> MArch;
-extern cl::list<std::string> MAttrs;
-extern cl::opt<std::string> MCPU;
 extern cl::opt<std::string> VidFile;
+extern cl::list<std::string> NativeLink;
 extern cl::opt<llvm::FloatABI::ABIType> UserDefinedFloatABI;
 
 extern char **environnement;
@@ -79,6 +79,10 @@ LLVMArmFix::LLVMArmFix(LLVMContext& C, Decoder* decoder, bool verbose): LLVMExec
 
 }
 
+LLVMArmFix::~LLVMArmFix(){
+
+}
+
 void LLVMArmFix::run() {
     // Intermediate files to generate
     string AssemblyFile("tmpAssembly.s");
@@ -106,7 +110,7 @@ void LLVMArmFix::run() {
     Constant* inputChr = FunctionMng::createStdMessage(module, VidFile);
     new StoreInst(inputChr, inputFileVar, callInst);
 
-    generateNativeCode(AssemblyFile);
+    generateNativeCode(AssemblyFile, module);
 
     // Mark the output files for removal.
     sys::RemoveFileOnSignal(AssemblyFile);
@@ -170,7 +174,7 @@ void LLVMArmFix::RemoveEnv(const char * name, char ** const envp) {
     return;
 }
 
-void LLVMArmFix::compileAndLink(string IntermediateAssemblyFile, string IntermediateDecoderFile) {
+int LLVMArmFix::compileAndLink(string IntermediateAssemblyFile, string IntermediateDecoderFile, bool shared) {
     string ErrMsg;
     string gcc = sys::FindProgramByName("gcc");
 
@@ -202,9 +206,17 @@ void LLVMArmFix::compileAndLink(string IntermediateAssemblyFile, string Intermed
     args.push_back(IntermediateDecoderFile.c_str());
     args.push_back(IntermediateAssemblyFile.c_str());
 
-    args.push_back("-lorcc");
-    args.push_back("-lSDL");
-    args.push_back("-lSDLmain");
+    if (shared) {
+        // Natives are resolved in the process loading the library
+        args.push_back("-shared");
+    } else if (NativeLink.empty()) {
+        args.push_back("-lorcc");
+        args.push_back("-lSDL");
+        args.push_back("-lSDLmain");
+    } else {
+        args.push_back("-lorcc");
+        args.insert(args.end(), NativeLink.begin(), NativeLink.end());
+    }
 
 
     // Now that "args" owns all the std::strings for the arguments, call the c_str
@@ -221,8 +233,14 @@ void LLVMArmFix::compileAndLink(string IntermediateAssemblyFile, string Intermed
     }
 
     // Run the compiler to assembly and link together the program.
-    sys::ExecuteAndWait(gcc, &Args[0], const_cast<const char **>(clean_env), 0, 0, 0, &ErrMsg);
+    int result = sys::ExecuteAndWait(gcc, &Args[0], const_cast<const char **>(clean_env), 0, 0, 0, &ErrMsg);
     delete [] clean_env;
+
+    if (result != 0) {
+        errs() << "Linking with Gcc failed: " << ErrMsg << "\n";
+    }
+
+    return result;
 }
 
 void LLVMArmFix::PrintCommand(const std::vector<const char*> &args) {
@@ -233,9 +251,7 @@ void LLVMArmFix::PrintCommand(const std::vector<const char*> &args) {
     errs() << "\n";
 }
 
-tool_output_file* LLVMArmFix::generateNativeCode(string IntermediateAssemblyFile) {
-    Module* module = decoder->getModule();
-
+tool_output_file* LLVMArmFix::generateNativeCode(string IntermediateAssemblyFile, Module* module, bool pic) {
     Triple targetTriple(module->getTargetTriple());
 
     if (targetTriple.getTriple().empty())
@@ -277,10 +293,11 @@ tool_output_file* LLVMArmFix::generateNativeCode(string IntermediateAssemblyFile
 
     // Package up features to be passed to target/subtarget
     std::string FeaturesStr;
-    if (MAttrs.size()) {
+    std::vector<std::string> features = LLVMOptimizer::getFeatures();
+    if (features.size()) {
         SubtargetFeatures Features;
-        for (unsigned i = 0; i != MAttrs.size(); ++i)
-            Features.AddFeature(MAttrs[i]);
+        for (unsigned i = 0; i != features.size(); ++i)
+            Features.AddFeature(features[i]);
         FeaturesStr = Features.getString();
     }
 
@@ -288,8 +305,8 @@ tool_output_file* LLVMArmFix::generateNativeCode(string IntermediateAssemblyFile
     options.FloatABIType = UserDefinedFloatABI;
     std::auto_ptr<TargetMachine>
             target(TheTarget->createTargetMachine(targetTriple.getTriple(),
-                                                  MCPU, FeaturesStr,
-                                                  options));
+                                                  LLVMOptimizer::getCPU(), FeaturesStr,
+                                                  options, pic ? Reloc::PIC_ : Reloc::Default));
     assert(target.get() && "Could not allocate target machine!");
     TargetMachine &Target = *target.get();
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class LLVMCodeSize
+@author agent
+@file LLVMCodeSize.cpp
+@version 1.0
+@date 18/10/2026
+*/
+
+//------------------------------
+#include "llvm/ExecutionEngine/ObjectImage.h"
+
+#include "lib/IRJit/LLVMCodeSize.h"
+//------------------------------
+
+using namespace llvm;
+using namespace std;
+
+void LLVMCodeSize::NotifyFunctionEmitted(const Function &F, void *Code, size_t Size,
+                                         const EmittedFunctionDetails &Details){
+    functions[Code] = Size;
+    size += Size;
+}
+
+void LLVMCodeSize::NotifyFreeingMachineCode(void *OldPtr){
+    map<void*, size_t>::iterator it = functions.find(OldPtr);
+
+    if (it != functions.end()){
+        size -= it->second;
+        functions.erase(it);
+    }
+}
+
+void LLVMCodeSize::NotifyObjectEmitted(const ObjectImage &Obj){
+    size += Obj.getData().size();
+}
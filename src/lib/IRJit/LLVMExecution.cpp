@@ -36,6 +36,7 @@
 */
 
 //------------------------------
+#include <atomic>
 #include <iostream>
 #include <errno.h>
 #include <time.h>
@@ -43,6 +44,7 @@
 #include "NativeDecl.h"
 
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
@@ -62,6 +64,11 @@
 #include "lib/IRCore/Actor/Procedure.h"
 #include "lib/RoundRobinScheduler/Fifo.h"
 #include "lib/IRJit//LLVMExecution.h"
+#include "lib/IRJit/LLVMTieredCompiler.h"
+#include "lib/IRJit/LLVMCodeSize.h"
+#include "lib/IRJit/LLVMObjectCache.h"
+#include "lib/IRJit/LLVMOptimizer.h"
+#include "lib/IRJit/LLVMSymbolMap.h"
 //------------------------------
 
 using namespace llvm;
@@ -72,13 +79,25 @@ extern cl::opt<bool> ForceInterpreter;
 extern cl::opt<std::string> MArch;
 extern cl::opt<bool> DisableCoreFiles;
 extern cl::opt<bool> NoLazyCompilation;
-extern cl::list<std::string> MAttrs;
-extern cl::opt<std::string> MCPU;
 extern cl::opt<std::string> TargetTriple;
 cl::opt<bool> UseMCJIT(
         "use-mcjit", cl::desc("Enable use of the MC-based JIT (if available)"),
         cl::init(false));
 extern cl::opt<llvm::FloatABI::ABIType> UserDefinedFloatABI;
+extern cl::opt<std::string> CacheDir;
+extern cl::opt<bool> HotReconfigure;
+extern cl::opt<int> DecoderPool;
+extern cl::opt<std::string> SchedulerCounters;
+extern cl::opt<std::string> FifoProfileOut;
+
+cl::opt<char> JitOptLevel("jit-opt-level",
+                          cl::desc("Code generation optimization level of the JIT: 0, 1, 2 or 3"),
+                          cl::value_desc("level"),
+                          cl::init('2'));
+
+cl::opt<bool> TieredJit("tiered-jit",
+                        cl::desc("Start from unoptimized code and recompile the hot instances in background"),
+                        cl::init(false));
 
 //===----------------------------------------------------------------------===//
 // main Driver function
@@ -89,6 +108,15 @@ LLVMExecution::LLVMExecution(LLVMContext& C, Decoder* decoder, bool verbose): Co
     this->decoder = decoder;
     this->verbose = verbose;
     this->stopVal = 0;
+    this->stopped = false;
+    this->pausing = false;
+    this->paused = false;
+    this->tiering = NULL;
+    this->cache = NULL;
+    this->symbols = NULL;
+    this->mcjit = (UseMCJIT || !CacheDir.empty()) && !ForceInterpreter;
+    this->codeSize = new LLVMCodeSize();
+    this->nativeContext = orcc_context_create();
 
     Module* module = decoder->getModule();
 
@@ -105,10 +133,32 @@ LLVMExecution::LLVMExecution(LLVMContext& C, Decoder* decoder, bool verbose): Co
         }
     }
 
+    // Globals of the decoder are only reached and functions only relinked by the legacy JIT
+    if (mcjit){
+        const char* legacyOpt = NULL;
+        if (TieredJit){
+            legacyOpt = "-tiered-jit";
+        }else if (HotReconfigure){
+            legacyOpt = "-hot-reconfiguration";
+        }else if (DecoderPool > 0){
+            legacyOpt = "-decoder-pool";
+        }else if (SchedulerCounters.getNumOccurrences() > 0){
+            legacyOpt = "-sched-counters";
+        }else if (!FifoProfileOut.empty()){
+            legacyOpt = "-fifo-profile-out";
+        }
+
+        if (legacyOpt != NULL){
+            cerr << "Error: " << legacyOpt << " can't be used with -use-mcjit or -cache-dir." << endl;
+            exit(1);
+        }
+    }
+
     EngineBuilder builder(module);
     builder.setMArch(StringRef(MArch));
-    builder.setMCPU(StringRef(MCPU));
-    builder.setMAttrs(MAttrs);
+    // Code is generated for the features of the host unless the cpu is given
+    builder.setMCPU(LLVMOptimizer::getCPU());
+    builder.setMAttrs(LLVMOptimizer::getFeatures());
     builder.setErrorStr(&ErrorMsg);
     builder.setEngineKind(ForceInterpreter
                           ? EngineKind::Interpreter
@@ -123,15 +173,22 @@ LLVMExecution::LLVMExecution(LLVMContext& C, Decoder* decoder, bool verbose): Co
     if (!TargetTriple.empty())
         module->setTargetTriple(Triple::normalize(TargetTriple));
 
-    // Enable MCJIT, if desired.
-    if (UseMCJIT)
+    // Enable MCJIT, if desired. Cached objects are loaded by MCJIT only
+    if (mcjit){
+        symbols = new LLVMSymbolMap();
         builder.setUseMCJIT(true);
+        builder.setMCJITMemoryManager(symbols);
+
+        if (!CacheDir.empty()){
+            cache = new LLVMObjectCache(CacheDir, module, verbose);
+        }
+    }
 
-    //TODO : select optimization level
-    char OptLevel = '2';
+    char OptLevel = JitOptLevel;
     CodeGenOpt::Level OLvl = CodeGenOpt::Default;
     switch (OptLevel) {
     default:
+        cerr << "Invalid JIT optimization level: " << OptLevel << endl;
         exit (1);
     case ' ': break;
     case '0': OLvl = CodeGenOpt::None; break;
@@ -151,10 +208,20 @@ LLVMExecution::LLVMExecution(LLVMContext& C, Decoder* decoder, bool verbose): Co
     }
 
     //Set properties of the EE
+    if (cache != NULL){
+        EE->setObjectCache(cache);
+    }
+
     EE->RegisterJITEventListener(JITEventListener::createOProfileJITEventListener());
+    EE->RegisterJITEventListener(codeSize);
 
     EE->DisableLazyCompilation(NoLazyCompilation);
 
+    // Hot instances are recompiled while the decoder is running
+    if (TieredJit && !ForceInterpreter){
+        tiering = new LLVMTieredCompiler(EE, decoder, &stopVal, verbose);
+    }
+
     // If the program doesn't explicitly call exit, we will need the Exit
     // function later on to make an explicit call, so get the function now.
     Exit = (Function*) module->getOrInsertFunction("exit", Type::getVoidTy(Context),
@@ -170,11 +237,20 @@ void LLVMExecution::mapProcedure(Procedure* procedure, void *Addr) {
     Function* function = procedure->getFunction();
 
     if (EE->getPointerToGlobalIfAvailable(function) == NULL){
-        EE->addGlobalMapping(function, Addr);
+        mapGlobal(function, Addr);
     }
 }
 
 
+void LLVMExecution::mapGlobal(GlobalValue* gv, void* addr){
+    EE->addGlobalMapping(gv, addr);
+
+    // MCJIT links the declarations by name
+    if (symbols != NULL){
+        symbols->map(gv->getName(), addr);
+    }
+}
+
 bool LLVMExecution::mapFifo(Port* port, Fifo* fifo) {
     void **portGV = (void**)EE->getPointerToGlobalIfAvailable(port->getFifoVar());
 
@@ -213,12 +289,25 @@ void LLVMExecution::linkExternalProc(list<Procedure*> externs){
         // time the decoder is reconfigured
         if( !EE->getPointerToGlobalIfAvailable((*it)->getFunction())) {
             // Link native procedures
-            EE->addGlobalMapping((*it)->getFunction(), itNative->second);
+            mapGlobal((*it)->getFunction(), itNative->second);
         }
     }
 
 }
 
+string LLVMExecution::getNativeSymbol(Procedure* procedure){
+    string name = procedure->getName();
+
+    if (nativeMap.find(name) == nativeMap.end()){
+        cerr << "Unknown native function: " << name << endl;
+        exit(1);
+    }
+
+    map<string, string>::iterator it = nativeNames.find(name);
+
+    return it != nativeNames.end() ? it->second : name;
+}
+
 void LLVMExecution::launchPartitions(map<Partition*, Scheduler*>* parts) {
     // Get scheduler's partition
     map<Partition*, Scheduler*>::iterator it;
@@ -232,13 +321,18 @@ void LLVMExecution::launchPartitions(map<Partition*, Scheduler*>* parts) {
         procThread* th = new procThread;
         th->EE = EE;
         th->func = sched->getMainFunction();
+        th->context = nativeContext;
 
         pthread_create( thread, NULL, &LLVMExecution::threadProc, th);
     }
 }
 
 void LLVMExecution::run() {
-    stopVal = 0;
+    clearStop();
+    stopped = false;
+    pausing = false;
+    paused.store(false, memory_order_release);
+    bindContext();
 
     if (decoder->hasPartitions()){
         // Start partitions
@@ -250,7 +344,40 @@ void LLVMExecution::run() {
     Function* func = dyn_cast<Function>(scheduler->getMainFunction());
 
     // Run main scheduler
+    if (tiering != NULL){
+        tiering->start();
+    }
+
     EE->runFunction(func, vector<GenericValue>());
+
+    // The main scheduler returns at a safe point when hot code has to be relinked
+    // or when the decoder is asked to pause
+    while (!stopped && !orcc_context_is_stopped(nativeContext)){
+        bool relinked = tiering != NULL && tiering->relink();
+
+        if (!relinked){
+            if (!pausing){
+                break;
+            }
+
+            pausing = false;
+
+            if (decoder->isQuiescent()){
+                paused.store(true, memory_order_release);
+                break;
+            }
+        }
+
+        if (!resume()){
+            break;
+        }
+
+        EE->runFunction(func, vector<GenericValue>());
+    }
+
+    if (tiering != NULL){
+        tiering->stop();
+    }
 }
 
 void* LLVMExecution::threadProc( void* args ){
@@ -258,6 +385,9 @@ void* LLVMExecution::threadProc( void* args ){
     Function* f = th->func;
     ExecutionEngine* E = th->EE;
 
+    // Natives called by the partition belong to its decoder
+    orcc_context_bind(th->context);
+
     std::vector<GenericValue> noargs;
     E->runFunction(f, noargs);
 
@@ -277,7 +407,7 @@ int* LLVMExecution::initialize(){
 
     GlobalVariable* stopGV = scheduler->getStopGV();
     if(!EE->getPointerToGlobalIfAvailable(stopGV))
-        EE->addGlobalMapping(stopGV, &stopVal);
+        mapGlobal(stopGV, &stopVal);
 
     if (decoder->hasPartitions()){
         // Get scheduler's partition
@@ -290,7 +420,7 @@ int* LLVMExecution::initialize(){
 
             GlobalVariable* stopGVpart = sched->getStopGV();
             if(!EE->getPointerToGlobalIfAvailable(stopGVpart))
-                EE->addGlobalMapping(stopGVpart, &test);
+                mapGlobal(stopGVpart, &test);
         }
     }
 
@@ -307,24 +437,77 @@ int* LLVMExecution::initialize(){
         cout << "--> No lazy compilation enable, the decoder has been compiled in : "<< (clock () - timer) * 1000 / CLOCKS_PER_SEC << " ms" << endl;
     }
 
+    // Natives stop the scheduler of the decoder that calls them
+    orcc_context_set_stop(nativeContext, &stopVal);
+    bindContext();
+
     // Initialize the network
     Function* init = dyn_cast<Function>(scheduler->getInitFunction());
     std::vector<GenericValue> noargs;
     EE->runFunction(init, noargs);
 
-    // Return and set stop variable
-    stopVar = &stopVal;
+    // Return stop variable
     return &stopVal;
 }
 
+void LLVMExecution::setInputFile(std::string file){
+    inputFile = file;
+    orcc_context_set_input(nativeContext, inputFile.empty() ? NULL : (char*)inputFile.c_str());
+}
+
+void LLVMExecution::bindContext(){
+    orcc_context_bind(nativeContext);
+}
+
+void LLVMExecution::clearStop(){
+    stopVal = 0;
+    orcc_context_set_stop(nativeContext, &stopVal);
+}
+
+bool LLVMExecution::resume(){
+    stopVal = 0;
+
+    // A stop requested before the variable was cleared must not be lost
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (stopped || orcc_context_is_stopped(nativeContext)){
+        stopVal = 1;
+        return false;
+    }
+
+    return true;
+}
+
 void LLVMExecution::runFunction(Function* function) {
     std::vector<GenericValue> noargs;
     GenericValue Result = EE->runFunction(function, noargs);
 }
 
+void LLVMExecution::compile() {
+    Module* module = decoder->getModule();
+
+    linkExternalProc(decoder->getExternalProcs());
+
+    GlobalVariable* stopGV = decoder->getScheduler()->getStopGV();
+    if(!EE->getPointerToGlobalIfAvailable(stopGV))
+        mapGlobal(stopGV, &stopVal);
+
+    for (Module::iterator I = module->begin(), E = module->end(); I != E; ++I) {
+        Function *Fn = &*I;
+        if (!Fn->isDeclaration())
+            EE->getPointerToFunction(Fn);
+    }
+}
+
+void LLVMExecution::pause() {
+    pausing = true;
+    stopVal = 1;
+}
+
 void LLVMExecution::stop() {
     Scheduler* scheduler = decoder->getScheduler();
     int* stop = (int*)EE->getPointerToGlobalIfAvailable(scheduler->getStopGV());
+    stopped = true;
     if(stop) {
         *stop = 1;
     }
@@ -342,6 +525,10 @@ void* LLVMExecution::getGVPtr(llvm::GlobalVariable* gv){
     return EE->getPointerToGlobal(gv);
 }
 
+const DataLayout* LLVMExecution::getDataLayout(){
+    return EE->getDataLayout();
+}
+
 void LLVMExecution::clear() {
     EE->runStaticConstructorsDestructors(true);
     EE->clearAllGlobalMappings();
@@ -349,9 +536,29 @@ void LLVMExecution::clear() {
 
 
 LLVMExecution::~LLVMExecution(){
+    delete tiering;
+
     // Run static destructors.
     EE->runStaticConstructorsDestructors(true);
 
+    // Other decoders may still use LLVM, it is not shut down here
     delete EE;
-    llvm_shutdown();
+    delete cache;
+    delete codeSize;
+    orcc_context_destroy(nativeContext);
+}
+
+size_t LLVMExecution::getMemorySize(){
+    size_t size = codeSize->getSize();
+    const DataLayout* layout = EE->getDataLayout();
+
+    Module::global_iterator it;
+    Module* module = decoder->getModule();
+    for (it = module->global_begin(); it != module->global_end(); it++){
+        if (isCompiledGV(&*it)){
+            size += layout->getTypeAllocSize(it->getType()->getElementType());
+        }
+    }
+
+    return size;
 }
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class LLVMNative
+@author agent
+@file LLVMNative.cpp
+@version 1.0
+@date 18/10/2026
+*/
+
+//------------------------------
+#include <iostream>
+
+#include "lib/IRJit/LLVMNative.h"
+#include "lib/IRCore/Actor/Procedure.h"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+//------------------------------
+
+using namespace llvm;
+using namespace std;
+
+cl::opt<std::string> NativeOut("native-out",
+                               cl::desc("Build the decoder ahead of time into the given file instead of running it"),
+                               cl::value_desc("file"),
+                               cl::init(""));
+
+cl::opt<bool> NativeShared("native-shared",
+                           cl::desc("Build a shared library exporting initialize and main instead of an executable"),
+                           cl::init(false));
+
+cl::list<std::string> NativeLink("native-link", cl::CommaSeparated,
+                                 cl::desc("Options given to gcc to link the native runtime of an executable"),
+                                 cl::value_desc("-L<dir>,-lSDL2,..."));
+
+LLVMNative::LLVMNative(LLVMContext& C, Decoder* decoder, string output, bool shared, bool verbose): LLVMArmFix(C, decoder, verbose)  {
+    this->output = output;
+    this->shared = shared;
+}
+
+void LLVMNative::run() {
+    string AssemblyFile(output + ".s");
+    Scheduler* scheduler = decoder->getScheduler();
+
+    if (decoder->hasPartitions()){
+        cerr << "Error: partitioned decoders can't be built ahead of time." << endl;
+        exit(1);
+    }
+
+    // Build from a copy, the module of the decoder is still used by the JIT
+    ValueToValueMapTy VMap;
+    Module* module = CloneModule(decoder->getModule(), VMap);
+
+    // The stop variable belongs to the decoder, natives set it through stopVar
+    Value* stopValue = VMap[scheduler->getStopGV()];
+    Value* initValue = VMap[scheduler->getInitFunction()];
+    GlobalVariable* stopGV = cast<GlobalVariable>(stopValue);
+    Function* initFn = cast<Function>(initValue);
+
+    stopGV->setInitializer(ConstantInt::get(Type::getInt32Ty(Context), 0));
+    GlobalVariable* stopVarGV = new GlobalVariable(*module, stopGV->getType(), false, GlobalValue::ExternalLinkage, 0, "stopVar");
+    new StoreInst(stopGV, stopVarGV, &*initFn->getEntryBlock().getFirstInsertionPt());
+
+    bindNatives(module, VMap);
+
+    if (!shared){
+        createEntry(module);
+    }
+
+    tool_output_file* assembly = generateNativeCode(AssemblyFile, module, shared);
+    assembly->keep();
+    assembly->os().close();
+    delete assembly;
+    delete module;
+
+    // Assembly is only an intermediate file
+    sys::RemoveFileOnSignal(AssemblyFile);
+    int result = compileAndLink(AssemblyFile, output, shared);
+    sys::fs::remove(AssemblyFile);
+
+    if (result != 0){
+        exit(1);
+    }
+
+    if (verbose){
+        cout << "--> Decoder built in " << output << endl;
+    }
+}
+
+void LLVMNative::bindNatives(Module* module, ValueToValueMapTy& VMap){
+    list<Procedure*>::iterator it;
+    list<Procedure*> externs = decoder->getExternalProcs();
+
+    for (it = externs.begin(); it != externs.end(); it++){
+        Value* value = VMap[(*it)->getFunction()];
+
+        // Already bound through another procedure
+        if (value == NULL){
+            continue;
+        }
+
+        Function* function = cast<Function>(value);
+        string symbol = getNativeSymbol(*it);
+
+        if (function->getName() == symbol){
+            continue;
+        }
+
+        // Declarations of a native in several actors are merged
+        Function* declared = module->getFunction(symbol);
+        if (declared == NULL){
+            function->setName(symbol);
+        }else{
+            function->replaceAllUsesWith(ConstantExpr::getBitCast(declared, function->getType()));
+            function->eraseFromParent();
+        }
+    }
+}
+
+void LLVMNative::createEntry(Module* module){
+    Type* int32Ty = Type::getInt32Ty(Context);
+    Type* argvTy = PointerType::getUnqual(Type::getInt8PtrTy(Context));
+
+    // The scheduler gives its name to the entry of the program
+    Function* scheduler = module->getFunction("main");
+    Function* initialize = module->getFunction("initialize");
+    scheduler->setName("schedule");
+    scheduler->setLinkage(GlobalValue::InternalLinkage);
+
+    vector<Type*> params;
+    params.push_back(int32Ty);
+    params.push_back(argvTy);
+
+    Function* entry = Function::Create(FunctionType::get(int32Ty, params, false), GlobalValue::ExternalLinkage, "main", module);
+    Function::arg_iterator args = entry->arg_begin();
+    Value* argc = args++;
+    argc->setName("argc");
+    Value* argv = args;
+    argv->setName("argv");
+
+    // Options of the runtime (input file, number of loops, display...)
+    Function* initOrcc = cast<Function>(module->getOrInsertFunction("init_orcc", Type::getVoidTy(Context),
+                                                                    int32Ty, argvTy, (Type *)0));
+
+    BasicBlock* BB = BasicBlock::Create(Context, "entry", entry);
+    Value* initArgs[] = {argc, argv};
+    CallInst::Create(initOrcc, initArgs, "", BB);
+    CallInst::Create(initialize, "", BB);
+    CallInst::Create(scheduler, "", BB);
+    ReturnInst::Create(Context, ConstantInt::get(int32Ty, 0), BB);
+}
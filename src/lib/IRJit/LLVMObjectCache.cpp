@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class LLVMObjectCache
+@author agent
+@file LLVMObjectCache.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include <iostream>
+#include <sstream>
+#include <system_error>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Bitcode/ReaderWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "lib/IRJit/LLVMObjectCache.h"
+#include "lib/IRJit/LLVMOptimizer.h"
+//------------------------------
+
+using namespace llvm;
+using namespace std;
+
+extern cl::opt<char> JitOptLevel;
+
+cl::opt<std::string> CacheDir("cache-dir",
+                              cl::desc("Keep the machine code of the decoders in the given directory"),
+                              cl::value_desc("directory"),
+                              cl::init(""));
+
+static string getHash(StringRef data){
+    MD5 hash;
+    MD5::MD5Result result;
+    SmallString<32> str;
+
+    hash.update(data);
+    hash.final(result);
+    MD5::stringifyResult(result, str);
+
+    return str.str();
+}
+
+LLVMObjectCache::LLVMObjectCache(string directory, Module* module, bool verbose){
+    this->directory = directory;
+    this->optLevel = 0;
+    this->verbose = verbose;
+    this->triple = module->getTargetTriple();
+
+    if (sys::fs::create_directories(directory)){
+        cerr << "Error creating cache directory " << directory << endl;
+        exit(1);
+    }
+
+    // Hash the decoder as configured
+    string bitcode;
+    raw_string_ostream bitcodeStream(bitcode);
+    WriteBitcodeToFile(module, bitcodeStream);
+    bitcodeStream.flush();
+
+    moduleHash = getHash(bitcode);
+}
+
+string LLVMObjectCache::getPath(){
+    stringstream key;
+
+    // Code generated depends on the optimization levels and on the target
+    key << moduleHash << " " << optLevel << " " << JitOptLevel << " " << triple << " " << sys::getProcessTriple();
+    key << " " << LLVMOptimizer::getCPU();
+
+    vector<string> features = LLVMOptimizer::getFeatures();
+    for (unsigned int i = 0; i < features.size(); i++){
+        key << " " << features[i];
+    }
+
+    SmallString<128> path(directory);
+    sys::path::append(path, getHash(key.str()) + ".o");
+
+    return path.str();
+}
+
+bool LLVMObjectCache::hasObject(){
+    return sys::fs::exists(getPath());
+}
+
+void LLVMObjectCache::notifyObjectCompiled(const Module* M, const MemoryBuffer* Obj){
+    string path = getPath();
+
+    // Object is written aside then renamed, a concurrent decoder never reads it partially
+    int fd;
+    SmallString<128> tempPath;
+    std::error_code EC = sys::fs::createUniqueFile(path + "-%%%%%%", fd, tempPath);
+
+    if (!EC){
+        raw_fd_ostream out(fd, true);
+        out << Obj->getBuffer();
+        out.close();
+
+        if (out.has_error()){
+            out.clear_error();
+            EC = std::make_error_code(std::errc::io_error);
+        }
+    }
+
+    if (!EC){
+        EC = sys::fs::rename(tempPath.str(), path);
+    }
+
+    if (EC){
+        // Decoder still runs, it is only compiled again next time
+        cerr << "Warning: can't write " << path << " in cache: " << EC.message() << endl;
+        if (!tempPath.empty()){
+            sys::fs::remove(tempPath.str());
+        }
+        return;
+    }
+
+    if (verbose){
+        cout << "--> Decoder object written in cache : " << path << endl;
+    }
+}
+
+MemoryBuffer* LLVMObjectCache::getObject(const Module* M){
+    string path = getPath();
+    ErrorOr<std::unique_ptr<MemoryBuffer> > buffer = MemoryBuffer::getFile(path);
+
+    if (!buffer){
+        return NULL;
+    }
+
+    if (verbose){
+        cout << "--> Decoder object read from cache : " << path << endl;
+    }
+
+    return buffer.get().release();
+}
@@ -42,7 +42,12 @@
 #include "lib/IRJit/LLVMOptimizer.h"
 
 #include "llvm/LinkAllPasses.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Module.h"
+#include "llvm/MC/SubtargetFeature.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/TargetRegistry.h"
 #include "llvm/PassManager.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/IR/Verifier.h"
@@ -67,6 +72,42 @@ bool DisableInternalize = false;
 cl::opt<std::string>
 TargetTriple("mtriple", cl::desc("Override target triple for module"));
 
+cl::opt<bool>
+DisableVectorize("disable-vectorize", cl::desc("Do not run the loop and SLP vectorizers"));
+
+cl::opt<bool>
+VectorizeReport("vectorize-report", cl::desc("Print the functions that use vector instructions after optimization"));
+
+extern cl::list<std::string> MAttrs;
+extern cl::opt<std::string> MCPU;
+
+string LLVMOptimizer::getCPU(){
+    if (!MCPU.empty()){
+        return MCPU;
+    }
+
+    return sys::getHostCPUName();
+}
+
+vector<string> LLVMOptimizer::getFeatures(){
+    vector<string> features(MAttrs.begin(), MAttrs.end());
+
+    if (!features.empty()){
+        return features;
+    }
+
+    // Not all hosts are able to report their features, the cpu name implies them
+    StringMap<bool> hostFeatures;
+    if (sys::getHostCPUFeatures(hostFeatures)){
+        StringMap<bool>::iterator it;
+        for (it = hostFeatures.begin(); it != hostFeatures.end(); it++){
+            features.push_back((it->getValue() ? "+" : "-") + it->getKey().str());
+        }
+    }
+
+    return features;
+}
+
 void LLVMOptimizer::optimize(int optLevel){
 
     // Initialize passes
@@ -83,9 +124,29 @@ void LLVMOptimizer::optimize(int optLevel){
 
     Module* module = decoder->getModule();
 
-    // Allocate a full target machine description only if necessary.
-    // FIXME: The choice of target should be controllable on the command line.
+    // Allocate a target machine description of the host, so that vectorizers know its registers
     std::auto_ptr<TargetMachine> target;
+    Triple triple(TargetTriple != "" ? TargetTriple : module->getTargetTriple());
+
+    if (triple.getTriple().empty()){
+        triple.setTriple(sys::getProcessTriple());
+    }
+
+    string Err;
+    const Target* TheTarget = TargetRegistry::lookupTarget(triple.getTriple(), Err);
+
+    if (TheTarget != NULL){
+        SubtargetFeatures Features;
+        vector<string> features = getFeatures();
+
+        for (unsigned i = 0; i != features.size(); ++i){
+            Features.AddFeature(features[i]);
+        }
+
+        target.reset(TheTarget->createTargetMachine(triple.getTriple(), getCPU(), Features.getString(), TargetOptions()));
+    }else{
+        cerr << "Warning: no target for " << triple.getTriple() << ", code is optimized without target information." << endl;
+    }
 
     // Create a PassManager to hold and optimize the collection of passes we are
     // about to build...
@@ -105,10 +166,19 @@ void LLVMOptimizer::optimize(int optLevel){
     // Add an appropriate DataLayout instance for this module.
     Passes.add(new DataLayoutPass(module));
 
+    // Cost model of the target
+    if (target.get() != NULL) {
+        target->addAnalysisPasses(Passes);
+    }
+
     std::unique_ptr<FunctionPassManager> FPasses;
     if (optLevel > 0) {
         FPasses.reset(new FunctionPassManager(module));
         FPasses->add(new DataLayoutPass(module));
+
+        if (target.get() != NULL) {
+            target->addAnalysisPasses(*FPasses);
+        }
     }
 
     AddOptimizationPasses(Passes, *FPasses, optLevel);
@@ -170,6 +240,27 @@ void LLVMOptimizer::optimize(int optLevel){
     // Now that we have all of the passes ready, run them.
     Passes.run(*module);
 
+    if (VectorizeReport) {
+        reportVectorization();
+    }
+}
+
+void LLVMOptimizer::reportVectorization(){
+    Module* module = decoder->getModule();
+
+    for (Module::iterator F = module->begin(), E = module->end(); F != E; ++F){
+        int vectorInsts = 0;
+
+        for (inst_iterator I = inst_begin(F), IE = inst_end(F); I != IE; ++I){
+            if (I->getType()->isVectorTy()){
+                vectorInsts++;
+            }
+        }
+
+        if (vectorInsts > 0){
+            cout << "Vectorized " << F->getName().str() << " : " << vectorInsts << " vector instructions" << endl;
+        }
+    }
 }
 
 
@@ -194,6 +285,8 @@ void LLVMOptimizer::AddOptimizationPasses(PassManagerBase &MPM, FunctionPassMana
     }
     Builder.DisableUnitAtATime = !UnitAtATime;
     Builder.DisableUnrollLoops = OptLevel == 0;
+    Builder.LoopVectorize = OptLevel > 1 && !DisableVectorize;
+    Builder.SLPVectorize = OptLevel > 1 && !DisableVectorize;
 
     Builder.populateFunctionPassManager(FPM);
     Builder.populateModulePassManager(MPM);
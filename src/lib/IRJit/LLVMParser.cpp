@@ -36,12 +36,17 @@
 */
 
 //------------------------------
+#include <algorithm>
 #include <iostream>
+#include <chrono>
+#include <thread>
+#include <pthread.h>
 
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "lib/IRJit//LLVMParser.h"
 #include "lib/IRUtil/PackageMng.h"
@@ -63,7 +68,8 @@ Module* LLVMParser::loadModule(Package* package, string file) {
     //Get filename of the actor
     string Filename(directory + package->getDirectory() + "/" + file);
 
-    Mod = ParseIRFile(Filename, Err, Context);
+    // Bodies of functions are read when cloned into the decoder
+    Mod = getLazyIRFileModule(Filename, Err, Context);
 
     if (verbose) cout << "Loading '" << Filename << "'" << endl;
 
@@ -77,3 +83,116 @@ Module* LLVMParser::loadModule(Package* package, string file) {
 
     return Mod;
 }
+
+vector<Module*> LLVMParser::loadModules(vector<pair<Package*, string> >* files, int nbThreads) {
+    vector<Module*> modules;
+    vector<pthread_t> threads;
+    LoadJob job;
+
+    //Get filenames of the actors
+    vector<pair<Package*, string> >::iterator it;
+    for (it = files->begin(); it != files->end(); it++){
+        job.filenames.push_back(directory + it->first->getDirectory() + "/" + it->second);
+    }
+
+    job.bitcodes.resize(files->size());
+    job.errors.resize(files->size());
+    job.times.resize(files->size());
+    job.next = 0;
+
+    if (nbThreads <= 0){
+        // Number of cores may not be known
+        nbThreads = max(1u, thread::hardware_concurrency());
+    }
+
+    if (nbThreads > (int)files->size()){
+        nbThreads = files->size();
+    }
+
+    //Start workers
+    threads.resize(nbThreads);
+    for (int i = 0; i < nbThreads; i++){
+        pthread_create(&threads[i], NULL, &LLVMParser::loadProc, &job);
+    }
+
+    for (int i = 0; i < nbThreads; i++){
+        pthread_join(threads[i], NULL);
+    }
+
+    //Read bitcodes in the context of the decoder
+    for (unsigned int i = 0; i < job.filenames.size(); i++){
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        if (!job.errors[i].empty()){
+            cerr << "Error parsing bitcode file '" << (*files)[i].second << "'" << endl;
+            cerr << job.errors[i] << endl;
+            exit(1);
+        }
+
+        // Bodies of functions are read when cloned into the decoder
+        MemoryBuffer* buffer = MemoryBuffer::getMemBufferCopy(job.bitcodes[i], job.filenames[i]);
+        ErrorOr<Module*> module = getLazyBitcodeModule(buffer, Context);
+
+        if (!module) {
+            delete buffer;
+            cerr << "Error reading bitcode file '" << (*files)[i].second << "'" << endl;
+            cerr << module.getError().message() << endl;
+            exit(1);
+        }
+
+        modules.push_back(module.get());
+
+        if (verbose){
+            int time = job.times[i] + chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+            cout << "Loading '" << job.filenames[i] << "' in " << time << " ms" << endl;
+        }
+    }
+
+    return modules;
+}
+
+void* LLVMParser::loadProc(void* args) {
+    LoadJob* job = static_cast<LoadJob*>(args);
+    LLVMContext Context;
+
+    for (int i = job->next++; i < (int)job->filenames.size(); i = job->next++){
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        string& Filename = job->filenames[i];
+
+        ErrorOr<std::unique_ptr<MemoryBuffer> > file = MemoryBuffer::getFile(Filename);
+
+        if (!file) {
+            job->errors[i] = file.getError().message();
+            continue;
+        }
+
+        const unsigned char* bufferStart = (const unsigned char*)(*file)->getBufferStart();
+        const unsigned char* bufferEnd = (const unsigned char*)(*file)->getBufferEnd();
+
+        if (isBitcode(bufferStart, bufferEnd)) {
+            //Bitcode is read as is by the decoder
+            job->bitcodes[i] = (*file)->getBuffer().str();
+        }else{
+            //Textual module is parsed here
+            SMDiagnostic Err;
+            Module* Mod = ParseIRFile(Filename, Err, Context);
+
+            if (!Mod) {
+                raw_string_ostream error(job->errors[i]);
+                error << "line " << Err.getLineNo() << ": " << Err.getMessage();
+                error.flush();
+                continue;
+            }
+
+            raw_string_ostream bitcode(job->bitcodes[i]);
+            WriteBitcodeToFile(Mod, bitcode);
+            bitcode.flush();
+
+            delete Mod;
+        }
+
+        job->times[i] = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    }
+
+    return NULL;
+}
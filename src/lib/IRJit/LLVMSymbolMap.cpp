@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class LLVMSymbolMap
+@author agent
+@file LLVMSymbolMap.cpp
+@version 1.0
+@date 18/10/2026
+*/
+
+//------------------------------
+#include "lib/IRJit/LLVMSymbolMap.h"
+//------------------------------
+
+using namespace llvm;
+using namespace std;
+
+void LLVMSymbolMap::map(const string& name, void* addr){
+    symbols[name] = addr;
+}
+
+uint64_t LLVMSymbolMap::getSymbolAddress(const string& name){
+    map<string, void*>::iterator it = symbols.find(name);
+
+    // Symbols may be given with the global prefix of the target
+    if (it == symbols.end() && !name.empty() && name[0] == '_'){
+        it = symbols.find(name.substr(1));
+    }
+
+    if (it != symbols.end()){
+        return (uint64_t)(uintptr_t)it->second;
+    }
+
+    return SectionMemoryManager::getSymbolAddress(name);
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class LLVMTieredCompiler
+@author agent
+@file LLVMTieredCompiler.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include <iostream>
+#include <map>
+#include <unistd.h>
+#include <time.h>
+
+#include "llvm/LinkAllPasses.h"
+#include "llvm/PassManager.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MutexGuard.h"
+#include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include "lib/RVCEngine/Decoder.h"
+#include "lib/ConfigurationEngine/Configuration.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/IRCore/Actor/Action.h"
+#include "lib/IRCore/Actor/ActionScheduler.h"
+#include "lib/IRCore/Actor/Procedure.h"
+#include "lib/IRMerger/SuperInstance.h"
+#include "lib/IRJit/LLVMTieredCompiler.h"
+//------------------------------
+
+using namespace llvm;
+using namespace std;
+
+cl::opt<int> TieredThreshold("tiered-threshold",
+                             cl::desc("Number of firings after which an instance is recompiled with full optimizations"),
+                             cl::value_desc("N"),
+                             cl::init(10000));
+
+// Delay between two looks at the firing counters (in microseconds)
+static const int WATCH_PERIOD = 50000;
+
+LLVMTieredCompiler::LLVMTieredCompiler(ExecutionEngine* EE, Decoder* decoder, int* stopVar, bool verbose){
+    this->EE = EE;
+    this->decoder = decoder;
+    this->stopVar = stopVar;
+    this->verbose = verbose;
+    this->running = false;
+    this->requested = false;
+
+    pthread_mutex_init(&lock, NULL);
+}
+
+LLVMTieredCompiler::~LLVMTieredCompiler(){
+    stop();
+    pthread_mutex_destroy(&lock);
+}
+
+void LLVMTieredCompiler::start(){
+    if (running){
+        return;
+    }
+
+    running = true;
+    pthread_create(&thread, NULL, &LLVMTieredCompiler::threadProc, this);
+}
+
+void LLVMTieredCompiler::stop(){
+    if (!running){
+        return;
+    }
+
+    running = false;
+    pthread_join(thread, NULL);
+}
+
+void* LLVMTieredCompiler::threadProc(void* args){
+    LLVMTieredCompiler* compiler = static_cast<LLVMTieredCompiler*>(args);
+    compiler->watch();
+
+    return NULL;
+}
+
+void LLVMTieredCompiler::watch(){
+    while (running){
+        usleep(WATCH_PERIOD);
+
+        // Wait for the previous code to be relinked
+        pthread_mutex_lock(&lock);
+        bool pending = requested;
+        pthread_mutex_unlock(&lock);
+
+        if (pending){
+            continue;
+        }
+
+        // Only instances of the main scheduler are stopped at the safe point
+        list<Instance*>::iterator it;
+        list<Instance*> hot;
+        list<Instance*>* instances = decoder->getConfiguration()->getUnpartitioned();
+
+        for (it = instances->begin(); it != instances->end(); it++){
+            Instance* instance = *it;
+
+            if (promoted.find(instance) == promoted.end() && getFirings(instance) >= TieredThreshold){
+                hot.push_back(instance);
+            }
+        }
+
+        if (hot.empty()){
+            continue;
+        }
+
+        clock_t timer = clock ();
+        list<Function*> functions;
+
+        for (it = hot.begin(); it != hot.end(); it++){
+            optimize(*it, &functions);
+            promoted.insert(*it);
+        }
+
+        if (verbose){
+            cout << "--> " << hot.size() << " hot instances optimized in : " << (clock () - timer) * 1000 / CLOCKS_PER_SEC << " ms" << endl;
+        }
+
+        // Publish the functions and stop the main scheduler at once, the stop is never seen without them
+        pthread_mutex_lock(&lock);
+        ready.insert(ready.end(), functions.begin(), functions.end());
+        requested = true;
+        *stopVar = 1;
+        pthread_mutex_unlock(&lock);
+    }
+}
+
+bool LLVMTieredCompiler::relink(){
+    list<Function*>::iterator it;
+
+    pthread_mutex_lock(&lock);
+
+    if (!requested){
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+
+    for (it = ready.begin(); it != ready.end(); it++){
+        EE->recompileAndRelinkFunction(*it);
+    }
+
+    // The caller resumes the main scheduler, unless the natives stopped it meanwhile
+    ready.clear();
+    requested = false;
+
+    pthread_mutex_unlock(&lock);
+
+    return true;
+}
+
+long long LLVMTieredCompiler::getFirings(Instance* instance){
+    long long firings = 0;
+
+    if (instance->isSuperInstance()){
+        map<Instance*, int>::iterator it;
+        map<Instance*, int>* instances = ((SuperInstance*)instance)->getInstances();
+
+        for (it = instances->begin(); it != instances->end(); it++){
+            firings += getFirings(it->first);
+        }
+
+        return firings;
+    }
+
+    list<Action*>::iterator it;
+    list<Action*>* actions = instance->getActions();
+    ActionScheduler* actionScheduler = instance->getActionScheduler();
+
+    for (it = actions->begin(); it != actions->end(); it++){
+        GlobalVariable* firingsVar = actionScheduler->getFirings(*it);
+
+        if (firingsVar == NULL){
+            continue;
+        }
+
+        long long* value = (long long*)EE->getPointerToGlobalIfAvailable(firingsVar);
+
+        // Counters are written by the decoder thread, a stale count only delays the promotion
+        if (value != NULL){
+            firings += __atomic_load_n(value, __ATOMIC_RELAXED);
+        }
+    }
+
+    return firings;
+}
+
+void LLVMTieredCompiler::getActions(Instance* instance, set<Function*>* functions){
+    if (instance->isSuperInstance()){
+        map<Instance*, int>::iterator it;
+        map<Instance*, int>* instances = ((SuperInstance*)instance)->getInstances();
+
+        for (it = instances->begin(); it != instances->end(); it++){
+            getActions(it->first, functions);
+        }
+
+        return;
+    }
+
+    list<Action*>::iterator it;
+    list<Action*>* actions = instance->getActions();
+
+    for (it = actions->begin(); it != actions->end(); it++){
+        functions->insert((*it)->getScheduler()->getFunction());
+        functions->insert((*it)->getBody()->getFunction());
+    }
+}
+
+void LLVMTieredCompiler::optimize(Instance* instance, list<Function*>* functions){
+    Module* module = decoder->getModule();
+    Function* scheduler = instance->getActionScheduler()->getSchedulerFunction();
+    set<Function*> actions;
+    set<Function*>::iterator it;
+
+    getActions(instance, &actions);
+
+    // The JIT may be reading the module to compile a function lazily
+    MutexGuard locked(EE->lock);
+
+    inlineActions(scheduler, &actions);
+
+    FunctionPassManager FPM(module);
+    FPM.add(new DataLayoutPass(module));
+
+    PassManagerBuilder Builder;
+    Builder.OptLevel = 3;
+    Builder.populateFunctionPassManager(FPM);
+
+    FPM.add(createInstructionCombiningPass());
+    FPM.add(createReassociatePass());
+    FPM.add(createGVNPass());
+    FPM.add(createLICMPass());
+    FPM.add(createLoopUnrollPass());
+    FPM.add(createSCCPPass());
+    FPM.add(createInstructionCombiningPass());
+    FPM.add(createDeadStoreEliminationPass());
+    FPM.add(createAggressiveDCEPass());
+    FPM.add(createCFGSimplificationPass());
+
+    FPM.doInitialization();
+
+    FPM.run(*scheduler);
+    for (it = actions.begin(); it != actions.end(); it++){
+        FPM.run(**it);
+    }
+
+    FPM.doFinalization();
+
+    // Actions are still called directly by static region schedulers
+    functions->push_back(scheduler);
+    functions->insert(functions->end(), actions.begin(), actions.end());
+}
+
+void LLVMTieredCompiler::inlineActions(Function* scheduler, set<Function*>* actions){
+    list<CallInst*> calls;
+    list<CallInst*>::iterator it;
+
+    for (Function::iterator BB = scheduler->begin(), E = scheduler->end(); BB != E; ++BB){
+        for (BasicBlock::iterator I = BB->begin(), IE = BB->end(); I != IE; ++I){
+            CallInst* call = dyn_cast<CallInst>(I);
+
+            if (call != NULL && actions->find(call->getCalledFunction()) != actions->end()){
+                calls.push_back(call);
+            }
+        }
+    }
+
+    for (it = calls.begin(); it != calls.end(); it++){
+        InlineFunctionInfo IFI;
+        InlineFunction(*it, IFI);
+    }
+}
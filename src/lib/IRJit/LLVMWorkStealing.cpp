@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class LLVMWorkStealing
+@author agent
+@file LLVMWorkStealing.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <time.h>
+
+#include "llvm/IR/Function.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+
+#include "lib/RVCEngine/Decoder.h"
+#include "lib/ConfigurationEngine/Configuration.h"
+#include "lib/ConfigurationEngine/Partition.h"
+#include "lib/IRCore/Network.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/IRCore/Network/Connection.h"
+#include "lib/IRCore/Network/Vertex.h"
+#include "lib/IRCore/Actor/ActionScheduler.h"
+#include "lib/IRJit/LLVMWorkStealing.h"
+//------------------------------
+
+using namespace llvm;
+using namespace std;
+
+LLVMWorkStealing::LLVMWorkStealing(LLVMContext& C, Decoder* decoder, int nbThreads, bool verbose): LLVMExecution(C, decoder, verbose)  {
+    this->nbThreads = nbThreads < 1 ? 1 : nbThreads;
+}
+
+void LLVMWorkStealing::createTasks(){
+    Configuration* configuration = decoder->getConfiguration();
+    list<Instance*> instances(*configuration->getUnpartitioned());
+    map<Instance*, int> indexes;
+    list<Instance*>::iterator it;
+
+    // Partitions are ignored, every instance is shared by all the workers
+    map<string, Partition*>::iterator itPart;
+    map<string, Partition*>* partitions = configuration->getPartitions();
+    for (itPart = partitions->begin(); itPart != partitions->end(); itPart++){
+        list<Instance*>* partInstances = itPart->second->getInstances();
+        instances.insert(instances.end(), partInstances->begin(), partInstances->end());
+    }
+
+    // Compile action schedulers before starting the workers
+    for (it = instances.begin(); it != instances.end(); it++){
+        Instance* instance = *it;
+        Function* scheduler = instance->getActionScheduler()->getSchedulerFunction();
+
+        Task* task = new Task();
+        task->instance = instance;
+        task->scheduler = (int (*)())EE->getPointerToFunction(scheduler);
+        task->queued = false;
+        task->running = false;
+
+        indexes.insert(pair<Instance*, int>(instance, tasks.size()));
+        tasks.push_back(task);
+    }
+
+    // Producers and consumers of each instance
+    vector<Task*>::iterator itTask;
+    map<Instance*, int>::iterator itIndex;
+    for (itTask = tasks.begin(); itTask != tasks.end(); itTask++){
+        Task* task = *itTask;
+        Network* network = task->instance->getConfiguration()->getNetwork();
+        list<Connection*>::iterator itConn;
+
+        list<Connection*> outs = network->getOutConnections(task->instance);
+        for (itConn = outs.begin(); itConn != outs.end(); itConn++){
+            Vertex* sink = (Vertex*)(*itConn)->getSink();
+            if (sink != NULL && sink->isInstance()){
+                itIndex = indexes.find(sink->getInstance());
+                if (itIndex != indexes.end()){
+                    task->neighbours.push_back(itIndex->second);
+                }
+            }
+        }
+
+        list<Connection*> ins = network->getInConnections(task->instance);
+        for (itConn = ins.begin(); itConn != ins.end(); itConn++){
+            Vertex* source = (Vertex*)(*itConn)->getSource();
+            if (source != NULL && source->isInstance()){
+                itIndex = indexes.find(source->getInstance());
+                if (itIndex != indexes.end()){
+                    task->neighbours.push_back(itIndex->second);
+                }
+            }
+        }
+
+        sort(task->neighbours.begin(), task->neighbours.end());
+        task->neighbours.erase(unique(task->neighbours.begin(), task->neighbours.end()), task->neighbours.end());
+    }
+}
+
+void LLVMWorkStealing::run() {
+    clock_t timer = clock ();
+    clearStop();
+
+    // Instances may have changed since the last run
+    clearTasks();
+    createTasks();
+
+    // Create workers, each one starts with a share of the instances
+    for (int i = 0; i < nbThreads; i++){
+        Worker* worker = new Worker();
+        worker->parent = this;
+        worker->id = i;
+        worker->calls = 0;
+        worker->idleCalls = 0;
+        worker->steals = 0;
+        pthread_mutex_init(&worker->lock, NULL);
+        workers.push_back(worker);
+    }
+
+    for (unsigned int i = 0; i < tasks.size(); i++){
+        tasks[i]->queued = false;
+        tasks[i]->running = false;
+        push(workers[i % nbThreads], i);
+    }
+
+    if (verbose){
+        cout << "--> Work stealing on " << nbThreads << " threads for " << tasks.size() << " instances, prepared in : "<< (clock () - timer) * 1000 / CLOCKS_PER_SEC << " ms" << endl;
+    }
+
+    // Launch other workers, the current thread is the first worker
+    vector<pthread_t*> workerThreads;
+    for (int i = 1; i < nbThreads; i++){
+        pthread_t* thread = new pthread_t();
+        workerThreads.push_back(thread);
+        pthread_create(thread, NULL, &LLVMWorkStealing::workerProc, workers[i]);
+    }
+
+    work(workers[0]);
+
+    vector<pthread_t*>::iterator it;
+    for (it = workerThreads.begin(); it != workerThreads.end(); it++){
+        pthread_join(**it, NULL);
+        delete *it;
+    }
+
+    if (verbose){
+        printStatistics();
+    }
+
+    vector<Worker*>::iterator itWorker;
+    for (itWorker = workers.begin(); itWorker != workers.end(); itWorker++){
+        pthread_mutex_destroy(&(*itWorker)->lock);
+        delete *itWorker;
+    }
+    workers.clear();
+}
+
+void* LLVMWorkStealing::workerProc(void* args){
+    Worker* worker = static_cast<Worker*>(args);
+    worker->parent->work(worker);
+
+    return NULL;
+}
+
+void LLVMWorkStealing::work(Worker* worker){
+    volatile int* stop = &stopVal;
+    vector<int>::iterator it;
+
+    // Instances executed by the worker call the natives of the decoder
+    bindContext();
+
+    while (*stop == 0){
+        int index;
+
+        if (!pop(worker, index) && !steal(worker, index)){
+            // No instance is known to be ready, test all of them again
+            for (unsigned int i = 0; i < tasks.size(); i++){
+                push(worker, i);
+            }
+            continue;
+        }
+
+        Task* task = tasks[index];
+        task->queued = false;
+
+        // Another worker is executing this instance, try later
+        bool expected = false;
+        if (!task->running.compare_exchange_strong(expected, true)){
+            push(worker, index);
+            continue;
+        }
+
+        int fired = task->scheduler();
+        task->running = false;
+        worker->calls++;
+
+        if (fired == 0){
+            worker->idleCalls++;
+            continue;
+        }
+
+        // Neighbours of a fired instance may be ready
+        for (it = task->neighbours.begin(); it != task->neighbours.end(); it++){
+            push(worker, *it);
+        }
+    }
+}
+
+void LLVMWorkStealing::push(Worker* worker, int index){
+    if (tasks[index]->queued.exchange(true)){
+        return;
+    }
+
+    pthread_mutex_lock(&worker->lock);
+    worker->tasks.push_back(index);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+bool LLVMWorkStealing::pop(Worker* worker, int& index){
+    bool found = false;
+
+    pthread_mutex_lock(&worker->lock);
+    if (!worker->tasks.empty()){
+        index = worker->tasks.back();
+        worker->tasks.pop_back();
+        found = true;
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    return found;
+}
+
+bool LLVMWorkStealing::steal(Worker* thief, int& index){
+    for (int i = 1; i < nbThreads; i++){
+        Worker* victim = workers[(thief->id + i) % nbThreads];
+        bool found = false;
+
+        pthread_mutex_lock(&victim->lock);
+        if (!victim->tasks.empty()){
+            index = victim->tasks.front();
+            victim->tasks.pop_front();
+            found = true;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (found){
+            thief->steals++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void LLVMWorkStealing::printStatistics(){
+    vector<Worker*>::iterator it;
+
+    cout << "--> Work stealing statistics :" << endl;
+    for (it = workers.begin(); it != workers.end(); it++){
+        Worker* worker = *it;
+        cout << "---> Worker " << worker->id << " : " << worker->calls << " calls, "
+             << worker->idleCalls << " idle calls, " << worker->steals << " steals" << endl;
+    }
+}
+
+void LLVMWorkStealing::clearTasks(){
+    vector<Task*>::iterator it;
+    for (it = tasks.begin(); it != tasks.end(); it++){
+        delete *it;
+    }
+    tasks.clear();
+}
+
+LLVMWorkStealing::~LLVMWorkStealing(){
+    clearTasks();
+}
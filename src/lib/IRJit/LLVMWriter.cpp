@@ -43,6 +43,8 @@
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Attributes.h"
 #include "llvm/Transforms/Utils/Cloning.h"
+
+#include <iostream>
 //------------------------------
 
 using namespace std;
@@ -160,6 +162,16 @@ void LLVMWriter::linkExternalFunction(Function* srcFunction, Function* dstFuncti
 
 bool LLVMWriter::linkProcedureBody(Function* function){
     Function *F = cast<Function>(ValueMap[function]);
+
+    // Body of the function is read from the actor on first use
+    if (function->isMaterializable()) {
+        string ErrorMsg;
+        if (function->Materialize(&ErrorMsg)) {
+            cerr << "Error reading function " << function->getName().str() << ": " << ErrorMsg << endl;
+            exit(1);
+        }
+    }
+
     if (!function->isDeclaration()) {
         Function::arg_iterator DestI = F->arg_begin();
         for (Function::const_arg_iterator J = function->arg_begin(); J != function->arg_end();
@@ -82,7 +82,13 @@ extern "C"{
     extern void fpsPrintInit();
     extern void fpsPrintNewPicDecoded(void);
 
-    extern int* stopVar;
+    //Extern functions for the native context of each decoder
+    extern struct orcc_context_s* orcc_context_create();
+    extern void orcc_context_destroy(struct orcc_context_s* context);
+    extern void orcc_context_bind(struct orcc_context_s* context);
+    extern void orcc_context_set_input(struct orcc_context_s* context, char* input_file);
+    extern void orcc_context_set_stop(struct orcc_context_s* context, int* stop);
+    extern int orcc_context_is_stopped(struct orcc_context_s* context);
 
 }
 
@@ -123,6 +129,18 @@ std::map<std::string, void*> createNativeMap()
 }
 
 
+std::map<std::string, std::string> createNativeNames()
+{
+    std::map<std::string, std::string> names;
+
+    // Native procedures bound to a symbol of another name
+    names["print"] = "printf";
+
+    return names;
+}
+
+
 std::map<std::string,void*> nativeMap = createNativeMap();
+std::map<std::string,std::string> nativeNames = createNativeNames();
 
 #endif
@@ -48,13 +48,13 @@ using namespace llvm;
 
 CheckPinoRules::CheckPinoRules(Network* network){
     this->network = network;
+    this->index = 0;
+
+    computeComponents();
 }
 
 
 bool CheckPinoRules::isValide(Instance* src, Instance* dst){
-    this->dst = dst;
-    this->src = src;
-
     //Check cycle violation
     if (checkCycle(src)){
         return false;
@@ -73,67 +73,188 @@ bool CheckPinoRules::isValide(Instance* src, Instance* dst){
     return true;
 }
 
-bool CheckPinoRules::checkCycle(Instance* instance){
-    list<Instance*> visited;
-    paths.clear();
+void CheckPinoRules::computeComponents(){
+    list<Instance*>::iterator it;
+    list<Instance*>* instances = network->getInstances();
 
-    visited.push_back(instance);
-    findPath(&visited, instance);
+    // Store successors and predecessors of the network once
+    network->computeSuccessorsMaps();
 
-    return paths.size() > 0;
-}
+    for (it = instances->begin(); it != instances->end(); it++){
+        list<Instance*>::iterator itSucc;
+        list<Instance*> succs = network->getSuccessorsOf(*it);
 
-bool CheckPinoRules::checkZeroDelay(Instance* src, Instance* dst){
-    list<Instance*> visited;
-    paths.clear();
+        for (itSucc = succs.begin(); itSucc != succs.end(); itSucc++){
+            successors[*it].insert(*itSucc);
+            predecessors[*itSucc].insert(*it);
+        }
+    }
+
+    // Each instance is a bit of the reachability sets
+    for (it = instances->begin(); it != instances->end(); it++){
+        int id = ids.size();
+        ids[*it] = id;
+    }
 
-    visited.push_back(src);
-    findPath(&visited, dst);
+    for (it = instances->begin(); it != instances->end(); it++){
+        if (indexes.find(*it) == indexes.end()){
+            strongConnect(*it);
+        }
+    }
 
-    return paths.size() > 1;
+    indexes.clear();
 }
 
+void CheckPinoRules::strongConnect(Instance* instance){
+    pair<int, int>& instanceIndex = indexes[instance];
+    instanceIndex.first = index;
+    instanceIndex.second = index;
+    index++;
 
-void CheckPinoRules::findPath(list<Instance*>* visited, Instance* end){
-    list<Instance*>::iterator it;
+    stack.push_back(instance);
+    onStack.insert(instance);
 
-    // Get last visited element
-    list<Instance*> nodes = network->getSuccessorsOf(visited->back());
+    set<Instance*>::iterator it;
+    set<Instance*>* succs = getSuccessorsOf(instance);
 
-    // Check path to all successor
-    for (it = nodes.begin(); it != nodes.end(); it++){
-        Instance* node = *it;
+    for (it = succs->begin(); it != succs->end(); it++){
+        Instance* successor = *it;
 
-        if (node == end){
-            // End of search
-            visited->push_back(node);
-            storePath(visited);
-            visited->pop_back();
+        if (successor == instance){
+            // Connected to itself
+            cyclic.insert(instance);
+            continue;
         }
 
-        if (find(visited->begin(), visited->end(), node) != visited->end()){
-            // Element already visited check other successor
-            continue;
+        map<Instance*, pair<int, int> >::iterator itIndex = indexes.find(successor);
+
+        if (itIndex == indexes.end()){
+            strongConnect(successor);
+            indexes[instance].second = min(indexes[instance].second, indexes[successor].second);
+        }else if (onStack.find(successor) != onStack.end()){
+            indexes[instance].second = min(indexes[instance].second, itIndex->second.first);
         }
     }
 
-    // Visit recursion needs to come after visiting adjacent nodes
-    for (it = nodes.begin(); it != nodes.end(); it++){
-        Instance* node = *it;
+    // Instance is the root of a component
+    if (indexes[instance].second == indexes[instance].first){
+        list<Instance*> component;
+        Instance* member;
 
-        if (find(visited->begin(), visited->end(), node) != visited->end() || node == end || node == src || node == dst){
-            continue;
+        do{
+            member = stack.back();
+            stack.pop_back();
+            onStack.erase(member);
+            component.push_back(member);
+        }while (member != instance);
+
+        if (component.size() > 1){
+            cyclic.insert(component.begin(), component.end());
         }
 
-        visited->push_back(node);
-        findPath(visited, end);
-        visited->pop_back();
+        // Components are found in reverse topological order, only the reach
+        // of the successors inside the component is not known yet
+        list<Instance*>::iterator itMember;
+        vector<bool> reach(ids.size(), false);
+
+        for (itMember = component.begin(); itMember != component.end(); itMember++){
+            set<Instance*>* memberSuccs = getSuccessorsOf(*itMember);
+
+            for (it = memberSuccs->begin(); it != memberSuccs->end(); it++){
+                map<Instance*, vector<bool> >::iterator itReach = reachable.find(*it);
+                reach[ids[*it]] = true;
+
+                if (itReach != reachable.end()){
+                    addReachable(reach, itReach->second);
+                }
+            }
+        }
+
+        for (itMember = component.begin(); itMember != component.end(); itMember++){
+            reachable[*itMember] = reach;
+        }
     }
 }
 
-void CheckPinoRules::storePath(list<Instance*>* visited){
+void CheckPinoRules::addReachable(vector<bool>& reach, vector<bool>& other){
+    for (unsigned int i = 0; i < reach.size(); i++){
+        if (other[i]){
+            reach[i] = true;
+        }
+    }
+}
+
+bool CheckPinoRules::checkCycle(Instance* instance){
+    return cyclic.find(instance) != cyclic.end();
+}
+
+bool CheckPinoRules::checkZeroDelay(Instance* src, Instance* dst){
     set<Instance*>::iterator it;
-    list<Instance*> path(visited->begin(), visited->end());
+    int dstId = ids[dst];
+
+    // Another successor of source reaches destination
+    set<Instance*>* succs = getSuccessorsOf(src);
+    for (it = succs->begin(); it != succs->end(); it++){
+        if (*it != dst && reachable[*it][dstId]){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CheckPinoRules::merge(Instance* src, Instance* dst, Instance* merged){
+    Instance* olds[2] = {src, dst};
+    set<Instance*>& mergedSuccs = successors[merged];
+    set<Instance*>& mergedPreds = predecessors[merged];
+
+    for (int i = 0; i < 2; i++){
+        set<Instance*>::iterator it;
+        set<Instance*>* succs = getSuccessorsOf(olds[i]);
+        set<Instance*>* preds = getPredecessorsOf(olds[i]);
+
+        // Connections to the merged instances now start from merged
+        for (it = succs->begin(); it != succs->end(); it++){
+            if (*it != src && *it != dst){
+                mergedSuccs.insert(*it);
+                predecessors[*it].erase(olds[i]);
+                predecessors[*it].insert(merged);
+            }
+        }
+
+        for (it = preds->begin(); it != preds->end(); it++){
+            if (*it != src && *it != dst){
+                mergedPreds.insert(*it);
+                successors[*it].erase(olds[i]);
+                successors[*it].insert(merged);
+            }
+        }
+    }
+
+    successors.erase(src);
+    successors.erase(dst);
+    predecessors.erase(src);
+    predecessors.erase(dst);
+
+    // Merged takes the bit of source, instances that reached destination now reach it
+    int srcId = ids[src];
+    int dstId = ids[dst];
+    vector<bool> reach = reachable[src];
+    addReachable(reach, reachable[dst]);
+    reach[dstId] = false;
+
+    map<Instance*, vector<bool> >::iterator itReach;
+    for (itReach = reachable.begin(); itReach != reachable.end(); itReach++){
+        if (itReach->second[dstId]){
+            itReach->second[srcId] = true;
+        }
+    }
+
+    reachable.erase(src);
+    reachable.erase(dst);
+    reachable[merged] = reach;
 
-    paths.push_back(path);
+    ids.erase(src);
+    ids.erase(dst);
+    ids[merged] = srcId;
 }
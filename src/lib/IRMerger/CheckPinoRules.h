@@ -38,8 +38,10 @@
 //------------------------------
 #ifndef CHECKPINORULES_H
 #define CHECKPINORULES_H
+#include <map>
 #include <set>
 #include <list>
+#include <vector>
 
 class Instance;
 class Network;
@@ -48,6 +50,13 @@ class Network;
 /**
  * @brief  This class check pino rules before merging two instance.
  *
+ * Instances that belong to a cycle of the network are never merged, and
+ * two instances are merged only if the direct connections between them are
+ * the only paths from the source to the destination. Cycles and the
+ * instances reached from each instance are found once with the strongly
+ * connected components of the network, since merging two instances that
+ * respect these rules never creates a new cycle.
+ *
  * @author Jerome Gorin
  *
  */
@@ -62,23 +71,60 @@ public:
 
     bool isValide(Instance* src, Instance* dst);
 
+    /**
+     * @brief Get the successors of an instance
+     *
+     * @param instance : the Instance
+     *
+     * @return the set of successors of the instance
+     */
+    std::set<Instance*>* getSuccessorsOf(Instance* instance){return &successors[instance];}
+
+    /**
+     * @brief Get the predecessors of an instance
+     *
+     * @param instance : the Instance
+     *
+     * @return the set of predecessors of the instance
+     */
+    std::set<Instance*>* getPredecessorsOf(Instance* instance){return &predecessors[instance];}
+
+    /**
+     * @brief Replace two merged instances by their merge
+     *
+     * @param src : the source Instance
+     *
+     * @param dst : the destination Instance
+     *
+     * @param merged : the Instance that merges src and dst
+     */
+    void merge(Instance* src, Instance* dst, Instance* merged);
+
 private:
 
     /**
-     * @brief Find path using breadth-first search
+     * @brief Compute the strongly connected components of the network
      *
-     * @param visited : a list of visited instance
+     * Instances of a component of more than one instance, or with a
+     * connection to themselves, are stored as cyclic.
+     */
+    void computeComponents();
+
+    /**
+     * @brief Visit an instance with the algorithm of Tarjan
      *
-     * @param end : the end Instance
+     * @param instance : the Instance to visit
      */
-    void findPath(std::list<Instance*>* visited, Instance* end);
+    void strongConnect(Instance* instance);
 
     /**
-     * @brief Add the given path to path found
+     * @brief Add the instances reached from another instance
+     *
+     * @param reach : the instances reached, as bits of their ids
      *
-     * @param visited : a list of visited instance
+     * @param other : the instances reached from the other instance
      */
-    void storePath(std::list<Instance*>* visited);
+    void addReachable(std::vector<bool>& reach, std::vector<bool>& other);
 
     /**
      * @brief Look for dynamic cycle to the given instance
@@ -91,19 +137,36 @@ private:
     /**
      * @brief Look for precedence in between the two instance to merge
      *
-     * @return true if precedence are found, otherwise false
+     * @return true if another path than the direct connections links
+     *  the two instances, otherwise false
      */
     bool checkZeroDelay(Instance* src, Instance* dst);
 
-    /** Instances to check */
-    Instance* src;
-    Instance* dst;
-
     /** The network to check */
     Network* network;
 
-    /** Path found*/
-    std::list<std::list<Instance*> > paths;
+    /** Successors and predecessors of the instances */
+    std::map<Instance*, std::set<Instance*> > successors;
+    std::map<Instance*, std::set<Instance*> > predecessors;
+
+    /** Instances that belong to a cycle */
+    std::set<Instance*> cyclic;
+
+    /** Bit of each instance in the reachability sets */
+    std::map<Instance*, int> ids;
+
+    /** Instances reached from each instance, as bits of their ids */
+    std::map<Instance*, std::vector<bool> > reachable;
+
+    /** Visit index and lowest reachable index of the instances */
+    std::map<Instance*, std::pair<int, int> > indexes;
+
+    /** Instances visited and not yet assigned to a component */
+    std::list<Instance*> stack;
+    std::set<Instance*> onStack;
+
+    /** Index of the next instance visited */
+    int index;
 };
 
 
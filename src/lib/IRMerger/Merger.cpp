@@ -36,8 +36,10 @@
 */
 
 //------------------------------
+#include <iostream>
 #include <map>
 #include <list>
+#include <set>
 #include <sstream>
 
 #include "Rational.h"
@@ -59,63 +61,58 @@ Merger::Merger(LLVMContext& C, Configuration* configuration, bool verbose): Cont
     // Set merger property
     this->configuration = configuration;
     this->index = 0;
+    this->calls = 0;
+    this->fifos = 0;
     this->network = configuration->getNetwork();
     this->verbose = verbose;
 }
 
 void Merger::transform(){
-    bool hasCondidate = true;
+    set<Instance*> removed;
+    list<Instance*> worklist;
+    list<Instance*>* instances = network->getInstances();
 
     //Initialize pino rule checker
     CheckPinoRules pinoChecker(network);
 
-    // Iterate though all vertices until no candidate left
-    while(hasCondidate){
-        list<Instance*>::iterator it;
-        list<Instance*>* instances = network->getInstances();
-
-        // First compute all successors in the network
-        network->computeSuccessorsMaps();
-        bool recompute = false;
-
-        for (it = instances->begin(); it != instances->end(); it++){
-            Instance* src = *it;
-            Actor* srcActor = src->getActor();
-
-            if (srcActor->getMoC()->isCSDF()){
-                //Iterate though successors, try to find a static actor
-                list<Instance*>::iterator itDst;
-                list<Instance*> dsts = network->getSuccessorsOf(src);
-
-                for (itDst = dsts.begin(); itDst !=  dsts.end(); itDst++){
-                    Instance* dst = *itDst;
-                    Actor* dstActor = dst->getActor();
-
-                    if (dstActor->getMoC()->isCSDF()){
-                        if (pinoChecker.isValide(src, dst)){
-                            // These two actors can be merged
-                            mergeInstance(src, dst);
-
-                            // Recompute graph
-                            recompute = true;
-                            break;
-                        }
-                    }
-                }
+    // Try to merge each instance with its successors
+    worklist.insert(worklist.end(), instances->begin(), instances->end());
+
+    while (!worklist.empty()){
+        Instance* src = worklist.front();
+        worklist.pop_front();
+
+        if (removed.find(src) != removed.end() || !isMergeable(src)){
+            continue;
+        }
+
+        //Iterate though successors, try to find a static actor
+        set<Instance*>::iterator itDst;
+        set<Instance*>* dsts = pinoChecker.getSuccessorsOf(src);
+
+        for (itDst = dsts->begin(); itDst != dsts->end(); itDst++){
+            Instance* dst = *itDst;
+
+            if (!isMergeable(dst) || !pinoChecker.isValide(src, dst)){
+                continue;
             }
 
-            if (recompute){
-                break;
+            // These two actors can be merged
+            SuperInstance* superInstance = mergeInstance(src, dst);
+
+            if (superInstance == NULL){
+                continue;
             }
-        }
 
-        if (index == 28){
-            recompute = false;
-        }
+            pinoChecker.merge(src, dst, superInstance);
+            removed.insert(src);
+            removed.insert(dst);
 
-        if (!recompute){
-            // No merging found, end the analysis
-            hasCondidate = false;
+            // The merged instance and its predecessors may be merged again
+            worklist.push_back(superInstance);
+            set<Instance*>* preds = pinoChecker.getPredecessorsOf(superInstance);
+            worklist.insert(worklist.end(), preds->begin(), preds->end());
+            break;
         }
     }
 
@@ -123,20 +120,46 @@ void Merger::transform(){
     configuration->update();
 
     if (verbose){
-        cout << "--> " << index + 1 << " instances are merged." << endl;
+        cout << "--> " << index << " merges removed " << calls << " scheduler calls and " << fifos << " fifos." << endl;
     }
 }
 
-void Merger::mergeInstance(Instance* src, Instance* dst){
+bool Merger::isMergeable(Instance* instance){
+    Actor* actor = instance->getActor();
+
+    if (actor == NULL || actor->getMoC() == NULL || !actor->getMoC()->isCSDF()){
+        return false;
+    }
+
+    // Instances of a partition are executed by their own thread
+    return configuration->getPartition(instance) == NULL;
+}
+
+SuperInstance* Merger::mergeInstance(Instance* src, Instance* dst){
     // Get all connections between the two instances
     list<Connection*>* connections = network->getAllConnections(src, dst);
 
     SuperInstance* superInstance =  getSuperInstance(src, dst, connections);
 
+    if (superInstance == NULL){
+        return NULL;
+    }
+
     updateConnections(connections, src, dst, superInstance);
 
     network->removeInstance(src);
     network->removeInstance(dst);
+
+    // Both instances are called once by the merged instance and their connections become internal
+    calls++;
+    fifos += connections->size();
+
+    if (verbose){
+        cout << "--> Merged " << src->getId() << " and " << dst->getId() << " into " << superInstance->getId()
+             << ", removing 1 scheduler call and " << connections->size() << " fifos." << endl;
+    }
+
+    return superInstance;
 }
 
 void Merger::updateConnections(list<Connection*>* connections, Instance* src, Instance* dst, SuperInstance* superInstance){
@@ -189,11 +212,6 @@ void Merger::updateConnections(list<Connection*>* connections, Instance* src, In
 }
 
 SuperInstance*  Merger::getSuperInstance(Instance* src, Instance* dst, list<Connection*>* connections ){
-    // Superinstance name
-    stringstream id;
-    id << "merger";
-    id << index++;
-
     //Get property of instances
     Actor* srcAct = src->getActor();
     MoC* srcMoC = srcAct->getMoC();
@@ -204,37 +222,58 @@ SuperInstance*  Merger::getSuperInstance(Instance* src, Instance* dst, list<Conn
 
     map<Port*, Port*>* internPorts = new map<Port*, Port*>();
 
-    // Calculate rate and set internal ports
+    // Calculate rate
     Rational rate;
 
     list<Connection*>::iterator it;
     for (it = connections->begin(); it != connections->end(); it++){
         Connection* connection = *it;
 
-        // Get ports of the connection
-        Port* srcPort = connection->getSourcePort();
-        Port* dstPort = connection->getDestinationPort();
+        // Readers of a port with several connections share its fifo, it can't become internal
+        if (connection->getSourcePort()->getConnections()->size() > 1){
+            delete internPorts;
+            return NULL;
+        }
 
         // Get corresponding port in actor
-        Port* srcActPort = srcAct->getOutput(srcPort->getName());
-        Port* dstActPort = dstAct->getInput(dstPort->getName());
+        Port* srcActPort = srcAct->getOutput(connection->getSourcePort()->getName());
+        Port* dstActPort = dstAct->getInput(connection->getDestinationPort()->getName());
+        ConstantInt* srcProd = srcPattern->getNumTokens(srcActPort);
+        ConstantInt* dstCons = dstPattern->getNumTokens(dstActPort);
+
+        if (srcProd == NULL || dstCons == NULL || srcProd->isZero() || dstCons->isZero()){
+            // Tokens of the connection are not static
+            delete internPorts;
+            return NULL;
+        }
 
         // Verify that rate of the two instances are consistent
-        Rational compareRate = getRational(srcPattern->getNumTokens(srcActPort), dstPattern->getNumTokens(dstActPort));
+        Rational compareRate = getRational(srcProd, dstCons);
         if ( rate == 0){
             rate = compareRate;
         }else if (rate != compareRate){
             // This two instances can't be merged
+            delete internPorts;
             return NULL;
         }
+    }
+
+    // Set internal ports of each instances
+    for (it = connections->begin(); it != connections->end(); it++){
+        Port* srcPort = (*it)->getSourcePort();
+        Port* dstPort = (*it)->getDestinationPort();
 
-        // Set internal ports of each instances
         srcPort->setInternal(true);
         dstPort->setInternal(true);
         internPorts->insert(pair<Port*, Port*>(srcPort, dstPort));
     }
 
 
+    // Superinstance name
+    stringstream id;
+    id << "merger";
+    id << index++;
+
     return new SuperInstance(Context, id.str() , src, rate.numerator(), dst, rate.denominator(), internPorts);
 }
 
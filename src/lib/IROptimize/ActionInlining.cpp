@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class ActionInlining
+@author agent
+@file ActionInlining.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include <list>
+#include <map>
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include "lib/ConfigurationEngine/Configuration.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/IRCore/Actor/ActionScheduler.h"
+#include "lib/IRCore/Actor/FSM.h"
+#include "lib/IRMerger/SuperInstance.h"
+#include "lib/IROptimize/ActionInlining.h"
+
+//------------------------------
+
+using namespace std;
+using namespace llvm;
+
+void ActionInlining::transform(Decoder* decoder){
+    map<string, Instance*>::iterator it;
+    Configuration* configuration = decoder->getConfiguration();
+    map<string, Instance*>* instances = configuration->getInstances();
+
+    for (it = instances->begin(); it != instances->end(); it++){
+        doInline(it->second);
+    }
+}
+
+void ActionInlining::doInline(Instance* instance){
+    ActionScheduler* actionScheduler = instance->getActionScheduler();
+    set<Function*> functions;
+    set<Function*>::iterator it;
+
+    // Functions of instances sharing their code only call the shared copies
+    if (actionScheduler->getContext() != NULL){
+        return;
+    }
+
+    getActions(instance, &functions);
+
+    inlineCalls(actionScheduler->getSchedulerFunction(), &functions);
+
+    if (actionScheduler->getInitializeFunction() != NULL){
+        inlineCalls(actionScheduler->getInitializeFunction(), &functions);
+    }
+
+    //Remove out-of-line copies, static region schedulers may still call them
+    for (it = functions.begin(); it != functions.end(); it++){
+        Function* function = *it;
+
+        if (function->use_empty() && !function->isDeclaration()){
+            function->deleteBody();
+        }
+    }
+}
+
+void ActionInlining::getActions(Instance* instance, set<Function*>* functions){
+    if (instance->isSuperInstance()){
+        map<Instance*, int>::iterator it;
+        map<Instance*, int>* instances = ((SuperInstance*)instance)->getInstances();
+
+        for (it = instances->begin(); it != instances->end(); it++){
+            getActions(it->first, functions);
+        }
+
+        return;
+    }
+
+    list<Action*>::iterator it;
+    list<Action*>* actions = instance->getActions();
+
+    for (it = actions->begin(); it != actions->end(); it++){
+        functions->insert((*it)->getScheduler()->getFunction());
+        functions->insert((*it)->getBody()->getFunction());
+    }
+
+    list<Action*>* initializes = instance->getInitializes();
+
+    for (it = initializes->begin(); it != initializes->end(); it++){
+        functions->insert((*it)->getScheduler()->getFunction());
+        functions->insert((*it)->getBody()->getFunction());
+    }
+
+    FSM* fsm = instance->getActionScheduler()->getFsm();
+
+    if (fsm != NULL && fsm->getOutFsmFn() != NULL){
+        functions->insert(fsm->getOutFsmFn());
+    }
+}
+
+void ActionInlining::inlineCalls(Function* caller, set<Function*>* functions){
+    list<CallInst*> calls;
+
+    do{
+        calls.clear();
+
+        for (Function::iterator BB = caller->begin(), E = caller->end(); BB != E; ++BB){
+            for (BasicBlock::iterator I = BB->begin(), IE = BB->end(); I != IE; ++I){
+                CallInst* call = dyn_cast<CallInst>(I);
+
+                if (call != NULL && functions->find(call->getCalledFunction()) != functions->end()
+                        && !call->getCalledFunction()->isDeclaration()){
+                    calls.push_back(call);
+                }
+            }
+        }
+
+        list<CallInst*>::iterator it;
+        bool inlined = false;
+
+        for (it = calls.begin(); it != calls.end(); it++){
+            InlineFunctionInfo IFI;
+            inlined |= InlineFunction(*it, IFI);
+        }
+
+        if (!inlined){
+            break;
+        }
+    }while (!calls.empty());
+}
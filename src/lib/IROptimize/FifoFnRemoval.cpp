@@ -36,11 +36,14 @@
 */
 
 //------------------------------
-#include <map>
+#include <list>
 
 #include "lib/IROptimize/FifoFnRemoval.h"
 
 #include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Transforms/Utils/Cloning.h"
 
 //------------------------------
 
@@ -48,14 +51,42 @@ using namespace std;
 using namespace llvm;
 
 void FifoFnRemoval::transform(Decoder* decoder){
-    /*  AbstractConnector* fifo = decoder->getFifo();
-    decoder->getModule();
-    map<string,Function*>::iterator it;
-    map<string,Function*>* fifoAcesses = fifo->getFifoAccess();
+    Module* module = decoder->getModule();
+    list<Function*> fifoFns;
+    list<Function*>::iterator it;
 
-    for (it = fifoAcesses->begin(); it != fifoAcesses->end(); it++){
-        Function* function = it->second;
-        function->removeFromParent();
-    }*/
+    // Accessors of the fifo states created by the connector
+    for (Module::iterator F = module->begin(), E = module->end(); F != E; ++F){
+        if (!F->isDeclaration() && isFifoFn(F->getName())){
+            fifoFns.push_back(F);
+        }
+    }
 
+    for (it = fifoFns.begin(); it != fifoFns.end(); it++){
+        Function* function = *it;
+        list<CallInst*> calls;
+        list<CallInst*>::iterator itCall;
+
+        for (Value::use_iterator U = function->use_begin(), UE = function->use_end(); U != UE; ++U){
+            CallInst* call = dyn_cast<CallInst>(U->getUser());
+
+            if (call != NULL && call->getCalledFunction() == function){
+                calls.push_back(call);
+            }
+        }
+
+        for (itCall = calls.begin(); itCall != calls.end(); itCall++){
+            InlineFunctionInfo IFI;
+            InlineFunction(*itCall, IFI);
+        }
+
+        // Fifo accessors are created again by name when needed
+        if (function->use_empty()){
+            function->eraseFromParent();
+        }
+    }
+}
+
+bool FifoFnRemoval::isFifoFn(StringRef name){
+    return name.startswith("get_num_Tokens") || name.startswith("get_room");
 }
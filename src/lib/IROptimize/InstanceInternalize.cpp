@@ -43,6 +43,7 @@
 #include "lib/ConfigurationEngine/Configuration.h"
 #include "lib/IRCore/Network/Instance.h"
 #include "lib/IROptimize/InstanceInternalize.h"
+#include "lib/IRMerger/SuperInstance.h"
 
 //------------------------------
 
@@ -60,12 +61,25 @@ void InstanceInternalize::transform(Decoder* decoder){
 }
 
 void InstanceInternalize::doInternalize(Instance* instance){
+    //Visit merged instances
+    if (instance->isSuperInstance()){
+        map<Instance*, int>::iterator itInst;
+        map<Instance*, int>* instances = ((SuperInstance*)instance)->getInstances();
+
+        for (itInst = instances->begin(); itInst != instances->end(); itInst++){
+            doInternalize(itInst->first);
+        }
+
+        return;
+    }
+
     //Visit actions
     list<Action*>::iterator it;
     list<Action*>* actions = instance->getActions();
 
     for (it = actions->begin(); it != actions->end(); it++){
         setProcInternal((*it)->getScheduler());
+        setProcInternal((*it)->getBody());
     }
 
     //Visit initializes
@@ -73,19 +87,11 @@ void InstanceInternalize::doInternalize(Instance* instance){
 
     for (it = initializes->begin(); it != initializes->end(); it++){
         setProcInternal((*it)->getScheduler());
+        setProcInternal((*it)->getBody());
     }
 
-    //Visit procedures
-    map<string, Procedure*>::iterator itProc;
-    map<string, Procedure*>* procs = instance->getProcs();
-
-    for (itProc = procs->begin(); itProc != procs->end(); itProc++){
-        Procedure* proc = itProc->second;
-        if  (!proc->isExternal()){
-            setProcInternal(proc);
-        }
-    }
-
+    //Procedures keep their linkage, the inliner of the optimizer would
+    //delete the ones no longer called while the instance still refers to them
 }
 
 void InstanceInternalize::setProcInternal(Procedure* procedure){
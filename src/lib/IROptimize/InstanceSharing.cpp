@@ -0,0 +1,613 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class InstanceSharing
+@author agent
+@file InstanceSharing.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include <iostream>
+
+#include "lib/IROptimize/InstanceSharing.h"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
+
+#include "lib/RVCEngine/Decoder.h"
+#include "lib/ConfigurationEngine/Configuration.h"
+#include "lib/IRCore/Actor.h"
+#include "lib/IRCore/Variable.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/IRCore/Actor/Action.h"
+#include "lib/IRCore/Actor/ActionScheduler.h"
+#include "lib/IRCore/Actor/FSM.h"
+#include "lib/IRCore/Actor/Procedure.h"
+//------------------------------
+
+using namespace std;
+using namespace llvm;
+
+InstanceSharing::InstanceSharing(bool verbose){
+    this->module = NULL;
+    this->verbose = verbose;
+}
+
+void InstanceSharing::transform(Decoder* decoder){
+    module = decoder->getModule();
+
+    map<string, Instance*>::iterator it;
+    map<string, Instance*>* instances = decoder->getConfiguration()->getInstances();
+    list<Group*> groups;
+    list<Group*>::iterator itGroup;
+
+    // Gather instances of a same actor that only differ by their globals
+    for (it = instances->begin(); it != instances->end(); it++){
+        Instance* instance = it->second;
+
+        if (instance->isSuperInstance()){
+            continue;
+        }
+
+        bool found = false;
+
+        for (itGroup = groups.begin(); itGroup != groups.end() && !found; itGroup++){
+            Group* group = *itGroup;
+            GlobalMap globals;
+
+            if (group->reference->getActor() != instance->getActor() || !sameParameters(group->reference, instance)){
+                continue;
+            }
+
+            if (matchInstance(group->reference, instance, &globals)){
+                group->instances.push_back(instance);
+                group->globals[instance] = globals;
+                found = true;
+            }
+        }
+
+        if (!found){
+            Group* group = new Group();
+            group->reference = instance;
+            group->instances.push_back(instance);
+            groups.push_back(group);
+        }
+    }
+
+    for (itGroup = groups.begin(); itGroup != groups.end(); itGroup++){
+        Group* group = *itGroup;
+
+        if (group->instances.size() > 1){
+            share(group);
+        }
+
+        delete group;
+    }
+}
+
+vector<Function*> InstanceSharing::getFunctions(Instance* instance){
+    vector<Function*> functions;
+    ActionScheduler* actionScheduler = instance->getActionScheduler();
+    FSM* fsm = actionScheduler->getFsm();
+
+    functions.push_back(actionScheduler->getSchedulerFunction());
+    functions.push_back(actionScheduler->getInitializeFunction());
+    functions.push_back(fsm != NULL ? fsm->getOutFsmFn() : NULL);
+
+    list<Action*>::iterator itAction;
+    list<Action*>* actions = instance->getActions();
+
+    for (itAction = actions->begin(); itAction != actions->end(); itAction++){
+        functions.push_back((*itAction)->getScheduler()->getFunction());
+        functions.push_back((*itAction)->getBody()->getFunction());
+    }
+
+    list<Action*>* initializes = instance->getInitializes();
+
+    for (itAction = initializes->begin(); itAction != initializes->end(); itAction++){
+        functions.push_back((*itAction)->getScheduler()->getFunction());
+        functions.push_back((*itAction)->getBody()->getFunction());
+    }
+
+    map<string, Procedure*>::iterator itProc;
+    map<string, Procedure*>* procs = instance->getProcs();
+
+    for (itProc = procs->begin(); itProc != procs->end(); itProc++){
+        Procedure* proc = itProc->second;
+
+        // Native procedures are the same for all instances
+        if (!proc->isExternal()){
+            functions.push_back(proc->getFunction());
+        }
+    }
+
+    return functions;
+}
+
+bool InstanceSharing::sameParameters(Instance* reference, Instance* instance){
+    map<string, Variable*>::iterator it;
+    map<string, Variable*>* refParameters = reference->getParameters();
+    map<string, Variable*>* parameters = instance->getParameters();
+
+    if (refParameters->size() != parameters->size()){
+        return false;
+    }
+
+    for (it = refParameters->begin(); it != refParameters->end(); it++){
+        map<string, Variable*>::iterator itParam = parameters->find(it->first);
+
+        if (itParam == parameters->end()){
+            return false;
+        }
+
+        GlobalVariable* refGV = it->second->getGlobalVariable();
+        GlobalVariable* GV = itParam->second->getGlobalVariable();
+
+        if (refGV == NULL || GV == NULL || !refGV->hasInitializer() || !GV->hasInitializer()){
+            return false;
+        }
+
+        // Constants are uniqued in the context
+        if (refGV->getInitializer() != GV->getInitializer()){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool InstanceSharing::matchInstance(Instance* reference, Instance* instance, GlobalMap* globals){
+    vector<Function*> refFunctions = getFunctions(reference);
+    vector<Function*> functions = getFunctions(instance);
+    map<Function*, Function*> correspondence;
+
+    if (refFunctions.size() != functions.size()){
+        return false;
+    }
+
+    for (unsigned i = 0; i < refFunctions.size(); i++){
+        if ((refFunctions[i] == NULL) != (functions[i] == NULL)){
+            return false;
+        }
+
+        if (refFunctions[i] != NULL){
+            correspondence[refFunctions[i]] = functions[i];
+        }
+    }
+
+    for (unsigned i = 0; i < refFunctions.size(); i++){
+        if (refFunctions[i] != NULL && !matchFunction(refFunctions[i], functions[i], &correspondence, globals)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool InstanceSharing::matchFunction(Function* reference, Function* function, map<Function*, Function*>* functions, GlobalMap* globals){
+    if (reference->isDeclaration() || function->isDeclaration()
+            || reference->getFunctionType() != function->getFunctionType()
+            || reference->size() != function->size()){
+        return false;
+    }
+
+    map<Value*, Value*> locals;
+    Function::iterator itRefBB, itBB;
+    BasicBlock::iterator itRefInst, itInst;
+    Function::arg_iterator itRefArg, itArg;
+
+    // Arguments, blocks and instructions correspond by their position
+    for (itRefArg = reference->arg_begin(), itArg = function->arg_begin(); itRefArg != reference->arg_end(); itRefArg++, itArg++){
+        locals[itRefArg] = itArg;
+    }
+
+    for (itRefBB = reference->begin(), itBB = function->begin(); itRefBB != reference->end(); itRefBB++, itBB++){
+        if (itRefBB->size() != itBB->size()){
+            return false;
+        }
+
+        locals[itRefBB] = itBB;
+
+        for (itRefInst = itRefBB->begin(), itInst = itBB->begin(); itRefInst != itRefBB->end(); itRefInst++, itInst++){
+            locals[itRefInst] = itInst;
+        }
+    }
+
+    for (itRefBB = reference->begin(), itBB = function->begin(); itRefBB != reference->end(); itRefBB++, itBB++){
+        for (itRefInst = itRefBB->begin(), itInst = itBB->begin(); itRefInst != itRefBB->end(); itRefInst++, itInst++){
+            Instruction* refInst = itRefInst;
+            Instruction* inst = itInst;
+
+            if (!refInst->isSameOperationAs(inst) || refInst->getNumOperands() != inst->getNumOperands()){
+                return false;
+            }
+
+            for (unsigned i = 0; i < refInst->getNumOperands(); i++){
+                if (!matchValue(refInst->getOperand(i), inst->getOperand(i), &locals, functions, globals)){
+                    return false;
+                }
+            }
+
+            // Incoming blocks of phi nodes are not operands
+            if (PHINode* refPhi = dyn_cast<PHINode>(refInst)){
+                PHINode* phi = cast<PHINode>(inst);
+
+                for (unsigned i = 0; i < refPhi->getNumIncomingValues(); i++){
+                    if (locals[refPhi->getIncomingBlock(i)] != phi->getIncomingBlock(i)){
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool InstanceSharing::matchValue(Value* reference, Value* value, map<Value*, Value*>* locals,
+                                 map<Function*, Function*>* functions, GlobalMap* globals){
+    map<Value*, Value*>::iterator itLocal = locals->find(reference);
+
+    if (itLocal != locals->end()){
+        return itLocal->second == value;
+    }
+
+    if (Function* refFunction = dyn_cast<Function>(reference)){
+        map<Function*, Function*>::iterator itFunction = functions->find(refFunction);
+
+        if (itFunction != functions->end()){
+            return itFunction->second == value;
+        }
+
+        return reference == value;
+    }
+
+    // A global already mapped only matches its mapping, even the global itself
+    if (isa<GlobalVariable>(reference) && isa<GlobalVariable>(value)){
+        GlobalValue* refGV = cast<GlobalValue>(reference);
+        GlobalValue* GV = cast<GlobalValue>(value);
+        GlobalMap::iterator itGlobal = globals->find(refGV);
+
+        if (itGlobal != globals->end()){
+            return itGlobal->second == GV;
+        }
+
+        if (refGV->getType() != GV->getType()){
+            return false;
+        }
+
+        globals->insert(pair<GlobalValue*, GlobalValue*>(refGV, GV));
+        return true;
+    }
+
+    if (reference == value){
+        return true;
+    }
+
+    if (isa<ConstantExpr>(reference) && isa<ConstantExpr>(value)){
+        ConstantExpr* refExpr = cast<ConstantExpr>(reference);
+        ConstantExpr* expr = cast<ConstantExpr>(value);
+
+        if (refExpr->getOpcode() != expr->getOpcode() || refExpr->getType() != expr->getType()
+                || refExpr->getNumOperands() != expr->getNumOperands()
+                || refExpr->getRawSubclassOptionalData() != expr->getRawSubclassOptionalData()
+                || (refExpr->isCompare() && refExpr->getPredicate() != expr->getPredicate())){
+            return false;
+        }
+
+        for (unsigned i = 0; i < refExpr->getNumOperands(); i++){
+            if (!matchValue(refExpr->getOperand(i), expr->getOperand(i), locals, functions, globals)){
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Debugging information does not change the code
+    return isa<MDNode>(reference) && isa<MDNode>(value);
+}
+
+void InstanceSharing::share(Group* group){
+    Instance* reference = group->reference;
+    LLVMContext& Context = module->getContext();
+    map<GlobalValue*, int> entries;
+    vector<GlobalValue*> entryList;
+    vector<Type*> entryTypes;
+
+    list<Instance*>::iterator it;
+    GlobalMap::iterator itGlobal;
+
+    // Globals of the reference that are different in another instance go in the context
+    for (it = group->instances.begin(); it != group->instances.end(); it++){
+        if (*it == reference){
+            continue;
+        }
+
+        GlobalMap* globals = &group->globals[*it];
+
+        for (itGlobal = globals->begin(); itGlobal != globals->end(); itGlobal++){
+            if (itGlobal->first != itGlobal->second && entries.find(itGlobal->first) == entries.end()){
+                entries.insert(pair<GlobalValue*, int>(itGlobal->first, entryList.size()));
+                entryList.push_back(itGlobal->first);
+                entryTypes.push_back(itGlobal->first->getType());
+            }
+        }
+    }
+
+    StructType* contextTy = StructType::get(Context, entryTypes);
+
+    // Copy the functions of the reference once
+    vector<Function*> refFunctions = getFunctions(reference);
+    map<Function*, Function*> sharedFunctions;
+    map<Function*, Function*>::iterator itShared;
+    ActionScheduler::SharedCode* sharedCode = new ActionScheduler::SharedCode();
+    sharedCode->users = group->instances.size();
+
+    for (unsigned i = 0; i < refFunctions.size(); i++){
+        if (refFunctions[i] != NULL){
+            sharedFunctions[refFunctions[i]] = createShared(refFunctions[i], contextTy);
+            sharedCode->functions.push_back(sharedFunctions[refFunctions[i]]);
+        }
+    }
+
+    for (itShared = sharedFunctions.begin(); itShared != sharedFunctions.end(); itShared++){
+        useContext(itShared->second, &entries, &sharedFunctions);
+    }
+
+    // Each instance calls the shared code with its own context
+    for (it = group->instances.begin(); it != group->instances.end(); it++){
+        Instance* instance = *it;
+        vector<Constant*> values;
+
+        for (unsigned i = 0; i < entryList.size(); i++){
+            GlobalValue* value = entryList[i];
+
+            if (instance != reference){
+                value = group->globals[instance][entryList[i]];
+            }
+
+            values.push_back(value);
+        }
+
+        GlobalVariable* context = new GlobalVariable(*module, contextTy, true, GlobalValue::InternalLinkage,
+                                                     ConstantStruct::get(contextTy, values), instance->getId() + "_context");
+        instance->getActionScheduler()->setContext(context);
+        instance->getActionScheduler()->setSharedCode(sharedCode);
+
+        vector<Function*> functions = getFunctions(instance);
+
+        for (unsigned i = 0; i < functions.size(); i++){
+            if (functions[i] != NULL){
+                createWrapper(functions[i], sharedFunctions[refFunctions[i]], context);
+            }
+        }
+    }
+
+    if (verbose){
+        cout << "Instances of " << reference->getActor()->getName() << " share their code (" << entryList.size() << " globals in context) :";
+
+        for (it = group->instances.begin(); it != group->instances.end(); it++){
+            cout << " " << (*it)->getId();
+        }
+
+        cout << "\n";
+    }
+}
+
+Function* InstanceSharing::createShared(Function* function, StructType* contextTy){
+    vector<Type*> params;
+    params.push_back(PointerType::getUnqual(contextTy));
+
+    Function::arg_iterator itArg;
+    for (itArg = function->arg_begin(); itArg != function->arg_end(); itArg++){
+        params.push_back(itArg->getType());
+    }
+
+    FunctionType* FT = FunctionType::get(function->getReturnType(), params, function->isVarArg());
+    Function* shared = Function::Create(FT, GlobalValue::InternalLinkage, function->getName() + "_shared", module);
+
+    ValueToValueMapTy VMap;
+    Function::arg_iterator itShared = shared->arg_begin();
+    itShared->setName("context");
+    itShared++;
+
+    for (itArg = function->arg_begin(); itArg != function->arg_end(); itArg++, itShared++){
+        itShared->setName(itArg->getName());
+        VMap[itArg] = itShared;
+    }
+
+    SmallVector<ReturnInst*, 8> returns;
+    CloneFunctionInto(shared, function, VMap, false, returns);
+
+    // Keep a single copy of the code
+    shared->setLinkage(GlobalValue::InternalLinkage);
+    shared->addFnAttr(Attribute::NoInline);
+
+    return shared;
+}
+
+void InstanceSharing::useContext(Function* shared, map<GlobalValue*, int>* entries, map<Function*, Function*>* functions){
+    expandConstants(shared, entries);
+
+    LLVMContext& Context = module->getContext();
+    Value* context = shared->arg_begin();
+    Instruction* pos = &*shared->getEntryBlock().getFirstInsertionPt();
+    map<int, Value*> loads;
+    list<Instruction*> instructions;
+    list<Instruction*>::iterator it;
+
+    for (inst_iterator I = inst_begin(shared), E = inst_end(shared); I != E; ++I){
+        instructions.push_back(&*I);
+    }
+
+    for (it = instructions.begin(); it != instructions.end(); it++){
+        Instruction* inst = *it;
+
+        // Globals of the instance are loaded from the context at the entry of the function
+        for (unsigned i = 0; i < inst->getNumOperands(); i++){
+            GlobalValue* GV = dyn_cast<GlobalValue>(inst->getOperand(i));
+
+            if (GV == NULL || entries->find(GV) == entries->end()){
+                continue;
+            }
+
+            int index = (*entries)[GV];
+            map<int, Value*>::iterator itLoad = loads.find(index);
+
+            if (itLoad == loads.end()){
+                Value* idxs[] = {ConstantInt::get(Type::getInt32Ty(Context), 0), ConstantInt::get(Type::getInt32Ty(Context), index)};
+                GetElementPtrInst* gep = GetElementPtrInst::Create(context, idxs, "", pos);
+                LoadInst* load = new LoadInst(gep, GV->getName(), pos);
+                itLoad = loads.insert(pair<int, Value*>(index, load)).first;
+            }
+
+            inst->setOperand(i, itLoad->second);
+        }
+
+        // Functions of the instance are called through their shared copies
+        if (CallInst* call = dyn_cast<CallInst>(inst)){
+            Function* callee = call->getCalledFunction();
+            map<Function*, Function*>::iterator itFunction;
+
+            if (callee == NULL || (itFunction = functions->find(callee)) == functions->end()){
+                continue;
+            }
+
+            vector<Value*> args;
+            args.push_back(context);
+
+            for (unsigned i = 0; i < call->getNumArgOperands(); i++){
+                args.push_back(call->getArgOperand(i));
+            }
+
+            CallInst* newCall = CallInst::Create(itFunction->second, args, "", call);
+            newCall->takeName(call);
+            call->replaceAllUsesWith(newCall);
+            call->eraseFromParent();
+        }
+    }
+}
+
+void InstanceSharing::expandConstants(Function* shared, map<GlobalValue*, int>* entries){
+    list<Instruction*> instructions;
+    list<Instruction*>::iterator it;
+
+    for (inst_iterator I = inst_begin(shared), E = inst_end(shared); I != E; ++I){
+        instructions.push_back(&*I);
+    }
+
+    for (it = instructions.begin(); it != instructions.end(); it++){
+        Instruction* inst = *it;
+
+        for (unsigned i = 0; i < inst->getNumOperands(); i++){
+            ConstantExpr* expr = dyn_cast<ConstantExpr>(inst->getOperand(i));
+
+            if (expr == NULL || !usesEntries(expr, entries)){
+                continue;
+            }
+
+            // Values of phi nodes must be available at the end of the incoming block
+            Instruction* pos = inst;
+            if (PHINode* phi = dyn_cast<PHINode>(inst)){
+                pos = phi->getIncomingBlock(i)->getTerminator();
+            }
+
+            inst->setOperand(i, expandConstant(expr, pos, entries));
+        }
+    }
+}
+
+Value* InstanceSharing::expandConstant(Constant* constant, Instruction* pos, map<GlobalValue*, int>* entries){
+    Instruction* inst = cast<ConstantExpr>(constant)->getAsInstruction();
+
+    for (unsigned i = 0; i < inst->getNumOperands(); i++){
+        ConstantExpr* expr = dyn_cast<ConstantExpr>(inst->getOperand(i));
+
+        if (expr != NULL && usesEntries(expr, entries)){
+            inst->setOperand(i, expandConstant(expr, pos, entries));
+        }
+    }
+
+    inst->insertBefore(pos);
+
+    return inst;
+}
+
+bool InstanceSharing::usesEntries(Constant* constant, map<GlobalValue*, int>* entries){
+    if (GlobalValue* GV = dyn_cast<GlobalValue>(constant)){
+        return entries->find(GV) != entries->end();
+    }
+
+    for (unsigned i = 0; i < constant->getNumOperands(); i++){
+        Constant* operand = dyn_cast<Constant>(constant->getOperand(i));
+
+        if (operand != NULL && usesEntries(operand, entries)){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void InstanceSharing::createWrapper(Function* function, Function* shared, GlobalVariable* context){
+    LLVMContext& Context = module->getContext();
+    GlobalValue::LinkageTypes linkage = function->getLinkage();
+
+    function->deleteBody();
+    function->setLinkage(linkage);
+
+    BasicBlock* BB = BasicBlock::Create(Context, "entry", function);
+    vector<Value*> args;
+    args.push_back(context);
+
+    Function::arg_iterator itArg;
+    for (itArg = function->arg_begin(); itArg != function->arg_end(); itArg++){
+        args.push_back(itArg);
+    }
+
+    CallInst* call = CallInst::Create(shared, args, "", BB);
+
+    if (function->getReturnType()->isVoidTy()){
+        ReturnInst::Create(Context, BB);
+    }else{
+        ReturnInst::Create(Context, call, BB);
+    }
+}
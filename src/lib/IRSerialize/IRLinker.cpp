@@ -108,6 +108,7 @@ void IRLinker::linkPorts(map<string, Port*>* refPorts, map<string, Port*>* ports
 
             port->setPtrVar(refPort->getPtrVar());
             port->setFifoVar(refPort->getFifoVar());
+            port->setAccessors(refPort->getOpenFn(), refPort->getCloseFn());
         }
 
     }
@@ -37,6 +37,7 @@
 
 //------------------------------
 #include <map>
+#include <vector>
 #include <iostream>
 
 #include "llvm/IR/Constants.h"
@@ -87,10 +88,10 @@ const string IRConstant::KEY_STATE_VARS= "state_variables";
 const string IRConstant::KEY_MOC= "MoC";
 
 
-IRParser::IRParser(llvm::LLVMContext& C, string VTLDir) : Context(C){
+IRParser::IRParser(llvm::LLVMContext& C, string VTLDir, bool verbose) : Context(C){
     this->inputs = NULL;
     this->outputs = NULL;
-    this->parser =  new LLVMParser(Context, VTLDir);
+    this->parser =  new LLVMParser(Context, VTLDir, verbose);
     this->VTLDir = VTLDir;
 }
 
@@ -109,6 +110,36 @@ Actor* IRParser::parseActor(string classz){
         exit(1);
     }
 
+    return parseActor(classz, module);
+}
+
+map<string, Actor*>* IRParser::parseActors(list<string>* classzs, int nbThreads){
+    list<string>::iterator it;
+    vector<pair<Package*, string> > files;
+    map<string, Actor*>* parsedActors = new map<string, Actor*>();
+
+    //Get files and packages of the actors
+    for (it = classzs->begin(); it != classzs->end(); it++){
+        string file = PackageMng::getSimpleName(*it);
+        string packageName = PackageMng::getPackagesName(*it);
+        Package* package = PackageMng::getPackage(packageName);
+
+        files.push_back(pair<Package*, string>(package, file));
+    }
+
+    //Parse the bitcodes
+    vector<Module*> modules = parser->loadModules(&files, nbThreads);
+
+    //Actors are created one after the other in the context of the decoder
+    vector<Module*>::iterator itModule = modules.begin();
+    for (it = classzs->begin(); it != classzs->end(); it++, itModule++){
+        parsedActors->insert(pair<string, Actor*>(*it, parseActor(*it, *itModule)));
+    }
+
+    return parsedActors;
+}
+
+Actor* IRParser::parseActor(string classz, Module* module){
     //Empty action list
     actions.clear();
     untaggedActions.clear();
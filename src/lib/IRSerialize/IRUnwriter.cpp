@@ -42,6 +42,7 @@
 #include "lib/IRCore/Port.h"
 #include "lib/IRSerialize/IRUnwriter.h"
 
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/Module.h"
 
 #include "IRConstant.h"
@@ -66,11 +67,23 @@ int IRUnwriter::remove(Instance* instance){
         scheduler->removeInstance(instance);
     }
 
+    //Context of shared code refers to the variables of the instance, it goes first
+    ActionScheduler* actionScheduler = instance->getActionScheduler();
+    GlobalVariable* context = actionScheduler->getContext();
+    if (context != NULL){
+        //Only the functions of the instance, removed below, use the context
+        context->replaceAllUsesWith(UndefValue::get(context->getType()));
+        context->eraseFromParent();
+        actionScheduler->setContext(NULL);
+    }
+
     //Remove all elements of the instance
-    unwriteActionScheduler(instance->getActionScheduler());
+    unwriteActionScheduler(actionScheduler);
     unwriteActions(instance->getActions());
     unwriteInitializes(instance->getInitializes());
     unwriteProcedures(instance->getProcs());
+    unwriteSharedCode(actionScheduler);
+
     unwriteStateVariables(instance->getStateVars());
     unwriteVariables(instance->getParameters());
     unwritePorts(IRConstant::KEY_INPUTS, instance->getInputs());
@@ -95,6 +108,27 @@ void IRUnwriter::unwriteActionScheduler(ActionScheduler* actionScheduler){
     }
 }
 
+void IRUnwriter::unwriteSharedCode(ActionScheduler* actionScheduler){
+    ActionScheduler::SharedCode* sharedCode = actionScheduler->getSharedCode();
+    actionScheduler->setSharedCode(NULL);
+
+    if (sharedCode == NULL || --sharedCode->users > 0){
+        return;
+    }
+
+    //Shared copies call each other, references are dropped before removal
+    list<Function*>::iterator it;
+    for (it = sharedCode->functions.begin(); it != sharedCode->functions.end(); it++){
+        (*it)->dropAllReferences();
+    }
+
+    for (it = sharedCode->functions.begin(); it != sharedCode->functions.end(); it++){
+        (*it)->eraseFromParent();
+    }
+
+    delete sharedCode;
+}
+
 void IRUnwriter::unwriteFSM(FSM* fsm){
 
     //Remove the FSM state var
@@ -37,9 +37,13 @@
 
 //------------------------------
 #include <iostream>
+#include <set>
 
 #include "lib/RVCEngine/Decoder.h"
 #include "lib/IRCore/Port.h"
+#include "lib/IRCore/Variable.h"
+#include "lib/IRCore/Actor/ActionScheduler.h"
+#include "lib/IRCore/Actor/FSM.h"
 #include "lib/IRCore/MoC/CSDFMoC.h"
 #include "lib/IRCore/MoC/SDFMoC.h"
 #include "lib/IRCore/MoC/QSDFMoC.h"
@@ -49,7 +53,13 @@
 #include "lib/IRSerialize/IRWriter.h"
 #include "lib/IRUtil/FunctionMng.h"
 
+#include "llvm/Analysis/ConstantFolding.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Transforms/Utils/Local.h"
 
 #include "IRConstant.h"
 //------------------------------
@@ -57,6 +67,10 @@
 using namespace std;
 using namespace llvm;
 
+cl::opt<bool> SpecializeParams("specialize-params",
+                               cl::desc("Fold the parameter values of each instance into its code"),
+                               cl::init(false));
+
 IRWriter::IRWriter(LLVMContext& C, Decoder* decoder): Context(C){
     this->decoder = decoder;
 }
@@ -134,6 +148,7 @@ void IRWriter::writeInstance(Instance* instance){
     list<Action*>* actions = writeActions(actor->getActions());
     actionScheduler = writeActionScheduler(actor->getActionScheduler());
     MoC* moc = writeMoC(actor->getMoC());
+    linkProcedures(actor->getProcs(), procs);
 
     //Set properties of the instance
     instance->setActions(actions);
@@ -146,6 +161,195 @@ void IRWriter::writeInstance(Instance* instance){
 
     //Resolve paramaters of this instance
     instance->solveParameters();
+
+    if (SpecializeParams){
+        specializeParameters(actions, moc);
+    }
+}
+
+void IRWriter::specializeParameters(list<Action*>* actions, MoC* moc){
+    // Parameters are never assigned, loads of them fold to the values of this instance
+    map<string, Variable*>::iterator itParam;
+
+    for (itParam = parameters->begin(); itParam != parameters->end(); itParam++){
+        itParam->second->getGlobalVariable()->setConstant(true);
+    }
+
+    set<Function*> functions;
+    list<Action*>::iterator itAction;
+    map<string, Procedure*>::iterator itProc;
+
+    for (itAction = actions->begin(); itAction != actions->end(); itAction++){
+        functions.insert((*itAction)->getScheduler()->getFunction());
+        functions.insert((*itAction)->getBody()->getFunction());
+    }
+
+    for (itAction = initializes->begin(); itAction != initializes->end(); itAction++){
+        functions.insert((*itAction)->getScheduler()->getFunction());
+        functions.insert((*itAction)->getBody()->getFunction());
+    }
+
+    for (itProc = procs->begin(); itProc != procs->end(); itProc++){
+        if (!itProc->second->isExternal()){
+            functions.insert(itProc->second->getFunction());
+        }
+    }
+
+    set<Function*>::iterator itFunction;
+    for (itFunction = functions.begin(); itFunction != functions.end(); itFunction++){
+        while (foldConstants(*itFunction));
+    }
+
+    // Static MoCs refer to all the actions of the instance
+    if (moc == NULL || !moc->isDPN()){
+        return;
+    }
+
+    set<Action*> deads;
+
+    for (itAction = actions->begin(); itAction != actions->end(); itAction++){
+        Function* guard = (*itAction)->getScheduler()->getFunction();
+        bool dead = true;
+        bool returns = false;
+
+        for (inst_iterator I = inst_begin(guard), E = inst_end(guard); I != E && dead; ++I){
+            if (ReturnInst* ret = dyn_cast<ReturnInst>(&*I)){
+                ConstantInt* value = dyn_cast_or_null<ConstantInt>(ret->getReturnValue());
+                dead = value != NULL && value->isZero();
+                returns = true;
+            }
+        }
+
+        if (dead && returns){
+            deads.insert(*itAction);
+        }
+    }
+
+    if (!deads.empty()){
+        removeActions(actions, &deads);
+    }
+}
+
+bool IRWriter::foldConstants(Function* function){
+    bool changed = false;
+    list<Instruction*> worklist;
+    set<Instruction*> pending;
+
+    for (inst_iterator I = inst_begin(function), E = inst_end(function); I != E; ++I){
+        worklist.push_back(&*I);
+        pending.insert(&*I);
+    }
+
+    // Propagate constants until no instruction folds
+    while (!worklist.empty()){
+        Instruction* inst = worklist.front();
+        worklist.pop_front();
+
+        // Instructions erased while in the worklist are skipped
+        if (pending.erase(inst) == 0){
+            continue;
+        }
+
+        Constant* value = ConstantFoldInstruction(inst);
+        if (value == NULL){
+            continue;
+        }
+
+        Value::use_iterator itUse;
+        for (itUse = inst->use_begin(); itUse != inst->use_end(); itUse++){
+            Instruction* user = cast<Instruction>(itUse->getUser());
+
+            if (pending.insert(user).second){
+                worklist.push_back(user);
+            }
+        }
+
+        inst->replaceAllUsesWith(value);
+        inst->eraseFromParent();
+        changed = true;
+    }
+
+    // Branches on constant conditions and the blocks they no longer reach
+    Function::iterator itBB;
+    for (itBB = function->begin(); itBB != function->end(); itBB++){
+        changed |= ConstantFoldTerminator(itBB, true);
+    }
+
+    changed |= removeUnreachableBlocks(*function);
+
+    return changed;
+}
+
+void IRWriter::removeActions(list<Action*>* actions, set<Action*>* deads){
+    list<Action*>::iterator itAction;
+    list<Action*>* lists[2] = {actions, actionScheduler->getActions()};
+
+    // Lists are filtered once for all the actions removed
+    for (int i = 0; i < 2; i++){
+        for (itAction = lists[i]->begin(); itAction != lists[i]->end();){
+            if (deads->find(*itAction) != deads->end()){
+                itAction = lists[i]->erase(itAction);
+            }else{
+                itAction++;
+            }
+        }
+    }
+
+    // Transitions of the fsm taken by these actions
+    FSM* fsm = actionScheduler->getFsm();
+    if (fsm != NULL){
+        map<string, FSM::Transition*>::iterator itTransition;
+        map<string, FSM::Transition*>* transitions = fsm->getTransitions();
+
+        for (itTransition = transitions->begin(); itTransition != transitions->end(); itTransition++){
+            list<FSM::NextStateInfo*>::iterator itNext;
+            list<FSM::NextStateInfo*>* nextStates = itTransition->second->getNextStateInfo();
+
+            for (itNext = nextStates->begin(); itNext != nextStates->end();){
+                if (deads->find((*itNext)->getAction()) != deads->end()){
+                    delete *itNext;
+                    itNext = nextStates->erase(itNext);
+                }else{
+                    itNext++;
+                }
+            }
+        }
+    }
+
+    map<Action*, Action*>::iterator itUntagged;
+    for (itUntagged = untaggedActions.begin(); itUntagged != untaggedActions.end();){
+        if (deads->find(itUntagged->second) != deads->end()){
+            untaggedActions.erase(itUntagged++);
+        }else{
+            itUntagged++;
+        }
+    }
+
+    set<Action*>::iterator itDead;
+    for (itDead = deads->begin(); itDead != deads->end(); itDead++){
+        Action* action = *itDead;
+        ActionTag* tag = action->getTag();
+
+        if (!tag->isEmpty()){
+            this->actions.erase(tag->getIdentifier());
+        }
+
+        // Nothing calls the action before the action scheduler is created
+        Function* guard = action->getScheduler()->getFunction();
+        Function* body = action->getBody()->getFunction();
+
+        if (guard->use_empty()){
+            guard->eraseFromParent();
+        }
+
+        if (body->use_empty()){
+            body->eraseFromParent();
+        }
+
+        // The tag belongs to the action of the actor
+        action->setTag(NULL);
+        delete action;
+    }
 }
 
 void IRWriter::writePortPtrs(map<string, Port*>* srcPorts, map<string, Port*>* dstPorts){
@@ -343,13 +547,43 @@ map<string, Procedure*>* IRWriter::writeProcedures(map<string, Procedure*>* proc
         newProcs->insert(pair<string, Procedure*>(proc->getName(), newProc));
     }
 
-    //Link body of the procedure
-    for (it = procs->begin(); it != procs->end(); ++it){
-        Procedure* proc = (*it).second;
-        writer->linkProcedureBody(proc->getFunction());
+    return newProcs;
+}
+
+void IRWriter::linkProcedures(map<string, Procedure*>* srcProcs, map<string, Procedure*>* procs){
+    map<string, Procedure*>::iterator it;
+    set<string> linked;
+    bool changed = true;
+
+    //Link body of the called procedures, a body may call other procedures
+    while (changed){
+        changed = false;
+
+        for (it = srcProcs->begin(); it != srcProcs->end(); ++it){
+            Procedure* proc = (*it).second;
+            Function* newFunction = (*procs)[it->first]->getFunction();
+
+            if (linked.find(it->first) != linked.end() || (!proc->isExternal() && newFunction->use_empty())){
+                continue;
+            }
+
+            writer->linkProcedureBody(proc->getFunction());
+            linked.insert(it->first);
+            changed = true;
+        }
     }
 
-    return newProcs;
+    //Remove procedures never called
+    for (it = srcProcs->begin(); it != srcProcs->end(); ++it){
+        if (linked.find(it->first) != linked.end()){
+            continue;
+        }
+
+        Procedure* proc = (*procs)[it->first];
+        proc->getFunction()->eraseFromParent();
+        procs->erase(it->first);
+        delete proc;
+    }
 }
 
 ActionScheduler* IRWriter::writeActionScheduler(ActionScheduler* actionScheduler){
@@ -49,6 +49,7 @@ using namespace llvm;
 
 //Initializing static element
 map<string, Package*>* PackageMng::packages = new map<string, Package*>();
+pthread_mutex_t PackageMng::packagesLock = PTHREAD_MUTEX_INITIALIZER;
 
 
 string PackageMng::getFolder(Actor* actor){
@@ -146,6 +147,9 @@ Package* PackageMng::getPackage(string name){
     map<string, Package*>* packagesPtr = packages;
     Package* package = NULL;
 
+    //Actors of different contexts are parsed at the same time
+    pthread_mutex_lock(&packagesLock);
+
     //Iterate though the current package hierarchy
     for (itStrPack = packageStrs.begin(); itStrPack != packageStrs.end(); itStrPack++){
         itPack = packagesPtr->find(*itStrPack);
@@ -163,6 +167,8 @@ Package* PackageMng::getPackage(string name){
         packagesPtr = package->getChilds();
     }
 
+    pthread_mutex_unlock(&packagesLock);
+
     return package;
 }
 
@@ -39,22 +39,57 @@
 #include <list>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
 
+#include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Host.h"
 
 #include "lib/RVCEngine/Decoder.h"
 #include "lib/IRCore/Network.h"
+#include "lib/IRCore/Port.h"
+#include "lib/IRCore/Network/Connection.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/IRCore/Actor/Action.h"
+#include "lib/IRCore/Actor/ActionScheduler.h"
+#include "lib/IRMerger/SuperInstance.h"
 #include "lib/ConfigurationEngine/ConfigurationEngine.h"
 #include "lib/IRJit/LLVMExecution.h"
 #include "lib/IRJit/LLVMArmFix.h"
+#include "lib/IRJit/LLVMNative.h"
+#include "lib/IRJit/LLVMWorkStealing.h"
+#include "lib/IROptimize/InstanceSharing.h"
+#include "lib/RoundRobinScheduler/DataDrivenScheduler.h"
 #include "lib/RoundRobinScheduler/RoundRobinScheduler.h"
 //------------------------------
 
 using namespace llvm;
 using namespace std;
 
+extern cl::opt<std::string> SchedulerCounters;
+extern cl::opt<std::string> NativeOut;
+extern cl::opt<bool> NativeShared;
+
+cl::opt<bool> DataDriven("dd-scheduler",
+                         cl::desc("Use a data-driven scheduler instead of the round-robin scheduler"),
+                         cl::init(false));
+
+cl::opt<int> WorkStealingThreads("ws-threads",
+                                 cl::desc("Execute the decoder on N worker threads with work stealing (0 to disable)"),
+                                 cl::value_desc("N"),
+                                 cl::init(0));
+
+cl::opt<std::string> FifoProfileOut("fifo-profile-out",
+                                    cl::desc("Write the high-water marks of the fifos when the decoder stops"),
+                                    cl::value_desc("profile file"),
+                                    cl::init(""));
+
+cl::opt<bool> ShareActorCode("share-actor-code",
+                             cl::desc("Compile the actions once for all instances of an actor with the same parameters"),
+                             cl::init(false));
+
 Decoder::Decoder(LLVMContext& C, Configuration* configuration, bool verbose, bool armFix): Context(C){
 
     //Set property of the decoder
@@ -78,26 +113,55 @@ Decoder::Decoder(LLVMContext& C, Configuration* configuration, bool verbose, boo
     map<string, Partition*>* partitions = configuration->getPartitions();
 
     // Unpartitionned instance scheduler
-    scheduler = new RoundRobinScheduler(Context, this, configuration->getUnpartitioned(), configuration->mergeActors(), verbose);
+    scheduler = createScheduler(configuration->getUnpartitioned());
 
     // Partitionned instance scheduler
     for(itPartition = partitions->begin(); itPartition != partitions->end(); itPartition++){
         Partition* partition = itPartition->second;
-        Scheduler* procSchedul = new RoundRobinScheduler(Context, this, partition->getInstances(), configuration->mergeActors(), verbose);
+        Scheduler* procSchedul = createScheduler(partition->getInstances());
         procSchedulers.insert(pair<Partition*, Scheduler*>(partition, procSchedul));
     }
 
+    // Instances of a same actor call a single copy of its code
+    if (ShareActorCode){
+        InstanceSharing sharing(verbose);
+        sharing.transform(this);
+    }
+
     //Create execution engine
     if (armFix) {
         executionEngine = new LLVMArmFix(Context, this, verbose);
+    } else if (!NativeOut.empty()) {
+        executionEngine = new LLVMNative(Context, this, NativeOut, NativeShared, verbose);
+    } else if (WorkStealingThreads > 0) {
+        executionEngine = new LLVMWorkStealing(Context, this, WorkStealingThreads, verbose);
     } else {
         executionEngine = new LLVMExecution(Context, this, verbose);
     }
 }
 
+Scheduler* Decoder::createScheduler(list<Instance*>* instances){
+    if (DataDriven){
+        return new DataDrivenScheduler(Context, this, instances, configuration->mergeActors(), verbose);
+    }
+
+    return new RoundRobinScheduler(Context, this, instances, configuration->mergeActors(), verbose);
+}
+
 Decoder::~Decoder (){
+    map<Partition*, Scheduler*>::iterator it;
+    for (it = procSchedulers.begin(); it != procSchedulers.end(); it++){
+        delete it->second;
+    }
+
     delete scheduler;
-    delete module;
+
+    // The execution engine owns the module with the compiled code
+    if (executionEngine != NULL){
+        delete executionEngine;
+    }else{
+        delete module;
+    }
 }
 
 list<Procedure*> Decoder::getExternalProcs(){
@@ -156,6 +220,174 @@ void Decoder::run(){
     running = true;
     executionEngine->initialize();
     executionEngine->run();
+
+    // Report scheduling statistics if any
+    scheduler->printStatistics(executionEngine);
+
+    map<Partition*, Scheduler*>::iterator it;
+    for (it = procSchedulers.begin(); it != procSchedulers.end(); it++){
+        it->second->printStatistics(executionEngine);
+    }
+
+    if (!FifoProfileOut.empty()){
+        writeFifoProfile(FifoProfileOut);
+    }
+
+    if (SchedulerCounters.getNumOccurrences() > 0){
+        if (SchedulerCounters.empty()){
+            writeSchedulerCounters(cout, false);
+        }else{
+            ofstream countersFile(SchedulerCounters.c_str());
+
+            if (!countersFile.is_open()){
+                cerr << "Error opening scheduler counters file " << SchedulerCounters << endl;
+                exit(1);
+            }
+
+            writeSchedulerCounters(countersFile, true);
+        }
+    }
+}
+
+void Decoder::writeSchedulerCounters(ostream& out, bool json){
+    list<Instance*> counted;
+    list<Instance*>::iterator it;
+    map<string, Instance*>::iterator itInst;
+    map<string, Instance*>* instances = configuration->getInstances();
+
+    // Instances merged together keep the counters of their actions
+    for (itInst = instances->begin(); itInst != instances->end(); itInst++){
+        Instance* instance = itInst->second;
+        counted.push_back(instance);
+
+        if (instance->isSuperInstance()){
+            map<Instance*, int>::iterator itSub;
+            map<Instance*, int>* subInstances = ((SuperInstance*)instance)->getInstances();
+
+            for (itSub = subInstances->begin(); itSub != subInstances->end(); itSub++){
+                counted.push_back(itSub->first);
+            }
+        }
+    }
+
+    if (json){
+        out << "{\"instances\": [";
+    }else{
+        out << left << setw(40) << "instance / action" << right << setw(12) << "calls" << setw(12) << "idle"
+            << setw(12) << "starved" << setw(12) << "full" << setw(12) << "firings" << endl;
+    }
+
+    for (it = counted.begin(); it != counted.end(); it++){
+        Instance* instance = *it;
+        ActionScheduler* actionScheduler = instance->getActionScheduler();
+        GlobalVariable* counters = actionScheduler->getCounters();
+        long long values[ActionScheduler::NB_COUNTERS] = {0, 0, 0, 0};
+
+        if (counters != NULL && executionEngine->isCompiledGV(counters)){
+            long long* compiled = (long long*)executionEngine->getGVPtr(counters);
+            for (int i = 0; i < ActionScheduler::NB_COUNTERS; i++){
+                values[i] = compiled[i];
+            }
+        }
+
+        if (json){
+            out << (it == counted.begin() ? "" : ",") << "\n  {\"id\": \"" << instance->getId() << "\""
+                << ", \"calls\": " << values[ActionScheduler::CALLS]
+                << ", \"idle\": " << values[ActionScheduler::IDLE]
+                << ", \"starved\": " << values[ActionScheduler::STARVED]
+                << ", \"full\": " << values[ActionScheduler::FULL]
+                << ", \"actions\": {";
+        }else{
+            out << left << setw(40) << instance->getId() << right
+                << setw(12) << values[ActionScheduler::CALLS] << setw(12) << values[ActionScheduler::IDLE]
+                << setw(12) << values[ActionScheduler::STARVED] << setw(12) << values[ActionScheduler::FULL] << endl;
+        }
+
+        // Firings of the actions of the instance
+        list<Action*>* actions = instance->getActions();
+        bool first = true;
+
+        if (actions != NULL){
+            list<Action*>::iterator itAction;
+            for (itAction = actions->begin(); itAction != actions->end(); itAction++){
+                GlobalVariable* firings = actionScheduler->getFirings(*itAction);
+
+                if (firings == NULL || !executionEngine->isCompiledGV(firings)){
+                    continue;
+                }
+
+                long long value = *(long long*)executionEngine->getGVPtr(firings);
+
+                if (json){
+                    out << (first ? "" : ", ") << "\"" << (*itAction)->getName() << "\": " << value;
+                }else{
+                    out << "  " << left << setw(86) << (*itAction)->getName() << right << setw(12) << value << endl;
+                }
+
+                first = false;
+            }
+        }
+
+        if (json){
+            out << "}}";
+        }
+    }
+
+    if (json){
+        out << "\n]}" << endl;
+    }
+}
+
+void Decoder::writeFifoProfile(string file){
+    ofstream profileFile(file.c_str());
+
+    if (!profileFile.is_open()){
+        cerr << "Error opening fifo profile " << file << endl;
+        exit(1);
+    }
+
+    HDAGGraph* graph = configuration->getNetwork()->getGraph();
+    int edges = graph->getNbEdges();
+
+    for (int i = 0; i < edges; i++){
+        Connection* connection = (Connection*)graph->getEdge(i);
+        Port* srcPort = connection->getSourcePort();
+        Port* dstPort = connection->getDestinationPort();
+        GlobalVariable* highWater = srcPort->getHighWater();
+
+        if (highWater == NULL || srcPort->getInstance() == NULL || dstPort->getInstance() == NULL){
+            continue;
+        }
+
+        if (!executionEngine->isCompiledGV(highWater)){
+            continue;
+        }
+
+        int* value = (int*)executionEngine->getGVPtr(highWater);
+
+        profileFile << srcPort->getInstance()->getId() << " " << srcPort->getName() << " "
+                    << dstPort->getInstance()->getId() << " " << dstPort->getName() << " "
+                    << *value << " " << connection->getSize() << endl;
+    }
+}
+
+bool Decoder::isQuiescent(){
+    HDAGGraph* graph = configuration->getNetwork()->getGraph();
+    int edges = graph->getNbEdges();
+
+    for (int i = 0; i < edges; i++){
+        Fifo* fifo = ((Connection*)graph->getEdge(i))->getFifo();
+
+        if (fifo == NULL || !executionEngine->isCompiledGV(fifo->getGV())){
+            continue;
+        }
+
+        if (!fifo->isEmpty(executionEngine->getGVPtr(fifo->getGV()), executionEngine->getDataLayout())){
+            return false;
+        }
+    }
+
+    return true;
 }
 
 void Decoder::stop(){
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class HotReconfiguration
+@author agent
+@file HotReconfiguration.cpp
+@version 1.0
+@date 18/10/2026
+*/
+
+//------------------------------
+#include <chrono>
+#include <iostream>
+#include <unistd.h>
+
+#include "lib/RVCEngine/Decoder.h"
+#include "lib/RVCEngine/RVCEngine.h"
+#include "lib/RVCEngine/HotReconfiguration.h"
+#include "lib/IRCore/Network.h"
+#include "lib/IRJit/LLVMExecution.h"
+#include "lib/IRJit/LLVMObjectCache.h"
+#include "lib/IRJit/LLVMOptimizer.h"
+//------------------------------
+
+using namespace std;
+
+// Delay between two requests to pause the current decoder (in microseconds)
+static const int PAUSE_PERIOD = 1000;
+
+// Number of requests to pause the current decoder before stopping it
+static const int MAX_PAUSES = 1000;
+
+HotReconfiguration::HotReconfiguration(RVCEngine* engine, Decoder* decoder, Network* network, int optLevel, bool verbose){
+    this->engine = engine;
+    this->decoder = decoder;
+    this->network = network;
+    this->optLevel = optLevel;
+    this->verbose = verbose;
+    this->next = NULL;
+    this->started = false;
+    this->ready = false;
+    this->finished = false;
+    this->expired = false;
+}
+
+HotReconfiguration::~HotReconfiguration(){
+    finish();
+}
+
+void HotReconfiguration::start(){
+    if (started){
+        return;
+    }
+
+    started = true;
+    pthread_create(&thread, NULL, &HotReconfiguration::threadProc, this);
+}
+
+Decoder* HotReconfiguration::finish(){
+    if (started){
+        finished.store(true, memory_order_release);
+        pthread_join(thread, NULL);
+        started = false;
+    }
+
+    return next;
+}
+
+void* HotReconfiguration::threadProc(void* args){
+    HotReconfiguration* reconfiguration = static_cast<HotReconfiguration*>(args);
+    reconfiguration->prepare();
+
+    return NULL;
+}
+
+void HotReconfiguration::prepare(){
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    // Build the whole decoder aside from the running one
+    next = engine->build(network);
+
+    if (optLevel > 0){
+        LLVMObjectCache* cache = next->getEE()->getObjectCache();
+        if (cache != NULL){
+            cache->setOptLevel(optLevel);
+        }
+
+        if (cache == NULL || !cache->hasObject()){
+            LLVMOptimizer opt(next);
+            opt.optimize(optLevel);
+        }
+    }
+
+    next->getEE()->compile();
+    ready.store(true, memory_order_release);
+
+    if (verbose){
+        cout << "--> Decoder of " << network->getName() << " prepared in background in : "
+             << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count() << " ms." << endl;
+    }
+
+    // Look for a quiescent point of the current decoder until the new one is taken
+    for (int i = 0; i < MAX_PAUSES; i++){
+        if (finished.load(memory_order_acquire)){
+            return;
+        }
+
+        decoder->getEE()->pause();
+        usleep(PAUSE_PERIOD);
+    }
+
+    // No quiescent point found, the current decoder is stopped as in a synchronous reconfiguration
+    if (!finished.load(memory_order_acquire)){
+        if (verbose){
+            cout << "--> No quiescent point found for " << network->getName() << ", current decoder stopped" << endl;
+        }
+
+        expired.store(true, memory_order_release);
+        decoder->getEE()->stop();
+    }
+}
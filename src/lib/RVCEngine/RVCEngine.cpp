@@ -37,19 +37,29 @@
 
 //------------------------------
 #include <time.h>
+#include <chrono>
 #include <iostream>
+#include <set>
+#include <sstream>
 
 #include "llvm/PassManager.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "lib/RVCEngine/Decoder.h"
+#include "lib/RVCEngine/HotReconfiguration.h"
 #include "lib/RVCEngine/RVCEngine.h"
 #include "lib/IRSerialize/IRParser.h"
 #include "lib/ConfigurationEngine/Configuration.h"
 #include "lib/IRCore/Port.h"
+#include "lib/IRCore/Expression.h"
 #include "lib/IRCore/Network.h"
+#include "lib/IRCore/Network/Instance.h"
 #include "lib/IRJit/LLVMUtility.h"
 #include "lib/IRJit/LLVMOptimizer.h"
 #include "lib/IRJit/LLVMExecution.h"
+#include "lib/IRJit/LLVMObjectCache.h"
+#include "lib/IROptimize/ActionInlining.h"
 #include "lib/IROptimize/FifoFnRemoval.h"
 #include "lib/IROptimize/InstanceInternalize.h"
 #include "llvm/IR/LegacyPassNameParser.h"
@@ -60,6 +70,28 @@ using namespace llvm;
 
 //extern cl::list<const PassInfo*, bool, PassNameParser> PassList;
 
+cl::opt<int> ParseThreads("parse-threads",
+                          cl::desc("Number of threads loading actor files (0 for one per core)"),
+                          cl::value_desc("N"),
+                          cl::init(0));
+
+cl::opt<bool> InlineActions("inline-actions",
+                            cl::desc("Inline actions and fifo accessors into the schedulers of the instances"),
+                            cl::init(true));
+
+cl::opt<bool> HotReconfigure("hot-reconfiguration",
+                             cl::desc("Prepare the new decoder of a reconfiguration in background and switch to it once the running decoder holds no token"),
+                             cl::init(false));
+
+cl::opt<int> DecoderPool("decoder-pool",
+                          cl::desc("Memory budget of the compiled decoders kept for the networks to come back (0 to disable)"),
+                          cl::value_desc("KB"),
+                          cl::init(0));
+
+extern cl::opt<bool> TieredJit;
+extern cl::opt<int> WorkStealingThreads;
+extern cl::opt<std::string> NativeOut;
+
 RVCEngine::RVCEngine(llvm::LLVMContext& C,
                      string library,
                      string outputDir,
@@ -71,18 +103,51 @@ RVCEngine::RVCEngine(llvm::LLVMContext& C,
     this->noMerging = noMerging;
     this->outputDir = outputDir;
     this->armFix = armFix;
+    this->poolMemory = 0;
 
-    //Load IR Parser
-    irParser = new IRParser(C, library);
+    //Load IR Parser of the engine context
+    irParsers.insert(pair<LLVMContext*, IRParser*>(&C, new IRParser(C, library, verbose)));
+
+    pthread_mutex_init(&parseLock, NULL);
 }
 
 RVCEngine::~RVCEngine(){
+    map<Decoder*, HotReconfiguration*>::iterator it;
+
+    for (it = reconfigurations.begin(); it != reconfigurations.end(); it++){
+        delete it->second;
+    }
+
+    map<string, Decoder*>::iterator itPool;
+    for (itPool = pool.begin(); itPool != pool.end(); itPool++){
+        delete itPool->second;
+    }
+
+    map<LLVMContext*, pthread_mutex_t*>::iterator itLock;
+    for (itLock = contextLocks.begin(); itLock != contextLocks.end(); itLock++){
+        pthread_mutex_destroy(itLock->second);
+        delete itLock->second;
+    }
+
+    pthread_mutex_destroy(&parseLock);
 
 }
 
 int RVCEngine::load(Network* network) {
+    Decoder* decoder = build(network);
+
+    //Insert decoder into the list of created decoders
+    decoders.insert(pair<Network*, Decoder*>(network, decoder));
+
+    return 0;
+}
+
+Decoder* RVCEngine::build(Network* network) {
     clock_t timer = clock ();
 
+    // The configuration transforms the network, the pool looks up decoders by the network as parsed
+    string identity = getIdentity(network);
+
     //Create the Configuration from the network
     Configuration* configuration = new Configuration(network, noMerging);
 
@@ -96,20 +161,26 @@ int RVCEngine::load(Network* network) {
         timer = clock ();
     }
 
-    //Create decoder
-    Decoder* decoder = new Decoder(Context, configuration, verbose, armFix);
+    //Create decoder in the context of its network
+    Decoder* decoder = new Decoder(getContext(network), configuration, verbose, armFix);
+    decoder->setIdentity(identity);
 
     if (verbose){
         cout << "--> Decoder created in : "<< (clock () - timer) * 1000 / CLOCKS_PER_SEC <<" ms." << endl;
         timer = clock ();
     }
 
-    //doOptimizeDecoder(decoder);
+    // Hot instances are optimized separately by the tiered compiler
+    if (InlineActions && !TieredJit){
+        doOptimizeDecoder(decoder);
 
-    //Insert decoder into the list of created decoders
-    decoders.insert(pair<Network*, Decoder*>(network, decoder));
+        if (verbose){
+            cout << "--> Decoder inlined in : "<< (clock () - timer) * 1000 / CLOCKS_PER_SEC <<" ms." << endl;
+            timer = clock ();
+        }
+    }
 
-    return 0;
+    return decoder;
 }
 
 int RVCEngine::unload(Network* network) {
@@ -122,6 +193,13 @@ int RVCEngine::unload(Network* network) {
         return 1;
     }
 
+    // The decoder prepared for this network is not needed anymore
+    map<Decoder*, HotReconfiguration*>::iterator itReconf = reconfigurations.find(it->second);
+    if (itReconf != reconfigurations.end()){
+        delete itReconf->second;
+        reconfigurations.erase(itReconf);
+    }
+
     decoders.erase(it);
 
     return 0;
@@ -164,7 +242,7 @@ int RVCEngine::verify(Network* network, std::string errorFile){
     return 0;
 }
 
-int RVCEngine::run(Network* network){
+int RVCEngine::run(Network* network, string input){
     map<Network*, Decoder*>::iterator it;
 
     it = decoders.find(network);
@@ -175,11 +253,59 @@ int RVCEngine::run(Network* network){
     }
 
     Decoder* decoder = it->second;
+
+    // A decoder prepared while the current one was idle replaces it right away
+    map<Decoder*, HotReconfiguration*>::iterator itReconf = reconfigurations.find(decoder);
+    if (itReconf != reconfigurations.end() && itReconf->second->isReady()){
+        decoder = switchDecoder(network);
+    }
+
+    decoder->getEE()->setInputFile(input);
     decoder->run();
 
+    // The decoder paused at a quiescent point, the prepared one takes over
+    while (decoder->getEE()->isPaused()){
+        decoder = switchDecoder(network);
+        decoder->getEE()->setInputFile(input);
+        decoder->run();
+    }
+
+    // The decoder has been stopped without pausing, the prepared one replaces it
+    itReconf = reconfigurations.find(decoder);
+    if (itReconf != reconfigurations.end() && itReconf->second->isExpired()){
+        switchDecoder(network);
+    }
+
     return 0;
 }
 
+Decoder* RVCEngine::switchDecoder(Network* network){
+    map<Network*, Decoder*>::iterator it = decoders.find(network);
+    map<Decoder*, HotReconfiguration*>::iterator itReconf = reconfigurations.find(it->second);
+    clock_t timer = clock ();
+
+    HotReconfiguration* reconfiguration = itReconf->second;
+    Decoder* decoder = reconfiguration->finish();
+
+    reconfigurations.erase(itReconf);
+    delete reconfiguration;
+
+    if (DecoderPool > 0){
+        keepDecoder(it->second);
+    }else{
+        it->second->stop();
+        delete it->second;
+    }
+
+    it->second = decoder;
+
+    if (verbose){
+        cout << "--> Decoder of " << network->getName() << " switched in : "<< (clock () - timer) * 1000 / CLOCKS_PER_SEC <<" ms." << endl;
+    }
+
+    return decoder;
+}
+
 int RVCEngine::optimize(Network* network, int optLevel){
     clock_t timer = clock ();
 
@@ -192,6 +318,17 @@ int RVCEngine::optimize(Network* network, int optLevel){
         return 1;
     }
 
+    // Optimized code of the decoder is already on disk
+    LLVMObjectCache* cache = it->second->getEE()->getObjectCache();
+    if (cache != NULL){
+        cache->setOptLevel(optLevel);
+
+        if (cache->hasObject()){
+            cout << "-> Cached code found for : " << network->getName() << ", optimization skipped" << endl;
+            return 0;
+        }
+    }
+
     cout << "-> Start optimization of : " << network->getName() << endl;
 
     LLVMOptimizer opt(it->second);
@@ -201,7 +338,7 @@ int RVCEngine::optimize(Network* network, int optLevel){
     return 0;
 }
 
-int RVCEngine::reconfigure(Network* oldNetwork, Network* newNetwork){
+int RVCEngine::reconfigure(Network* oldNetwork, Network* newNetwork, int optLevel){
     map<Network*, Decoder*>::iterator it;
 
     it = decoders.find(oldNetwork);
@@ -213,7 +350,71 @@ int RVCEngine::reconfigure(Network* oldNetwork, Network* newNetwork){
 
     Decoder* decoder = it->second;
 
+    // A previous reconfiguration of this decoder is applied first
+    map<Decoder*, HotReconfiguration*>::iterator itReconf = reconfigurations.find(decoder);
+    if (itReconf != reconfigurations.end()){
+        decoder = switchDecoder(oldNetwork);
+    }
+
+    // A decoder compiled for the new network only needs a reinit
+    Decoder* pooled = DecoderPool > 0 ? takeDecoder(newNetwork) : NULL;
+    if (pooled != NULL){
+        keepDecoder(decoder);
+
+        decoders.erase(oldNetwork);
+        decoders.insert(pair<Network*, Decoder*>(newNetwork, pooled));
+
+        return 0;
+    }
+
+    // Decoders whose main scheduler cannot be paused are reconfigured in place,
+    // the new decoder is only built aside when it has a context of its own
+    if (HotReconfigure && &getContext(newNetwork) != &decoder->getContext()
+        && !decoder->hasPartitions() && WorkStealingThreads == 0 && NativeOut.empty() && !armFix){
+        HotReconfiguration* reconfiguration = new HotReconfiguration(this, decoder, newNetwork, optLevel, verbose);
+        reconfigurations.insert(pair<Decoder*, HotReconfiguration*>(decoder, reconfiguration));
+        reconfiguration->start();
+
+        //Set the new decoder
+        decoders.erase(oldNetwork);
+        decoders.insert(pair<Network*, Decoder*>(newNetwork, decoder));
+
+        return 0;
+    }
+
+    // The current decoder is kept as is for its network to come back
+    if (DecoderPool > 0){
+        Decoder* next = build(newNetwork);
+        keepDecoder(decoder);
+
+        decoders.erase(oldNetwork);
+        decoders.insert(pair<Network*, Decoder*>(newNetwork, next));
+
+        if (optLevel > 0){
+            optimize(newNetwork, optLevel);
+        }
+
+        return 0;
+    }
+
+    // A network parsed in another context, or a decoder compiled by MCJIT, needs a decoder of its own
+    if (&getContext(newNetwork) != &decoder->getContext() || decoder->getEE()->isMCJIT()){
+        Decoder* next = build(newNetwork);
+        decoder->stop();
+        delete decoder;
+
+        decoders.erase(oldNetwork);
+        decoders.insert(pair<Network*, Decoder*>(newNetwork, next));
+
+        if (optLevel > 0){
+            optimize(newNetwork, optLevel);
+        }
+
+        return 0;
+    }
+
     //Create the new Configuration
+    string identity = getIdentity(newNetwork);
     Configuration* configuration = new Configuration(newNetwork);
 
     // Parsing actor and bound it to the new configuration
@@ -222,14 +423,134 @@ int RVCEngine::reconfigure(Network* oldNetwork, Network* newNetwork){
 
     // Set the new configuration
     decoder->setConfiguration(configuration);
+    decoder->setIdentity(identity);
 
     //Set the new decoder
-    decoders.erase(it);
+    decoders.erase(oldNetwork);
     decoders.insert(pair<Network*, Decoder*>(newNetwork, decoder));
 
     return 0;
 }
 
+LLVMContext& RVCEngine::getContext(Network* network){
+    LLVMContext* C = network->getContext();
+
+    if (C == NULL){
+        return Context;
+    }
+
+    return *C;
+}
+
+string RVCEngine::getIdentity(Network* network){
+    stringstream identity;
+    identity << network->getName();
+
+    // Instances with their actors and parameters
+    list<Instance*>::iterator it;
+    list<Instance*>* instances = network->getInstances();
+
+    for (it = instances->begin(); it != instances->end(); it++){
+        Instance* instance = *it;
+        identity << ";" << instance->getId() << "=" << instance->getClasz() << "(";
+
+        map<string, Expr*>::iterator itParam;
+        map<string, Expr*>* parameters = instance->getParameterValues();
+        for (itParam = parameters->begin(); itParam != parameters->end(); itParam++){
+            Expr* expr = itParam->second;
+            identity << "," << itParam->first << ":";
+
+            // Other constants are compared by their text, networks are parsed in their own context
+            if (expr->isIntExpr()){
+                identity << expr->evaluateAsInteger();
+            }else{
+                string text;
+                raw_string_ostream constant(text);
+                expr->getConstant()->print(constant);
+                identity << constant.str();
+            }
+        }
+
+        identity << ")";
+    }
+
+    // Connections between instances with their sizes
+    HDAGGraph* graph = network->getGraph();
+    for (int i = 0; i < graph->getNbEdges(); i++){
+        Connection* connection = (Connection*)graph->getEdge(i);
+        Port* src = connection->getSourcePort();
+        Port* dst = connection->getDestinationPort();
+
+        identity << ";";
+        if (src->getInstance() != NULL){
+            identity << src->getInstance()->getId();
+        }
+        identity << "." << src->getName() << ">";
+        if (dst->getInstance() != NULL){
+            identity << dst->getInstance()->getId();
+        }
+        identity << "." << dst->getName() << "[" << connection->getSize() << "]";
+    }
+
+    return identity.str();
+}
+
+void RVCEngine::keepDecoder(Decoder* decoder){
+    string identity = decoder->getIdentity();
+
+    // Stopping the decoder reinitializes its instances and fifos
+    decoder->stop();
+
+    map<string, Decoder*>::iterator it = pool.find(identity);
+    if (it != pool.end()){
+        poolMemory -= it->second->getEE()->getMemorySize();
+        poolOrder.remove(identity);
+        delete it->second;
+        pool.erase(it);
+    }
+
+    pool.insert(pair<string, Decoder*>(identity, decoder));
+    poolOrder.push_front(identity);
+    poolMemory += decoder->getEE()->getMemorySize();
+
+    // Delete least recently used decoders out of the budget
+    size_t budget = (size_t)DecoderPool * 1024;
+    while (poolMemory > budget && !poolOrder.empty()){
+        map<string, Decoder*>::iterator itLast = pool.find(poolOrder.back());
+        Decoder* last = itLast->second;
+
+        if (verbose){
+            cout << "--> Decoder of " << last->getConfiguration()->getNetwork()->getName() << " evicted from the pool." << endl;
+        }
+
+        poolMemory -= last->getEE()->getMemorySize();
+        poolOrder.pop_back();
+        pool.erase(itLast);
+        delete last;
+    }
+}
+
+Decoder* RVCEngine::takeDecoder(Network* network){
+    string identity = getIdentity(network);
+    map<string, Decoder*>::iterator it = pool.find(identity);
+
+    if (it == pool.end()){
+        return NULL;
+    }
+
+    Decoder* decoder = it->second;
+
+    if (verbose){
+        cout << "--> Decoder of " << network->getName() << " taken from the pool." << endl;
+    }
+
+    poolMemory -= decoder->getEE()->getMemorySize();
+    poolOrder.remove(identity);
+    pool.erase(it);
+
+    return decoder;
+}
+
 map<string, Actor*>* RVCEngine::parseActors(Configuration* Configuration) {
     list<string>::iterator it;
 
@@ -239,43 +560,74 @@ map<string, Actor*>* RVCEngine::parseActors(Configuration* Configuration) {
     //Get files requiered by the configuration
     list<string>* files = Configuration->getActorFiles();
 
-    //Iterate though files and parses actors if requiered
+    //Decoders of reconfigurations are built in background
+    pthread_mutex_lock(&parseLock);
+
+    //Actors are only shared between networks of the same context
+    LLVMContext* C = &getContext(Configuration->getNetwork());
+    map<string, Actor*>& contextActors = actors[C];
+
+    IRParser*& irParser = irParsers[C];
+    if (irParser == NULL){
+        irParser = new IRParser(*C, library, verbose);
+    }
+
+    pthread_mutex_t*& contextLock = contextLocks[C];
+    if (contextLock == NULL){
+        contextLock = new pthread_mutex_t;
+        pthread_mutex_init(contextLock, NULL);
+    }
+
+    pthread_mutex_unlock(&parseLock);
+
+    //Networks of different contexts are parsed at the same time
+    pthread_mutex_lock(contextLock);
+
+    //Check if actors have been already parsed before
+    list<string> missing;
+    set<string> requested;
     for ( it = files->begin(); it != files->end(); ++it ){
-        map<string, Actor*>::iterator itAct;
-
-        //Check if actor has been already parsed before
-        Actor* actor = NULL;
-        itAct = actors.find(*it);
-
-        if(itAct == actors.end()){
-            //Actor has not been parsed
-            actor = irParser->parseActor(*it);
-        }else{
-            //Actor has been parsed
-            actor = itAct->second;
+        if (contextActors.find(*it) == contextActors.end() && requested.insert(*it).second){
+            missing.push_back(*it);
         }
+    }
+
+    //Parse actors not parsed yet all together
+    if (!missing.empty()){
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        map<string, Actor*>* parsedActors = irParser->parseActors(&missing, ParseThreads);
+
+        //Insert all actors into the list of all parsed actor by the decoder engine
+        contextActors.insert(parsedActors->begin(), parsedActors->end());
+        delete parsedActors;
 
-        //Set actors as requiered by the configuration
-        configurationActors->insert(pair<string, Actor*>(*it, actor));
+        if (verbose){
+            cout << "---> " << missing.size() << " actors parsed in : "
+                 << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count() << " ms." << endl;
+        }
+    }
+
+    //Set actors as requiered by the configuration
+    for ( it = files->begin(); it != files->end(); ++it ){
+        configurationActors->insert(pair<string, Actor*>(*it, contextActors.find(*it)->second));
     }
 
-    //Insert all actors into the list of all parsed actor by the decoder engine
-    actors.insert(configurationActors->begin(), configurationActors->end());
+    pthread_mutex_unlock(contextLock);
 
     return configurationActors;
 }
 
 void RVCEngine::doOptimizeDecoder(Decoder* decoder){
-    //TODO : add CFGSimplification and mem2reg
-    /*  InstanceInternalize internalize;
+    InstanceInternalize internalize;
     internalize.transform(decoder);
 
-    PassManager Passes;
-    Passes.add(createFunctionInliningPass());
-    Passes.run(*decoder->getModule());
+    // Actions and procedures keep their functions, so the generic inliner is not used
+    ActionInlining inlining;
+    inlining.transform(decoder);
 
     FifoFnRemoval removeFifo;
-    removeFifo.transform(decoder);*/
+    removeFifo.transform(decoder);
 }
 
 int RVCEngine::print(Network* network, string outputFile){
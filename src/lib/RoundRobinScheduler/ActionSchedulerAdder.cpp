@@ -67,6 +67,15 @@ using namespace std;
 // Will be used to configure fifo for unconnected outputs ports
 extern cl::opt<int> FifoSize;
 
+// Tiered compilation looks at firings to find hot instances
+extern cl::opt<bool> TieredJit;
+
+cl::opt<std::string> SchedulerCounters("sched-counters",
+                                       cl::desc("Count firings of actions and blockings of instances, print them when the decoder stops or write them as JSON in the given file"),
+                                       cl::value_desc("json file"),
+                                       cl::ValueOptional,
+                                       cl::init(""));
+
 ActionSchedulerAdder::ActionSchedulerAdder(llvm::LLVMContext& C, Decoder* decoder) : Context(C) {
     this->module = decoder->getModule();
     this->decoder = decoder;
@@ -74,6 +83,7 @@ ActionSchedulerAdder::ActionSchedulerAdder(llvm::LLVMContext& C, Decoder* decode
     this->bb1 = NULL;
     this->incBB = NULL;
     this->returnBB = NULL;
+    this->blockedVar = NULL;
 }
 
 void ActionSchedulerAdder::transform(Instance* instance) {
@@ -130,10 +140,81 @@ void ActionSchedulerAdder::createActionScheduler(Instance* instance){
     new StoreInst(iAdd, iVar, incBB);
     BranchInst::Create(bb1, incBB);
 
+    // Count calls of the action scheduler if needed
+    if (SchedulerCounters.getNumOccurrences() > 0 || TieredJit){
+        createCounters(instance, loadIRet);
+    }
+
     initializeFIFO (instance);
     createScheduler(instance, bb1, incBB, returnBB , scheduler);
 }
 
+void ActionSchedulerAdder::createCounters(Instance* instance, Value* fired){
+    IntegerType* int32Ty = Type::getInt32Ty(Context);
+    IntegerType* int64Ty = Type::getInt64Ty(Context);
+    ConstantInt* zero = ConstantInt::get(int32Ty, 0);
+    ConstantInt* one = ConstantInt::get(int64Ty, 1);
+    Instruction* returnInst = returnBB->getTerminator();
+
+    // Counters of the instance, 64 bits not to overflow on long streams
+    ArrayType* countersTy = ArrayType::get(int64Ty, ActionScheduler::NB_COUNTERS);
+    GlobalVariable* counters = new GlobalVariable(*module, countersTy, false, GlobalValue::InternalLinkage,
+                                                  ConstantAggregateZero::get(countersTy), instance->getId() + "_counters");
+    actionScheduler->setCounters(counters);
+
+    // Reason of the last return, set when an output has no room during the last pass
+    blockedVar = new GlobalVariable(*module, int32Ty, false, GlobalValue::InternalLinkage, zero, instance->getId() + "_blocked");
+    new StoreInst(zero, blockedVar, bb1);
+
+    // Update counters on return
+    ICmpInst* noFiring = new ICmpInst(returnInst, ICmpInst::ICMP_EQ, fired, zero, "");
+    Value* idle = new ZExtInst(noFiring, int64Ty, "", returnInst);
+    LoadInst* blocked = new LoadInst(blockedVar, "", returnInst);
+    Value* full = new ZExtInst(blocked, int64Ty, "", returnInst);
+    Value* starved = BinaryOperator::Create(Instruction::Sub, one, full, "", returnInst);
+
+    createIncrement(counters, ActionScheduler::CALLS, one, returnInst);
+    createIncrement(counters, ActionScheduler::IDLE, idle, returnInst);
+    createIncrement(counters, ActionScheduler::STARVED, starved, returnInst);
+    createIncrement(counters, ActionScheduler::FULL, full, returnInst);
+}
+
+void ActionSchedulerAdder::createIncrement(GlobalVariable* counters, int index, Value* value, Instruction* pos){
+    ConstantInt* zero = ConstantInt::get(Type::getInt32Ty(Context), 0);
+    ConstantInt* counterIndex = ConstantInt::get(Type::getInt32Ty(Context), index);
+    Value* indexes[] = {zero, counterIndex};
+
+    GetElementPtrInst* counterPtr = GetElementPtrInst::Create(counters, indexes, "", pos);
+    LoadInst* counter = new LoadInst(counterPtr, "", pos);
+    BinaryOperator* add = BinaryOperator::Create(Instruction::Add, counter, value, "", pos);
+    new StoreInst(add, counterPtr, pos);
+}
+
+void ActionSchedulerAdder::createFiringCount(Action* action, BasicBlock* BB){
+    if (SchedulerCounters.getNumOccurrences() == 0 && !TieredJit){
+        return;
+    }
+
+    Entity* parent = action->getParent();
+    ActionScheduler* parentScheduler = parent->getActionScheduler();
+    GlobalVariable* firings = parentScheduler->getFirings(action);
+
+    ConstantInt* zero = ConstantInt::get(Type::getInt64Ty(Context), 0);
+    ConstantInt* one = ConstantInt::get(Type::getInt64Ty(Context), 1);
+
+    if (firings == NULL){
+        string name = parent->isInstance() ? ((Instance*)parent)->getId() : "";
+        name.append("_" + action->getName() + "_firings");
+
+        firings = new GlobalVariable(*module, Type::getInt64Ty(Context), false, GlobalValue::InternalLinkage, zero, name);
+        parentScheduler->setFirings(action, firings);
+    }
+
+    LoadInst* counter = new LoadInst(firings, "", BB);
+    BinaryOperator* add = BinaryOperator::Create(Instruction::Add, counter, one, "", BB);
+    new StoreInst(add, firings, BB);
+}
+
 void ActionSchedulerAdder::createInitialize(Instance* instance){
 
     //Get properties of the instance
@@ -332,6 +413,14 @@ BasicBlock* ActionSchedulerAdder::checkOutputPattern(Pattern* pattern, llvm::Fun
     string hasRoomBrName = "hasRoom";
     BasicBlock* roomBB = BasicBlock::Create(Context, hasRoomBrName, function);
 
+    // Record that the instance is blocked on its outputs
+    if (blockedVar != NULL){
+        BasicBlock* fullBB = BasicBlock::Create(Context, "full", function);
+        new StoreInst(ConstantInt::get(Type::getInt32Ty(Context), 1), blockedVar, fullBB);
+        BranchInst::Create(skipBB, fullBB);
+        skipBB = fullBB;
+    }
+
     //Finally branch fire to hasRoom block if all outputs have free room
     BranchInst::Create(roomBB, skipBB, value1, BB);
 
@@ -48,6 +48,7 @@ class BasicBlock;
 class CallInst;
 class ConstantInt;
 class Function;
+class GlobalVariable;
 class Instruction;
 class LLVMContext;
 class Module;
@@ -128,6 +129,37 @@ protected:
      */
     void createInitialize(Instance* instance);
 
+    /**
+     *  @brief Create the counters of the calls of an action scheduler
+     *
+     *  @param instance : the Instance of the action scheduler
+     *
+     *  @param fired : llvm::Value of the number of actions fired by a call
+     */
+    void createCounters(Instance* instance, llvm::Value* fired);
+
+    /**
+     *  @brief Add a value to a counter of an action scheduler
+     *
+     *  @param counters : llvm::GlobalVariable of the counters
+     *
+     *  @param index : index of the counter
+     *
+     *  @param value : llvm::Value to add
+     *
+     *  @param pos : llvm::Instruction before which the counter is updated
+     */
+    void createIncrement(llvm::GlobalVariable* counters, int index, llvm::Value* value, llvm::Instruction* pos);
+
+    /**
+     *  @brief Count a firing of an action when counters are enabled
+     *
+     *  @param action : the fired Action
+     *
+     *  @param BB : llvm::BasicBlock where the action is fired
+     */
+    void createFiringCount(Action* action, llvm::BasicBlock* BB);
+
     /**
      * @brief check a output pattern for an Action
      *
@@ -193,6 +225,9 @@ protected:
     llvm::BasicBlock* bb1;
     llvm::BasicBlock* incBB;
     llvm::BasicBlock* returnBB;
+
+    /** Whether or not the last pass of the scheduler met a full output, NULL if not counted */
+    llvm::GlobalVariable* blockedVar;
 };
 
 #endif
@@ -165,6 +165,7 @@ void CSDFScheduler::createActionsCall(CSDFMoC* moc, BasicBlock* BB){
         Action* action = *it;
         Procedure* body = action->getBody();
         CallInst* schedInst = CallInst::Create(body->getFunction(), "",  BB);
+        createFiringCount(action, BB);
 
         // Add debugging information if needed
         Entity* entity = moc->getParent();
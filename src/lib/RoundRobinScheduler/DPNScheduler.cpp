@@ -195,6 +195,7 @@ void DPNScheduler::createActionCall(Action* action, BasicBlock* BB){
     Procedure* body = action->getBody();
     CallInst* bodyInst = CallInst::Create(body->getFunction(), "",  BB);
     Entity* parent = action->getParent();
+    createFiringCount(action, BB);
 
     // Add debugging information if needed
     if (parent->isInstance() && ((Instance*)parent)->isTraceActivate()){
@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class DataDrivenScheduler
+@author agent
+@file DataDrivenScheduler.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Instructions.h"
+
+#include "DPNScheduler.h"
+#include "CSDFScheduler.h"
+#include "QSDFScheduler.h"
+
+#include "lib/RVCEngine/Decoder.h"
+#include "lib/ConfigurationEngine/Configuration.h"
+#include "lib/IRCore/Network.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/IRCore/Actor/ActionScheduler.h"
+#include "lib/IRJit/LLVMExecution.h"
+#include "lib/RoundRobinScheduler/DataDrivenScheduler.h"
+#include "lib/IRUtil/TraceMng.h"
+//------------------------------
+
+using namespace std;
+using namespace llvm;
+
+DataDrivenScheduler::DataDrivenScheduler(llvm::LLVMContext& C, Decoder* decoder, list<Instance*>* instances, bool optimized, bool verbose): Context(C) {
+    this->decoder = decoder;
+    this->scheduler = NULL;
+    this->initialize = NULL;
+    this->initInst = NULL;
+    this->pushFn = NULL;
+    this->listGV = NULL;
+    this->inListGV = NULL;
+    this->tailGV = NULL;
+    this->stopGV = NULL;
+    this->callsGV = NULL;
+    this->idleCallsGV = NULL;
+    this->roundsGV = NULL;
+    this->verbose = verbose;
+    this->optimized = optimized;
+
+    Module* module = decoder->getModule();
+
+    //Create a global value that stop the scheduler
+    stopGV = new GlobalVariable(*module, Type::getInt32Ty(Context), false, GlobalValue::ExternalLinkage, 0, "stop");
+
+    // Create main scheduler function
+    FunctionType *FT = FunctionType::get(Type::getInt32Ty(Context), false);
+    scheduler = Function::Create(FT, Function::ExternalLinkage, "main", module);
+
+    createNetworkInitialize();
+
+    //Add the instances in the scheduler
+    list<Instance*>::iterator it;
+    for (it = instances->begin(); it != instances->end(); it++){
+        createActionScheduler(*it);
+        this->instances.push_back(*it);
+    }
+
+    createNetworkScheduler();
+}
+
+DataDrivenScheduler::~DataDrivenScheduler (){
+    scheduler->eraseFromParent();
+    clearWorklist();
+}
+
+void DataDrivenScheduler::createNetworkInitialize(){
+    Module* module = decoder->getModule();
+
+    // Create main initialize function
+    initialize = cast<Function>(module->getOrInsertFunction("initialize", Type::getVoidTy(Context),
+                                                            (Type *)0));
+
+    if (initialize->empty()){
+        // Add a basic block entry to the initializer.
+        BasicBlock* initializeBB = BasicBlock::Create(Context, "entry", initialize);
+
+        initInst = ReturnInst::Create(Context, 0, initializeBB);
+    }else{
+        initInst = initialize->getEntryBlock().begin();
+    }
+}
+
+void DataDrivenScheduler::addInstance(Instance* instance){
+    createActionScheduler(instance);
+
+    // Insert instance in the worklist and regenerate the scheduler
+    instances.push_back(instance);
+    createNetworkScheduler();
+}
+
+void DataDrivenScheduler::createActionScheduler(Instance* instance){
+    // Create an action scheduler for the instance
+    DPNScheduler DPNSchedulerAdder(Context, decoder);
+    CSDFScheduler CSDFSchedulerAdder(Context, decoder);
+    QSDFScheduler QSDFSchedulerAdder(Context, decoder);
+
+    MoC* moc = instance->getMoC();
+
+    if (moc->isQuasiStatic() && optimized){
+        QSDFSchedulerAdder.transform(instance);
+    }else if (moc->isCSDF() && optimized){
+        CSDFSchedulerAdder.transform(instance);
+    }else{
+        DPNSchedulerAdder.transform(instance);
+    }
+
+    // Call initialize function if present
+    ActionScheduler* actionScheduler = instance->getActionScheduler();
+    if (actionScheduler->hasInitializeScheduler()){
+        Function* init = actionScheduler->getInitializeFunction();
+        CallInst* callInit = CallInst::Create(init, "", initInst);
+        initCalls.insert(pair<Function*, CallInst*>(init, callInit));
+    }
+}
+
+void DataDrivenScheduler::removeInstance(Instance* instance){
+    ActionScheduler* actionScheduler = instance->getActionScheduler();
+
+    if (actionScheduler->hasInitializeScheduler()){
+        map<Function*, CallInst*>::iterator it;
+        it = initCalls.find(actionScheduler->getInitializeFunction());
+        it->second->eraseFromParent();
+        initCalls.erase(it);
+    }
+
+    vector<Instance*>::iterator it = find(instances.begin(), instances.end(), instance);
+    if (it != instances.end()){
+        instances.erase(it);
+    }
+
+    createNetworkScheduler();
+}
+
+GlobalVariable* DataDrivenScheduler::createGV(Type* type, string name){
+    GlobalVariable* gv = new GlobalVariable(*decoder->getModule(), type, false, GlobalValue::InternalLinkage, Constant::getNullValue(type), name);
+    worklistGVs.push_back(gv);
+    return gv;
+}
+
+void DataDrivenScheduler::clearWorklist(){
+    if (pushFn != NULL){
+        pushFn->eraseFromParent();
+        pushFn = NULL;
+    }
+
+    list<GlobalVariable*>::iterator it;
+    for (it = worklistGVs.begin(); it != worklistGVs.end(); it++){
+        (*it)->eraseFromParent();
+    }
+    worklistGVs.clear();
+}
+
+void DataDrivenScheduler::createIncrement(GlobalVariable* counter, BasicBlock* BB){
+    ConstantInt* one = ConstantInt::get(Type::getInt64Ty(Context), 1);
+    LoadInst* value = new LoadInst(counter, "", BB);
+    BinaryOperator* add = BinaryOperator::Create(Instruction::Add, value, one, "", BB);
+    new StoreInst(add, counter, BB);
+}
+
+void DataDrivenScheduler::createPushFunction(int size){
+    Module* module = decoder->getModule();
+    ConstantInt* zero = ConstantInt::get(Type::getInt32Ty(Context), 0);
+    ConstantInt* one = ConstantInt::get(Type::getInt32Ty(Context), 1);
+    ConstantInt* sizeVal = ConstantInt::get(Type::getInt32Ty(Context), size);
+
+    // Worklist storage, an instance is at most once in the list so size elements are enough
+    listGV = createGV(ArrayType::get(Type::getInt32Ty(Context), size), "dd_list");
+    inListGV = createGV(ArrayType::get(Type::getInt8Ty(Context), size), "dd_in_list");
+    tailGV = createGV(Type::getInt32Ty(Context), "dd_tail");
+
+    // void dd_push(i32 index)
+    FunctionType* FT = FunctionType::get(Type::getVoidTy(Context), Type::getInt32Ty(Context), false);
+    pushFn = Function::Create(FT, GlobalValue::InternalLinkage, "dd_push", module);
+    Value* index = pushFn->arg_begin();
+    index->setName("index");
+
+    BasicBlock* entryBB = BasicBlock::Create(Context, "entry", pushFn);
+    BasicBlock* pushBB = BasicBlock::Create(Context, "push", pushFn);
+    BasicBlock* retBB = BasicBlock::Create(Context, "return", pushFn);
+    ReturnInst::Create(Context, retBB);
+
+    // Test if the instance is already in the worklist
+    Value* inListIdx[] = {zero, index};
+    GetElementPtrInst* inListPtr = GetElementPtrInst::Create(inListGV, inListIdx, "", entryBB);
+    LoadInst* inList = new LoadInst(inListPtr, "", entryBB);
+    ICmpInst* notInList = new ICmpInst(*entryBB, ICmpInst::ICMP_EQ, inList, ConstantInt::get(Type::getInt8Ty(Context), 0));
+    BranchInst::Create(pushBB, retBB, notInList, entryBB);
+
+    // Store the instance at the tail of the worklist
+    new StoreInst(ConstantInt::get(Type::getInt8Ty(Context), 1), inListPtr, pushBB);
+    LoadInst* tail = new LoadInst(tailGV, "", pushBB);
+    BinaryOperator* slot = BinaryOperator::Create(Instruction::URem, tail, sizeVal, "", pushBB);
+    Value* listIdx[] = {zero, slot};
+    GetElementPtrInst* listPtr = GetElementPtrInst::Create(listGV, listIdx, "", pushBB);
+    new StoreInst(index, listPtr, pushBB);
+    BinaryOperator* newTail = BinaryOperator::Create(Instruction::Add, tail, one, "", pushBB);
+    new StoreInst(newTail, tailGV, pushBB);
+    BranchInst::Create(retBB, pushBB);
+}
+
+void DataDrivenScheduler::createPushAll(BasicBlock* BB){
+    for (unsigned int i = 0; i < instances.size(); i++){
+        CallInst::Create(pushFn, ConstantInt::get(Type::getInt32Ty(Context), i), "", BB);
+    }
+}
+
+list<int> DataDrivenScheduler::getNeighbours(Instance* instance){
+    list<int> neighbours;
+    list<Connection*>::iterator it;
+    map<Instance*, int>::iterator itIndex;
+    Network* network = instance->getConfiguration()->getNetwork();
+
+    // Consumers may have new tokens
+    list<Connection*> outs = network->getOutConnections(instance);
+    for (it = outs.begin(); it != outs.end(); it++){
+        Vertex* sink = (Vertex*)(*it)->getSink();
+        if (sink != NULL && sink->isInstance()){
+            itIndex = indexes.find(sink->getInstance());
+            if (itIndex != indexes.end()){
+                neighbours.push_back(itIndex->second);
+            }
+        }
+    }
+
+    // Producers may have new rooms
+    list<Connection*> ins = network->getInConnections(instance);
+    for (it = ins.begin(); it != ins.end(); it++){
+        Vertex* source = (Vertex*)(*it)->getSource();
+        if (source != NULL && source->isInstance()){
+            itIndex = indexes.find(source->getInstance());
+            if (itIndex != indexes.end()){
+                neighbours.push_back(itIndex->second);
+            }
+        }
+    }
+
+    neighbours.sort();
+    neighbours.unique();
+
+    return neighbours;
+}
+
+void DataDrivenScheduler::createCall(Instance* instance, BasicBlock* BB, BasicBlock* loopBB, BasicBlock* idleBB){
+    ActionScheduler* actionScheduler = instance->getActionScheduler();
+    Function* function = BB->getParent();
+
+    // Call scheduler function of the instance
+    CallInst* callSched = CallInst::Create(actionScheduler->getSchedulerFunction(), "", BB);
+
+    // Add debugging information if needed
+    if (instance->isTraceActivate()){
+        TraceMng::createCallTrace(decoder->getModule(), instance, callSched);
+    }
+
+    // Notify neighbours when at least one action has been fired
+    string notifyName = "notify_";
+    notifyName.append(instance->getId());
+    BasicBlock* notifyBB = BasicBlock::Create(Context, notifyName, function);
+    ICmpInst* fired = new ICmpInst(*BB, ICmpInst::ICMP_NE, callSched, ConstantInt::get(Type::getInt32Ty(Context), 0));
+    BranchInst::Create(notifyBB, idleBB, fired, BB);
+
+    list<int>::iterator it;
+    list<int> neighbours = getNeighbours(instance);
+    for (it = neighbours.begin(); it != neighbours.end(); it++){
+        CallInst::Create(pushFn, ConstantInt::get(Type::getInt32Ty(Context), *it), "", notifyBB);
+    }
+    BranchInst::Create(loopBB, notifyBB);
+}
+
+void DataDrivenScheduler::createNetworkScheduler(){
+    // Remove previous scheduler body
+    scheduler->dropAllReferences();
+    while (!scheduler->empty()){
+        scheduler->getBasicBlockList().pop_back();
+    }
+    clearWorklist();
+
+    // Index instances of the worklist
+    indexes.clear();
+    for (unsigned int i = 0; i < instances.size(); i++){
+        indexes.insert(pair<Instance*, int>(instances[i], i));
+    }
+
+    int size = instances.empty() ? 1 : instances.size();
+    ConstantInt* zero = ConstantInt::get(Type::getInt32Ty(Context), 0);
+    ConstantInt* one = ConstantInt::get(Type::getInt32Ty(Context), 1);
+    ConstantInt* sizeVal = ConstantInt::get(Type::getInt32Ty(Context), size);
+
+    createPushFunction(size);
+    GlobalVariable* headGV = createGV(Type::getInt32Ty(Context), "dd_head");
+    GlobalVariable* roundEndGV = createGV(Type::getInt32Ty(Context), "dd_round_end");
+    callsGV = createGV(Type::getInt64Ty(Context), "dd_calls");
+    idleCallsGV = createGV(Type::getInt64Ty(Context), "dd_idle_calls");
+    roundsGV = createGV(Type::getInt64Ty(Context), "dd_rounds");
+
+    BasicBlock* entryBB = BasicBlock::Create(Context, "entry", scheduler);
+    BasicBlock* loopBB = BasicBlock::Create(Context, "bb", scheduler);
+    BasicBlock* popBB = BasicBlock::Create(Context, "pop", scheduler);
+    BasicBlock* reseedBB = BasicBlock::Create(Context, "reseed", scheduler);
+    BasicBlock* roundBB = BasicBlock::Create(Context, "new_round", scheduler);
+    BasicBlock* dispatchBB = BasicBlock::Create(Context, "dispatch", scheduler);
+    BasicBlock* idleBB = BasicBlock::Create(Context, "idle", scheduler);
+    BasicBlock* returnBB = BasicBlock::Create(Context, "return", scheduler);
+
+    // All instances are schedulable at start
+    new StoreInst(zero, headGV, entryBB);
+    new StoreInst(zero, tailGV, entryBB);
+    new StoreInst(zero, roundEndGV, entryBB);
+    new StoreInst(ConstantAggregateZero::get(inListGV->getType()->getElementType()), inListGV, entryBB);
+    createPushAll(entryBB);
+    BranchInst::Create(loopBB, entryBB);
+
+    // Test if the scheduler must be stopped
+    ReturnInst::Create(Context, one, returnBB);
+    LoadInst* stop = new LoadInst(stopGV, "", loopBB);
+    ICmpInst* test = new ICmpInst(*loopBB, ICmpInst::ICMP_EQ, stop, one);
+    BranchInst::Create(returnBB, popBB, test, loopBB);
+
+    // Empty worklist falls back to a round-robin pass
+    LoadInst* head = new LoadInst(headGV, "head", popBB);
+    LoadInst* tail = new LoadInst(tailGV, "tail", popBB);
+    ICmpInst* empty = new ICmpInst(*popBB, ICmpInst::ICMP_EQ, head, tail);
+    BasicBlock* checkRoundBB = BasicBlock::Create(Context, "check_round", scheduler);
+    BranchInst::Create(reseedBB, checkRoundBB, empty, popBB);
+    createPushAll(reseedBB);
+    BranchInst::Create(loopBB, reseedBB);
+
+    // A round ends when all instances pushed during the previous one have been called
+    LoadInst* roundEnd = new LoadInst(roundEndGV, "", checkRoundBB);
+    ICmpInst* isNewRound = new ICmpInst(*checkRoundBB, ICmpInst::ICMP_EQ, head, roundEnd);
+    BranchInst::Create(roundBB, dispatchBB, isNewRound, checkRoundBB);
+    createIncrement(roundsGV, roundBB);
+    new StoreInst(tail, roundEndGV, roundBB);
+    BranchInst::Create(dispatchBB, roundBB);
+
+    // Pop the next instance of the worklist
+    BinaryOperator* slot = BinaryOperator::Create(Instruction::URem, head, sizeVal, "", dispatchBB);
+    Value* listIdx[] = {zero, slot};
+    GetElementPtrInst* listPtr = GetElementPtrInst::Create(listGV, listIdx, "", dispatchBB);
+    LoadInst* index = new LoadInst(listPtr, "index", dispatchBB);
+    Value* inListIdx[] = {zero, index};
+    GetElementPtrInst* inListPtr = GetElementPtrInst::Create(inListGV, inListIdx, "", dispatchBB);
+    new StoreInst(ConstantInt::get(Type::getInt8Ty(Context), 0), inListPtr, dispatchBB);
+    BinaryOperator* newHead = BinaryOperator::Create(Instruction::Add, head, one, "", dispatchBB);
+    new StoreInst(newHead, headGV, dispatchBB);
+    createIncrement(callsGV, dispatchBB);
+
+    // Count calls that did not fire
+    createIncrement(idleCallsGV, idleBB);
+    BranchInst::Create(loopBB, idleBB);
+
+    // Dispatch to the action scheduler of the instance
+    SwitchInst* dispatch = SwitchInst::Create(index, loopBB, instances.size(), dispatchBB);
+    for (unsigned int i = 0; i < instances.size(); i++){
+        string callName = "call_";
+        callName.append(instances[i]->getId());
+        BasicBlock* callBB = BasicBlock::Create(Context, callName, scheduler);
+        dispatch->addCase(ConstantInt::get(Type::getInt32Ty(Context), i), callBB);
+        createCall(instances[i], callBB, loopBB, idleBB);
+    }
+}
+
+void DataDrivenScheduler::printStatistics(LLVMExecution* executionEngine){
+    if (!executionEngine->isCompiledGV(callsGV)){
+        return;
+    }
+
+    long long calls = *(long long*)executionEngine->getGVPtr(callsGV);
+    long long idleCalls = *(long long*)executionEngine->getGVPtr(idleCallsGV);
+    long long rounds = *(long long*)executionEngine->getGVPtr(roundsGV);
+    long long rrCalls = rounds * instances.size();
+
+    cout << "Data-driven scheduler: " << calls << " action scheduler calls, " << idleCalls << " without firing." << endl;
+    cout << "Round-robin would have made " << rrCalls << " calls over " << rounds << " rounds, "
+         << (rrCalls - calls) << " calls saved";
+    if (rrCalls > 0){
+        cout << " (" << (rrCalls - calls) * 100 / rrCalls << "%)";
+    }
+    cout << "." << endl;
+}
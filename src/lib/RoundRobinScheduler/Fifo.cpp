@@ -39,10 +39,14 @@
 #include <sstream>
 
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/Support/MathExtras.h"
 
 #include "lib/RVCEngine/Decoder.h"
 #include "lib/RoundRobinScheduler/Fifo.h"
@@ -52,14 +56,21 @@
 using namespace llvm;
 using namespace std;
 
+extern cl::opt<std::string> FifoProfileOut;
+
 //Initialize static elements
 bool Fifo::debug = false;
 
-Fifo::Fifo(llvm::LLVMContext& C, llvm::Module* module, llvm::Type* type, int size){
+// Size of the cache lines that concurrent fifos must not share
+static const int CACHE_LINE_SIZE = 64;
+
+Fifo::Fifo(llvm::LLVMContext& C, llvm::Module* module, llvm::Type* type, int size, int readers, bool concurrent){
     IntegerType* connectionType = cast<IntegerType>(type);
+    this->references = readers;
+    this->concurrent = concurrent;
 
     //Get fifo structure
-    StructType* structType = Fifo::getOrInsertFifoStruct(module, connectionType);
+    StructType* structType = Fifo::getOrInsertFifoStruct(module, connectionType, concurrent);
 
     // Initialize array content
     ArrayType* arrayType = ArrayType::get(connectionType, size);
@@ -67,14 +78,14 @@ Fifo::Fifo(llvm::LLVMContext& C, llvm::Module* module, llvm::Type* type, int siz
     gv_array->setAlignment(16);
 
 
-    // Initialize read_ind
-    ArrayType* read_indTy = ArrayType::get(IntegerType::get(module->getContext(), 32), 1);
+    // Initialize read_inds, each one alone in its cache line when written by another thread
+    int read_indSize = readers * getReadIndStride(concurrent);
+    ArrayType* read_indTy = ArrayType::get(IntegerType::get(module->getContext(), 32), read_indSize);
     gv_read_inds = new GlobalVariable(*module, read_indTy, false, GlobalValue::InternalLinkage, ConstantAggregateZero::get(read_indTy), "read_inds");
-    gv_read_inds->setAlignment(4);
+    gv_read_inds->setAlignment(concurrent ? CACHE_LINE_SIZE : 4);
 
     //Usefull values
     Constant *Zero = ConstantInt::get(Type::getInt32Ty(C), 0);
-    Constant *One = ConstantInt::get(Type::getInt32Ty(C), 1);
     vector<Constant*> indices;
     indices.push_back(Zero);
     indices.push_back(Zero);
@@ -83,14 +94,65 @@ Fifo::Fifo(llvm::LLVMContext& C, llvm::Module* module, llvm::Type* type, int siz
     std::vector<Constant*> elts;
     elts.push_back(ConstantInt::get(Type::getInt32Ty(C), size)); // size of the ringbuffer
     elts.push_back(ConstantExpr::getGetElementPtr(gv_array, indices)); // the memory containing the ringbuffer
-    elts.push_back(One); // the number of fifo's readers
+    elts.push_back(ConstantInt::get(Type::getInt32Ty(C), readers)); // the number of fifo's readers
     elts.push_back(ConstantExpr::getGetElementPtr(gv_read_inds, indices)); // the current position of the reader
     elts.push_back(Zero); //the current position of the writer
+    if (concurrent){
+        elts.push_back(ConstantAggregateZero::get(structType->getElementType(5))); // padding up to the next cache line
+    }
     Constant* fifoStruct = ConstantStruct::get(structType, elts);
 
     // Create FIFO
     fifoGV = new GlobalVariable(*module, structType, false, GlobalValue::InternalLinkage, fifoStruct, "fifo");
-    fifoGV->setAlignment(8);
+    fifoGV->setAlignment(concurrent ? CACHE_LINE_SIZE : 8);
+}
+
+int Fifo::getReadIndStride(bool concurrent){
+    return concurrent ? CACHE_LINE_SIZE / 4 : 1;
+}
+
+bool Fifo::isEmpty(void* compiled, const DataLayout* layout){
+    // Fields of the fifo structure, see getOrInsertFifoStruct
+    StructType* fifoType = cast<StructType>(fifoGV->getType()->getElementType());
+    const StructLayout* fields = layout->getStructLayout(fifoType);
+    char* fifo = (char*)compiled;
+
+    int readers = *(int*)(fifo + fields->getElementOffset(2));
+    volatile int* read_inds = *(volatile int**)(fifo + fields->getElementOffset(3));
+    volatile int* write_ind = (volatile int*)(fifo + fields->getElementOffset(4));
+    int stride = getReadIndStride(concurrent);
+
+    for (int i = 0; i < readers; i++){
+        if (read_inds[i * stride] != *write_ind){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+LoadInst* Fifo::createIndexLoad(Value* ptr, bool concurrent, BasicBlock* BB){
+    LoadInst* load = new LoadInst(ptr, "", false, BB);
+
+    // Pairs with the release store of the thread that owns the index
+    if (concurrent){
+        load->setAlignment(4);
+        load->setAtomic(Acquire);
+    }
+
+    return load;
+}
+
+StoreInst* Fifo::createIndexStore(Value* value, Value* ptr, bool concurrent, BasicBlock* BB){
+    StoreInst* store = new StoreInst(value, ptr, false, BB);
+
+    // Publish tokens or room only once the accesses to the contents are done
+    if (concurrent){
+        store->setAlignment(4);
+        store->setAtomic(Release);
+    }
+
+    return store;
 }
 
 
@@ -122,7 +184,6 @@ void Fifo::createReadWritePeek(Action* action, bool debug){
 
 void Fifo::createWrites (Procedure* procedure, Pattern* pattern){
     Function* function = procedure->getFunction();
-    BasicBlock* BB = &function->back();
 
     //Get tokens and var
     map<Port*, ConstantInt*>::iterator it;
@@ -133,8 +194,10 @@ void Fifo::createWrites (Procedure* procedure, Pattern* pattern){
         ConstantInt* numTokens = it->second;
 
         //Create write
-        Value* value = replaceAccess(port, procedure);
+        Value* value = replaceAccess(port, procedure, numTokens, true);
 
+        // Tokens are published once copied back in the fifo
+        BasicBlock* BB = &function->back();
         BinaryOperator* add = BinaryOperator::Create(Instruction::Add, value, numTokens, "", BB->getTerminator());
         new StoreInst(add, port->getIndex(), BB->getTerminator());
     }
@@ -143,7 +206,6 @@ void Fifo::createWrites (Procedure* procedure, Pattern* pattern){
 
 void Fifo::createReads (Procedure* procedure, Pattern* pattern){
     Function* function = procedure->getFunction();
-    BasicBlock* BB = &function->back();
 
     //Get tokens and var
     map<Port*, ConstantInt*>::iterator it;
@@ -155,8 +217,9 @@ void Fifo::createReads (Procedure* procedure, Pattern* pattern){
         ConstantInt* numTokens = it->second;
 
         //Create read
-        Value* value = replaceAccess(port, procedure);
+        Value* value = replaceAccess(port, procedure, numTokens, false);
 
+        BasicBlock* BB = &function->back();
         BinaryOperator* add = BinaryOperator::Create(Instruction::Add, value, numTokens, "", BB->getTerminator());
         new StoreInst(add, port->getIndex(), BB->getTerminator());
     }
@@ -171,15 +234,20 @@ void Fifo::createPeeks (Procedure* procedure, Pattern* pattern){
 
     for (it = numTokensMap->begin(); it != numTokensMap->end(); it++){
         Port* port = it->first;
+        ConstantInt* numTokens = it->second;
 
         //Create peek
-        replaceAccess(port, procedure);
+        replaceAccess(port, procedure, numTokens, false);
     }
 }
 
-Value* Fifo::replaceAccess (Port* port, Procedure* proc) {
+Value* Fifo::replaceAccess (Port* port, Procedure* proc, ConstantInt* numTokens, bool write) {
     Function* function = proc->getFunction();
-    ConstantInt* sizeVal = ConstantInt::get(function->getContext(), APInt(32, port->getFifoSize()));
+    int size = port->getFifoSize();
+
+    // Power of two fifos are indexed with a mask instead of a modulo
+    bool mask = size > 0 && isPowerOf2_32(size);
+    ConstantInt* sizeVal = ConstantInt::get(function->getContext(), APInt(32, mask ? size - 1 : size));
     ConstantInt* zero = ConstantInt::get(function->getContext(), APInt(32, 0));
 
     //Get load instruction on port
@@ -200,6 +268,13 @@ Value* Fifo::replaceAccess (Port* port, Procedure* proc) {
                     LoadInst* indexVal = new LoadInst(port->getIndex(), "", loadInst);
                     BitCastInst* newCastInst = new BitCastInst(loadInst, PointerType::getUnqual(arrayTy), "", CastInst);
 
+                    // Tokens of a repeat pattern are accessed in a contiguous memory
+                    Value* tokens = NULL;
+                    if (size > 0 && numTokens->getZExtValue() > 1 && numTokens->getZExtValue() <= (uint64_t)size
+                            && BB == &function->getEntryBlock()){
+                        tokens = createBulkAccess(port, numTokens, indexVal, newCastInst, CastInst, write);
+                    }
+
                     //Get GET instruction on bitcast
                     std::vector<GetElementPtrInst*> GEPs;
                     for (User* user : CastInst->users()) {
@@ -208,7 +283,9 @@ Value* Fifo::replaceAccess (Port* port, Procedure* proc) {
 
                             // Set new GEP idx
                             vector<Value*> GEPIdx;
-                            GEPIdx.push_back(zero);
+                            if (tokens == NULL){
+                                GEPIdx.push_back(zero);
+                            }
                             for (User::op_iterator I = GEPInst->idx_begin()+1, E = GEPInst->idx_end(); I != E; ++I) {
                                 Value *OpC = cast<Value>(*I);
                                 if (OpC->getType()->getScalarSizeInBits() < 32) {
@@ -217,13 +294,19 @@ Value* Fifo::replaceAccess (Port* port, Procedure* proc) {
                                     OpC = new TruncInst(OpC, Type::getInt32Ty(function->getContext()), "", GEPInst);
                                 }
 
+                                if (tokens != NULL){
+                                    GEPIdx.push_back(OpC);
+                                    continue;
+                                }
+
                                 BinaryOperator* add = BinaryOperator::Create(Instruction::Add, indexVal, OpC, "", GEPInst);
-                                BinaryOperator* modulo = BinaryOperator::Create(Instruction::URem, add, sizeVal, "", GEPInst);
+                                BinaryOperator* modulo = BinaryOperator::Create(mask ? Instruction::And : Instruction::URem, add, sizeVal, "", GEPInst);
                                 GEPIdx.push_back(modulo);
                             }
 
                             // Create the new GEP
-                            GetElementPtrInst* newGEPInst = GetElementPtrInst::Create(newCastInst, GEPIdx, "", GEPInst);
+                            Value* base = tokens != NULL ? tokens : newCastInst;
+                            GetElementPtrInst* newGEPInst = GetElementPtrInst::Create(base, GEPIdx, "", GEPInst);
                             GEPInst->replaceAllUsesWith(newGEPInst);
 
                             // Add debugging information if needed
@@ -259,6 +342,67 @@ Value* Fifo::replaceAccess (Port* port, Procedure* proc) {
     return 0;
 }
 
+Value* Fifo::createBulkAccess(Port* port, ConstantInt* numTokens, Value* indexVal, Value* contents, Instruction* pos, bool write){
+    BasicBlock* BB = pos->getParent();
+    Function* function = BB->getParent();
+    LLVMContext& C = function->getContext();
+    IntegerType* tokenTy = port->getType();
+    int size = port->getFifoSize();
+
+    // Usefull constants
+    ConstantInt* zero = ConstantInt::get(C, APInt(32, 0));
+    ConstantInt* sizeVal = ConstantInt::get(C, APInt(32, size));
+    Constant* tokenSize = ConstantExpr::getSizeOf(tokenTy);
+
+    // Local buffer used when the pattern crosses the end of the ring
+    ArrayType* bufferTy = ArrayType::get(tokenTy, numTokens->getZExtValue());
+    AllocaInst* buffer = new AllocaInst(bufferTy, "bulk", function->getEntryBlock().getFirstInsertionPt());
+
+    // Position of the first token and room before the end of the ring
+    IRBuilder<> Builder(pos);
+    Value* start = isPowerOf2_32(size) ? Builder.CreateAnd(indexVal, size - 1) : Builder.CreateURem(indexVal, sizeVal);
+    vector<Value*> startIdx;
+    startIdx.push_back(zero);
+    startIdx.push_back(start);
+    Value* startPtr = Builder.CreateGEP(contents, startIdx);
+    Value* headPtr = Builder.CreateConstGEP2_32(contents, 0, 0);
+    Value* bufferPtr = Builder.CreateConstGEP2_32(buffer, 0, 0);
+    Value* room = Builder.CreateSub(sizeVal, start);
+    Value* wrap = Builder.CreateICmpULT(room, numTokens);
+    Value* tokens = Builder.CreateSelect(wrap, bufferPtr, startPtr);
+
+    // Tokens are read before the accesses or written back after them
+    if (write){
+        BB = &function->back();
+        pos = BB->getTerminator();
+    }
+
+    BasicBlock* copyBB = BasicBlock::Create(C, write ? "bulk_write" : "bulk_read", function);
+    BasicBlock* nextBB = BB->splitBasicBlock(pos);
+    BB->getTerminator()->eraseFromParent();
+    BranchInst::Create(copyBB, nextBB, wrap, BB);
+    copyBB->moveBefore(nextBB);
+
+    // Copy the two spans of the ring
+    Builder.SetInsertPoint(copyBB);
+    Type* sizeTy = tokenSize->getType();
+    Value* firstSize = Builder.CreateMul(Builder.CreateZExt(room, sizeTy), tokenSize);
+    Value* secondSize = Builder.CreateMul(Builder.CreateZExt(Builder.CreateSub(numTokens, room), sizeTy), tokenSize);
+    Value* bufferSecond = Builder.CreateGEP(bufferPtr, room);
+    unsigned align = tokenTy->getBitWidth() / 8;
+
+    if (write){
+        Builder.CreateMemCpy(startPtr, bufferPtr, firstSize, align);
+        Builder.CreateMemCpy(headPtr, bufferSecond, secondSize, align);
+    }else{
+        Builder.CreateMemCpy(bufferPtr, startPtr, firstSize, align);
+        Builder.CreateMemCpy(bufferSecond, headPtr, secondSize, align);
+    }
+    Builder.CreateBr(nextBB);
+
+    return tokens;
+}
+
 void Fifo::createFifoTrace(Module* module, Port* port, GetElementPtrInst* gep, vector<Value*> idxs){
     stringstream message;
     vector<Value*>::iterator it;
@@ -324,37 +468,19 @@ void Fifo::createFifoTrace(Module* module, Port* port, GetElementPtrInst* gep, v
 }
 
 Value* Fifo::createInputTest(Port* port, ConstantInt* numTokens, BasicBlock* BB){
+    // Compare the distance between indexes so that the test holds when they overflow
     LoadInst* indexVal = new LoadInst(port->getIndex(), "", false, BB);
-    BinaryOperator* addVal = BinaryOperator::Create(Instruction::Add, indexVal, numTokens, "", BB);
     LoadInst* tokenVal = new LoadInst(port->getRoomToken(), "", false, BB);
-    return new ICmpInst(*BB, ICmpInst::ICMP_ULE, addVal, tokenVal, "");
+    BinaryOperator* subVal = BinaryOperator::Create(Instruction::Sub, tokenVal, indexVal, "", BB);
+    return new ICmpInst(*BB, ICmpInst::ICMP_ULE, numTokens, subVal, "");
 }
 
 Value* Fifo::createOutputTest(Port* port, ConstantInt* numTokens, BasicBlock* BB){
-
-    // Usefull constants
-    Constant* fifoSizeCst = ConstantInt::get(Type::getInt32Ty(BB->getContext()), port->getFifoSize());
-    ConstantInt* zero = ConstantInt::get(BB->getContext(), APInt(32, 0));
-    ConstantInt* three = ConstantInt::get(BB->getContext(), APInt(32, 3));
-
-    //Create subs
+    // Room has been computed from the slowest reader when the scheduler started
     LoadInst* indexVal = new LoadInst(port->getIndex(), "", false, BB);
-    BinaryOperator* subVal = BinaryOperator::Create(Instruction::Sub,  fifoSizeCst , indexVal, "", BB);
-
-    // Get read ind
-    LoadInst* portStructPtr = new LoadInst(port->getFifoVar(), "", false, BB);
-    std::vector<Value*> readind_indices;
-    readind_indices.push_back(zero);
-    readind_indices.push_back(three);
-    Instruction* readIndPtr = GetElementPtrInst::Create(portStructPtr, readind_indices, "", BB);
-    LoadInst* readIndVal = new LoadInst(readIndPtr, "", false, BB);
-    GetElementPtrInst* readIndValPtr = GetElementPtrInst::Create(readIndVal, zero, "", BB); // source_O->read_inds[0]
-    LoadInst* readIndVal0 = new LoadInst(readIndValPtr, "", false, BB);
-
-    // Add and compare to numTokens
-    BinaryOperator* resultVal = BinaryOperator::Create(Instruction::Add, subVal, readIndVal0, "", BB);
-    ICmpInst* compVal = new ICmpInst(*BB, ICmpInst::ICMP_ULE, numTokens, resultVal, "");
-    return compVal;
+    LoadInst* roomVal = new LoadInst(port->getRoomToken(), "", false, BB);
+    BinaryOperator* subVal = BinaryOperator::Create(Instruction::Sub, roomVal, indexVal, "", BB);
+    return new ICmpInst(*BB, ICmpInst::ICMP_ULE, numTokens, subVal, "");
 }
 
 Function* Fifo::initializeIn(llvm::Module* module, Port* port){
@@ -366,7 +492,8 @@ Function* Fifo::initializeIn(llvm::Module* module, Port* port){
     // Create Fifo access elements
     GlobalVariable* index = new GlobalVariable(*module, IntegerType::get(module->getContext(), 32), false, GlobalValue::InternalLinkage, zero, "index");
     GlobalVariable* numFreeVar = new GlobalVariable(*module, IntegerType::get(module->getContext(), 32), false, GlobalValue::InternalLinkage, zero, "numFreeVar");
-    GlobalVariable* id = new GlobalVariable(*module, IntegerType::get(module->getContext(), 32), false, GlobalValue::InternalLinkage, zero, "id");
+    ConstantInt* readerId = ConstantInt::get(module->getContext(), APInt(32, port->getReaderId()));
+    GlobalVariable* id = new GlobalVariable(*module, IntegerType::get(module->getContext(), 32), false, GlobalValue::InternalLinkage, readerId, "id");
 
     index->setAlignment(4);
     numFreeVar->setAlignment(4);
@@ -404,7 +531,7 @@ Function* Fifo::initializeIn(llvm::Module* module, Port* port){
     new StoreInst(read_indiceVal, index, false, bb);
 
     // Call numToken function
-    Function* getNumTokensFn = getOrInsertNumTokensFn(module, port->getType());
+    Function* getNumTokensFn = getOrInsertNumTokensFn(module, port->getType(), port->isConcurrent());
     std::vector<Value*> num_tokens_params;
     num_tokens_params.push_back(fifoVarPtr);
     num_tokens_params.push_back(fifoId);
@@ -425,6 +552,8 @@ Function* Fifo::initializeIn(llvm::Module* module, Port* port){
     // Return from function
     ReturnInst::Create(module->getContext(), bb);
 
+    port->setAccessors(readFn_port, port->getCloseFn());
+
     return readFn_port;
 }
 
@@ -434,6 +563,7 @@ Function* Fifo::initializeOut(llvm::Module* module, Port* port){
     //Usefull constant
     ConstantInt* zero = ConstantInt::get(module->getContext(), APInt(32, 0));
     ConstantInt* one = ConstantInt::get(module->getContext(), APInt(32, 1));
+    ConstantInt* two = ConstantInt::get(module->getContext(), APInt(32, 2));
     ConstantInt* four = ConstantInt::get(module->getContext(), APInt(32, 4));
 
     // Create Fifo access elements
@@ -444,6 +574,12 @@ Function* Fifo::initializeOut(llvm::Module* module, Port* port){
     port->setIndex(index);
     port->setRoomToken(numFreeVar);
 
+    // Record the high-water mark of the fifo when profiling
+    if (!FifoProfileOut.empty()){
+        GlobalVariable* highWater = new GlobalVariable(*module, IntegerType::get(module->getContext(), 32), false, GlobalValue::InternalLinkage, zero, "high_water");
+        highWater->setAlignment(4);
+        port->setHighWater(highWater);
+    }
 
 
     //Create write function
@@ -466,12 +602,19 @@ Function* Fifo::initializeOut(llvm::Module* module, Port* port){
     LoadInst* writeElt = new LoadInst(writeElts, "", false, bb);
     new StoreInst(writeElt, index, false, bb);
 
-    // Call getRoom function
-    Function* getRoomFn = getOrInsertRoomFn(module, port->getType());
+    // Get the number of readers
+    std::vector<Value*> readers_indices;
+    readers_indices.push_back(zero);
+    readers_indices.push_back(two);
+    Instruction* readersPtr = GetElementPtrInst::Create(ptr_74, readers_indices, "", bb);
+    LoadInst* readers = new LoadInst(readersPtr, "", false, bb);
+
+    // Call getRoom function, room is limited by the slowest reader
+    Function* getRoomFn = getOrInsertRoomFn(module, port->getType(), port->isConcurrent());
     LoadInst* fifoVar = new LoadInst(port->getFifoVar(), "", false, bb);
     std::vector<Value*> room_params;
     room_params.push_back(fifoVar);
-    room_params.push_back(one);
+    room_params.push_back(readers);
     CallInst* roomValue = CallInst::Create(getRoomFn, room_params, "", bb);
     roomValue->setTailCall(false);
 
@@ -489,6 +632,8 @@ Function* Fifo::initializeOut(llvm::Module* module, Port* port){
 
     ReturnInst::Create(module->getContext(), bb);
 
+    port->setAccessors(writeFn_port, port->getCloseFn());
+
     return writeFn_port;
 }
 
@@ -516,9 +661,11 @@ Function* Fifo::closeIn(llvm::Module* module, Port* port){
     Instruction* ptr_42 = GetElementPtrInst::Create(FifoVarPtr, read_inds_indices, "", bb);
     LoadInst* ptr_43 = new LoadInst(ptr_42, "", false, bb);
     GetElementPtrInst* ptr_44 = GetElementPtrInst::Create(ptr_43, idPtr, "", bb);
-    new StoreInst(indexPtr, ptr_44, false, bb);
+    createIndexStore(indexPtr, ptr_44, port->isConcurrent(), bb);
     ReturnInst::Create(module->getContext(), bb);
 
+    port->setAccessors(port->getOpenFn(), readEndFn_port);
+
     return readEndFn_port;
 }
 
@@ -543,9 +690,29 @@ Function* Fifo::closeOut(llvm::Module* module, Port* port){
     ptr_20_indices.push_back(zero);
     ptr_20_indices.push_back(four);
     Instruction* ptr_20 = GetElementPtrInst::Create(ptr_19, ptr_20_indices, "", bb);
-    new StoreInst(int32_18, ptr_20, false, bb);
+    createIndexStore(int32_18, ptr_20, port->isConcurrent(), bb);
+
+    // Tokens in the fifo are bounded by size + index - numFree
+    GlobalVariable* highWater = port->getHighWater();
+    if (highWater != NULL){
+        std::vector<Value*> size_indices;
+        size_indices.push_back(zero);
+        size_indices.push_back(zero);
+        Instruction* sizePtr = GetElementPtrInst::Create(ptr_19, size_indices, "", bb);
+        LoadInst* size = new LoadInst(sizePtr, "", false, bb);
+        LoadInst* numFree = new LoadInst(port->getRoomToken(), "", false, bb);
+        BinaryOperator* filled = BinaryOperator::Create(Instruction::Add, size, int32_18, "", bb);
+        BinaryOperator* tokens = BinaryOperator::Create(Instruction::Sub, filled, numFree, "", bb);
+        LoadInst* oldHighWater = new LoadInst(highWater, "", false, bb);
+        ICmpInst* greater = new ICmpInst(*bb, ICmpInst::ICMP_UGT, tokens, oldHighWater, "");
+        SelectInst* newHighWater = SelectInst::Create(greater, tokens, oldHighWater, "", bb);
+        new StoreInst(newHighWater, highWater, false, bb);
+    }
+
     ReturnInst::Create(module->getContext(), bb);
 
+    port->setAccessors(port->getOpenFn(), writeEndFn_port);
+
     return writeEndFn_port;
 }
 
@@ -558,12 +725,12 @@ Fifo::~Fifo(){
 }
 
 
-StructType* Fifo::getOrInsertFifoStruct(Module* module, IntegerType* connectionType){   
+StructType* Fifo::getOrInsertFifoStruct(Module* module, IntegerType* connectionType, bool concurrent){
     int size = connectionType->getBitWidth();
 
     // Set structure name
     stringstream name;
-    name << "fifo_i" << size;
+    name << (concurrent ? "fifo_sync_i" : "fifo_i") << size;
 
 
     Type* fifoType = module->getTypeByName(name.str());
@@ -579,19 +746,22 @@ StructType* Fifo::getOrInsertFifoStruct(Module* module, IntegerType* connectionT
     StructFields.push_back(IntegerType::get(module->getContext(), 32)); // the number of fifo's readers
     StructFields.push_back(PointerType::get(IntegerType::get(module->getContext(), 32), 0)); // the current position of the reader
     StructFields.push_back(IntegerType::get(module->getContext(), 32)); // the current position of the writer
+    if (concurrent){
+        StructFields.push_back(ArrayType::get(IntegerType::get(module->getContext(), 8), CACHE_LINE_SIZE)); // keep other data out of the writer cache line
+    }
 
     //Insert fifo structure in module
     return StructType::create(module->getContext(), StructFields, name.str(), false);
 }
 
 
-Function* Fifo::getOrInsertNumTokensFn(llvm::Module* module, llvm::IntegerType* connectionType){
-    StructType* fifoStruct = getOrInsertFifoStruct(module, connectionType);
+Function* Fifo::getOrInsertNumTokensFn(llvm::Module* module, llvm::IntegerType* connectionType, bool concurrent){
+    StructType* fifoStruct = getOrInsertFifoStruct(module, connectionType, concurrent);
 
     // Set function name
     int size = connectionType->getBitWidth();
     stringstream name;
-    name <<"get_num_Tokens_i"  << size;
+    name << (concurrent ? "get_num_Tokens_sync_i" : "get_num_Tokens_i") << size;
 
     Function* numTokensFn = module->getFunction(name.str());
 
@@ -632,7 +802,7 @@ Function* Fifo::getOrInsertNumTokensFn(llvm::Module* module, llvm::IntegerType*
     ptr_21_indices.push_back(zero);
     ptr_21_indices.push_back(four);
     Instruction* ptr_21 = GetElementPtrInst::Create(ptr_20, ptr_21_indices, "", label_15);
-    LoadInst* int32_22 = new LoadInst(ptr_21, "", false, label_15);
+    LoadInst* int32_22 = createIndexLoad(ptr_21, concurrent, label_15);
     LoadInst* int32_23 = new LoadInst(ptr_17, "", false, label_15);
     CastInst* int64_24 = new ZExtInst(int32_23, IntegerType::get(module->getContext(), 64), "", label_15);
     LoadInst* ptr_25 = new LoadInst(ptr_16, "", false, label_15);
@@ -651,13 +821,13 @@ Function* Fifo::getOrInsertNumTokensFn(llvm::Module* module, llvm::IntegerType*
 }
 
 
-Function* Fifo::getOrInsertRoomFn(Module* module, IntegerType* connectionType){ 
-    StructType* fifoStruct = getOrInsertFifoStruct(module, connectionType);
+Function* Fifo::getOrInsertRoomFn(Module* module, IntegerType* connectionType, bool concurrent){
+    StructType* fifoStruct = getOrInsertFifoStruct(module, connectionType, concurrent);
 
     // Set function name
     int size = connectionType->getBitWidth();
     stringstream name;
-    name <<"get_room_i"  << size;
+    name << (concurrent ? "get_room_sync_i" : "get_room_i") << size;
 
     Function* roomFn = module->getFunction(name.str());
 
@@ -723,7 +893,12 @@ Function* Fifo::getOrInsertRoomFn(Module* module, IntegerType* connectionType){
     Instruction* ptr_35 = GetElementPtrInst::Create(ptr_34, ptr_35_indices, "", label_17);
     LoadInst* int32_36 = new LoadInst(ptr_35, "", false, label_17);
     LoadInst* int32_37 = new LoadInst(ptr_i, "", false, label_17);
-    CastInst* int64_38 = new ZExtInst(int32_37, IntegerType::get(module->getContext(), 64), "", label_17);
+    Value* int64_38 = new ZExtInst(int32_37, IntegerType::get(module->getContext(), 64), "", label_17);
+    if (concurrent){
+        // Read indexes of concurrent readers are in separate cache lines
+        Constant* stride = ConstantInt::get(IntegerType::get(module->getContext(), 64), getReadIndStride(concurrent));
+        int64_38 = BinaryOperator::Create(Instruction::Mul, int64_38, stride, "", label_17);
+    }
     LoadInst* ptr_39 = new LoadInst(ptr_23, "", false, label_17);
     std::vector<Value*> ptr_40_indices;
     ptr_40_indices.push_back(zero);
@@ -731,7 +906,7 @@ Function* Fifo::getOrInsertRoomFn(Module* module, IntegerType* connectionType){
     Instruction* ptr_40 = GetElementPtrInst::Create(ptr_39, ptr_40_indices, "", label_17);
     LoadInst* ptr_41 = new LoadInst(ptr_40, "", false, label_17);
     GetElementPtrInst* ptr_42 = GetElementPtrInst::Create(ptr_41, int64_38, "", label_17);
-    LoadInst* int32_43 = new LoadInst(ptr_42, "", false, label_17);
+    LoadInst* int32_43 = createIndexLoad(ptr_42, concurrent, label_17);
     BinaryOperator* int32_44 = BinaryOperator::Create(Instruction::Sub, int32_36, int32_43, "", label_17);
     new StoreInst(int32_44, ptr_num_tokens, false, label_17);
     LoadInst* int32_46 = new LoadInst(ptr_max_num_tokens, "", false, label_17);
@@ -54,6 +54,7 @@
 #include "DPNScheduler.h"
 #include "CSDFScheduler.h"
 #include "QSDFScheduler.h"
+#include "StaticRegionScheduler.h"
 
 #include "lib/RVCEngine/Decoder.h"
 #include "lib/ConfigurationEngine/Configuration.h"
@@ -63,6 +64,7 @@
 #include "lib/IRCore/Actor/Procedure.h"
 #include "lib/IRCore/Variable.h"
 #include "lib/IRCore/Network/Instance.h"
+#include "lib/RoundRobinScheduler/StaticRegion.h"
 #include "lib/RoundRobinScheduler/RoundRobinScheduler.h"
 #include "lib/IRUtil/TraceMng.h"
 //------------------------------
@@ -70,6 +72,10 @@
 using namespace std;
 using namespace llvm;
 
+cl::opt<bool> StaticRegions("static-regions",
+                            cl::desc("Fire connected CSDF instances as regions with a looped static schedule"),
+                            cl::init(true));
+
 RoundRobinScheduler::RoundRobinScheduler(llvm::LLVMContext& C, Decoder* decoder, list<Instance*>* instances, bool optimized, bool verbose): Context(C) {
     this->decoder = decoder;
     this->instances = instances;
@@ -97,22 +103,90 @@ void RoundRobinScheduler::createScheduler(){
     for (it = instances->begin(); it != instances->end(); it++){
         addInstance(*it);
     }
+
+    //Fire static parts of the network as regions
+    if (optimized && StaticRegions){
+        createRegions();
+    }
+}
+
+void RoundRobinScheduler::createRegions(){
+    StaticRegionScheduler regionScheduler(Context, decoder);
+    list<StaticRegion*> found = StaticRegion::findRegions(instances);
+    int nbInstances = 0;
+
+    list<StaticRegion*>::iterator it;
+    for (it = found.begin(); it != found.end(); it++){
+        StaticRegion* region = *it;
+
+        if (!region->fitsFifos()){
+            if (verbose){
+                cout << "--> Fifos of " << region->getId() << " are too small for an iteration, region is not created." << endl;
+            }
+
+            delete region;
+            continue;
+        }
+
+        // Replace the calls of the instances by a call to the region
+        list<Instance*>::iterator itInst;
+        list<Instance*>* members = region->getInstances();
+        for (itInst = members->begin(); itInst != members->end(); itInst++){
+            removeCall((*itInst)->getActionScheduler()->getSchedulerFunction());
+            instanceRegions.insert(pair<Instance*, StaticRegion*>(*itInst, region));
+            nbInstances++;
+        }
+
+        Function* function = regionScheduler.createRegionScheduler(region);
+        CallInst* callRegion = CallInst::Create(function, "", schedInst);
+        callRegion->setTailCall();
+        regions.insert(pair<StaticRegion*, CallInst*>(region, callRegion));
+    }
+
+    if (verbose){
+        cout << "--> " << regions.size() << " static regions scheduled, covering " << nbInstances << " instances." << endl;
+    }
+}
+
+void RoundRobinScheduler::removeRegion(StaticRegion* region){
+    map<StaticRegion*, CallInst*>::iterator it = regions.find(region);
+    Function* function = it->second->getCalledFunction();
+
+    // Instances of the region are called again one by one
+    list<Instance*>::iterator itInst;
+    list<Instance*>* members = region->getInstances();
+    for (itInst = members->begin(); itInst != members->end(); itInst++){
+        Function* scheduler = (*itInst)->getActionScheduler()->getSchedulerFunction();
+        CallInst* callSched = CallInst::Create(scheduler, "", schedInst);
+        callSched->setTailCall();
+        functionCall.insert(pair<Function*, CallInst*>(scheduler, callSched));
+        instanceRegions.erase(*itInst);
+    }
+
+    it->second->eraseFromParent();
+    function->eraseFromParent();
+    regions.erase(it);
+    delete region;
 }
 
 
 RoundRobinScheduler::~RoundRobinScheduler (){
     scheduler->eraseFromParent();
+
+    map<StaticRegion*, CallInst*>::iterator it;
+    for (it = regions.begin(); it != regions.end(); it++){
+        delete it->first;
+    }
 }
 
 void RoundRobinScheduler::createNetworkScheduler(){
     Module* module = decoder->getModule();
-    LLVMContext &Context = getGlobalContext();
 
     //Create a global value that stop the scheduler and set it to false
     stopGV = new GlobalVariable(*module, Type::getInt32Ty(Context), false, GlobalValue::ExternalLinkage,0,"stop");
 
     // create main scheduler function
-    FunctionType *FT = FunctionType::get(Type::getInt32Ty(getGlobalContext()), false);
+    FunctionType *FT = FunctionType::get(Type::getInt32Ty(Context), false);
     scheduler = Function::Create(FT,  Function::ExternalLinkage, "main", module);
 
     // Add a basic block entry to the scheduler.
@@ -139,7 +213,6 @@ void RoundRobinScheduler::createNetworkInitialize(){
     map<string, Instance*>::iterator it;
 
     Module* module = decoder->getModule();
-    LLVMContext &Context = getGlobalContext();
 
     // create main scheduler function
     initialize = cast<Function>(module->getOrInsertFunction("initialize", Type::getVoidTy(Context),
@@ -203,6 +276,12 @@ void RoundRobinScheduler::addInstance(Instance* instance){
 void RoundRobinScheduler::removeInstance(Instance* instance){
     ActionScheduler* actionScheduler = instance->getActionScheduler();
 
+    // The region of the instance no longer holds
+    map<Instance*, StaticRegion*>::iterator it = instanceRegions.find(instance);
+    if (it != instanceRegions.end()){
+        removeRegion(it->second);
+    }
+
     if (actionScheduler->hasInitializeScheduler()){
         removeCall(actionScheduler->getInitializeFunction());
     }
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class StaticRegion
+@author agent
+@file StaticRegion.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include <set>
+
+#include "llvm/IR/Constants.h"
+
+#include "lib/IRCore/Port.h"
+#include "lib/IRCore/Actor/Action.h"
+#include "lib/IRCore/Actor/Pattern.h"
+#include "lib/IRCore/MoC/CSDFMoC.h"
+#include "lib/IRCore/Network/Connection.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/RoundRobinScheduler/StaticRegion.h"
+//------------------------------
+
+using namespace std;
+using namespace llvm;
+
+static long gcd(long a, long b){
+    while (b != 0){
+        long r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Rates are kept as irreducible fractions, equal rates have the same terms
+static pair<long, long> getRatio(long num, long den){
+    long divisor = gcd(num, den);
+    return make_pair(num / divisor, den / divisor);
+}
+
+static bool isStatic(Instance* instance){
+    MoC* moc = instance->getMoC();
+
+    if (moc == NULL || !moc->isCSDF() || instance->isSuperInstance()){
+        return false;
+    }
+
+    return !((CSDFMoC*)moc)->getActions()->empty();
+}
+
+static int getRate(Port* port){
+    CSDFMoC* moc = (CSDFMoC*)port->getInstance()->getMoC();
+    ConstantInt* numTokens = moc->getInputPattern()->getNumTokens(port);
+
+    if (numTokens == NULL){
+        numTokens = moc->getOutputPattern()->getNumTokens(port);
+    }
+
+    return numTokens == NULL ? 0 : numTokens->getLimitedValue();
+}
+
+int StaticRegion::getInitialTokens(Port* port){
+    int tokens = 0;
+    list<Action*>::iterator it;
+    list<Action*>* initializes = port->getInstance()->getInitializes();
+
+    if (initializes == NULL){
+        return 0;
+    }
+
+    // Patterns of initialize actions may refer to the ports of the actor
+    for (it = initializes->begin(); it != initializes->end(); it++){
+        map<Port*, ConstantInt*>::iterator itTokens;
+        map<Port*, ConstantInt*>* numTokens = (*it)->getOutputPattern()->getNumTokensMap();
+
+        for (itTokens = numTokens->begin(); itTokens != numTokens->end(); itTokens++){
+            if (itTokens->first->getName() == port->getName()){
+                tokens += itTokens->second->getLimitedValue();
+            }
+        }
+    }
+
+    return tokens;
+}
+
+StaticRegion::StaticRegion(string id){
+    this->id = id;
+}
+
+list<StaticRegion*> StaticRegion::findRegions(list<Instance*>* candidates){
+    list<StaticRegion*> regions;
+    set<Instance*> visited;
+    list<Instance*>::iterator it;
+
+    for (it = candidates->begin(); it != candidates->end(); it++){
+        Instance* instance = *it;
+
+        if (visited.find(instance) != visited.end() || !isStatic(instance)){
+            continue;
+        }
+
+        StaticRegion* region = new StaticRegion("region_" + instance->getId());
+        bool consistent = region->computeRepetitions(instance, candidates);
+
+        // Instances of a region can't start another one
+        list<Instance*>::iterator itMember;
+        for (itMember = region->instances.begin(); itMember != region->instances.end(); itMember++){
+            visited.insert(*itMember);
+        }
+
+        if (!consistent || region->instances.size() < 2 || !region->computeOrder() || !region->isConvex()){
+            delete region;
+            continue;
+        }
+
+        regions.push_back(region);
+    }
+
+    return regions;
+}
+
+bool StaticRegion::computeRepetitions(Instance* start, list<Instance*>* candidates){
+    set<Instance*> allowed;
+    map<Instance*, pair<long, long> > rates;
+    list<Instance*> worklist;
+    bool consistent = true;
+
+    list<Instance*>::iterator it;
+    for (it = candidates->begin(); it != candidates->end(); it++){
+        if (isStatic(*it)){
+            allowed.insert(*it);
+        }
+    }
+
+    rates[start] = make_pair(1L, 1L);
+    instances.push_back(start);
+    worklist.push_back(start);
+
+    while (!worklist.empty()){
+        Instance* instance = worklist.front();
+        worklist.pop_front();
+
+        // Propagate rates through inputs and outputs of the instance
+        map<string, Port*>* portMaps[2] = {instance->getInputs(), instance->getOutputs()};
+
+        for (int i = 0; i < 2; i++){
+            map<string, Port*>::iterator itPort;
+            for (itPort = portMaps[i]->begin(); itPort != portMaps[i]->end(); itPort++){
+                Port* port = itPort->second;
+                list<Connection*>::iterator itConn;
+                list<Connection*>* connections = port->getConnections();
+
+                for (itConn = connections->begin(); itConn != connections->end(); itConn++){
+                    Port* srcPort = (*itConn)->getSourcePort();
+                    Port* dstPort = (*itConn)->getDestinationPort();
+                    Port* other = port == srcPort ? dstPort : srcPort;
+                    Instance* next = other->getInstance();
+
+                    if (next == NULL || allowed.find(next) == allowed.end()){
+                        continue;
+                    }
+
+                    int prod = getRate(srcPort);
+                    int cons = getRate(dstPort);
+                    if (prod == 0 || cons == 0){
+                        continue;
+                    }
+
+                    // Tokens produced by an iteration are all consumed
+                    pair<long, long>& current = rates[instance];
+                    pair<long, long> rate = port == srcPort ? getRatio(current.first * prod, current.second * cons)
+                                                            : getRatio(current.first * cons, current.second * prod);
+                    map<Instance*, pair<long, long> >::iterator itRate = rates.find(next);
+
+                    if (itRate == rates.end()){
+                        rates[next] = rate;
+                        instances.push_back(next);
+                        worklist.push_back(next);
+                    }else if (itRate->second != rate){
+                        consistent = false;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!consistent){
+        return false;
+    }
+
+    // Scale rates to the smallest integer repetitions
+    long multiple = 1;
+    map<Instance*, pair<long, long> >::iterator itRate;
+    for (itRate = rates.begin(); itRate != rates.end(); itRate++){
+        long den = itRate->second.second;
+        multiple = multiple / gcd(multiple, den) * den;
+    }
+
+    long divisor = 0;
+    for (itRate = rates.begin(); itRate != rates.end(); itRate++){
+        long repetition = itRate->second.first * (multiple / itRate->second.second);
+        repetitions[itRate->first] = repetition;
+        divisor = gcd(divisor, repetition);
+    }
+
+    map<Instance*, int>::iterator itRep;
+    for (itRep = repetitions.begin(); itRep != repetitions.end(); itRep++){
+        itRep->second /= divisor;
+    }
+
+    return true;
+}
+
+bool StaticRegion::computeOrder(){
+    map<Instance*, int> degrees;
+    list<Instance*> ready;
+    list<Instance*> order;
+    list<Instance*>::iterator it;
+
+    // Count internal predecessors of each instance
+    for (it = instances.begin(); it != instances.end(); it++){
+        degrees.insert(pair<Instance*, int>(*it, 0));
+
+        map<string, Port*>::iterator itPort;
+        map<string, Port*>* outputs = (*it)->getOutputs();
+        for (itPort = outputs->begin(); itPort != outputs->end(); itPort++){
+            list<Connection*>::iterator itConn;
+            list<Connection*>* connections = itPort->second->getConnections();
+
+            for (itConn = connections->begin(); itConn != connections->end(); itConn++){
+                Instance* dst = (*itConn)->getDestinationPort()->getInstance();
+
+                if (contains(dst)){
+                    degrees[dst]++;
+                }
+            }
+        }
+    }
+
+    for (it = instances.begin(); it != instances.end(); it++){
+        if (degrees[*it] == 0){
+            ready.push_back(*it);
+        }
+    }
+
+    // Fire an instance once all its predecessors have been fired
+    while (!ready.empty()){
+        Instance* instance = ready.front();
+        ready.pop_front();
+        order.push_back(instance);
+
+        map<string, Port*>::iterator itPort;
+        map<string, Port*>* outputs = instance->getOutputs();
+        for (itPort = outputs->begin(); itPort != outputs->end(); itPort++){
+            list<Connection*>::iterator itConn;
+            list<Connection*>* connections = itPort->second->getConnections();
+
+            for (itConn = connections->begin(); itConn != connections->end(); itConn++){
+                Instance* dst = (*itConn)->getDestinationPort()->getInstance();
+
+                if (contains(dst) && --degrees[dst] == 0){
+                    ready.push_back(dst);
+                }
+            }
+        }
+    }
+
+    if (order.size() != instances.size()){
+        return false;
+    }
+
+    instances = order;
+    return true;
+}
+
+bool StaticRegion::isConvex(){
+    set<Instance*> visited;
+    list<Instance*> worklist;
+    list<Instance*>::iterator it;
+
+    // Start from the successors of the region
+    for (it = instances.begin(); it != instances.end(); it++){
+        worklist.push_back(*it);
+    }
+
+    while (!worklist.empty()){
+        Instance* instance = worklist.front();
+        worklist.pop_front();
+
+        map<string, Port*>::iterator itPort;
+        map<string, Port*>* outputs = instance->getOutputs();
+        for (itPort = outputs->begin(); itPort != outputs->end(); itPort++){
+            list<Connection*>::iterator itConn;
+            list<Connection*>* connections = itPort->second->getConnections();
+
+            for (itConn = connections->begin(); itConn != connections->end(); itConn++){
+                Instance* dst = (*itConn)->getDestinationPort()->getInstance();
+
+                if (dst == NULL){
+                    continue;
+                }
+
+                if (contains(dst)){
+                    // A path outside of the region comes back to it
+                    if (!contains(instance)){
+                        return false;
+                    }
+                    continue;
+                }
+
+                if (visited.insert(dst).second){
+                    worklist.push_back(dst);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+int StaticRegion::getRepetition(Instance* instance){
+    map<Instance*, int>::iterator it = repetitions.find(instance);
+
+    if (it == repetitions.end()){
+        return 0;
+    }
+
+    return it->second;
+}
+
+bool StaticRegion::isInternal(Connection* connection){
+    Instance* src = connection->getSourcePort()->getInstance();
+    Instance* dst = connection->getDestinationPort()->getInstance();
+
+    return contains(src) && contains(dst);
+}
+
+int StaticRegion::getTokens(Port* port){
+    return getRepetition(port->getInstance()) * getRate(port);
+}
+
+bool StaticRegion::fitsFifos(){
+    list<Instance*>::iterator it;
+
+    for (it = instances.begin(); it != instances.end(); it++){
+        map<string, Port*>::iterator itPort;
+        map<string, Port*>* outputs = (*it)->getOutputs();
+
+        for (itPort = outputs->begin(); itPort != outputs->end(); itPort++){
+            Port* port = itPort->second;
+            list<Connection*>::iterator itConn;
+            list<Connection*>* connections = port->getConnections();
+
+            for (itConn = connections->begin(); itConn != connections->end(); itConn++){
+                // Tokens produced by initialize actions stay in the fifo during an iteration
+                if (isInternal(*itConn) && (*itConn)->getSize() < getTokens(port) + getInitialTokens(port)){
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
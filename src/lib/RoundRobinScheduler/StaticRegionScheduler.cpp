@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Implementation of class StaticRegionScheduler
+@author agent
+@file StaticRegionScheduler.cpp
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#include "StaticRegionScheduler.h"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+#include "lib/RVCEngine/Decoder.h"
+#include "lib/IRCore/Actor/ActionScheduler.h"
+#include "lib/IRCore/Actor/Pattern.h"
+#include "lib/IRCore/MoC/CSDFMoC.h"
+#include "lib/IRCore/Network/Connection.h"
+#include "lib/IRCore/Network/Instance.h"
+#include "lib/RoundRobinScheduler/StaticRegion.h"
+//------------------------------
+
+using namespace llvm;
+using namespace std;
+
+static bool isFifoAccess(Function* function, Instance* instance){
+    // Accessors are recorded on the ports when their fifo is opened and closed
+    map<string, Port*>* portMaps[2] = {instance->getInputs(), instance->getOutputs()};
+
+    for (int i = 0; i < 2; i++){
+        map<string, Port*>::iterator itPort;
+        for (itPort = portMaps[i]->begin(); itPort != portMaps[i]->end(); itPort++){
+            if (itPort->second->isAccessor(function)){
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+StaticRegionScheduler::StaticRegionScheduler(llvm::LLVMContext& C, Decoder* decoder) : CSDFScheduler(C, decoder) {
+
+}
+
+Function* StaticRegionScheduler::createRegionScheduler(StaticRegion* region){
+    string name = region->getId();
+    name.append("_scheduler");
+
+    FunctionType* FT = FunctionType::get(Type::getInt32Ty(Context), false);
+    Function* scheduler = Function::Create(FT, GlobalValue::ExternalLinkage, name, module);
+
+    //Create values
+    ConstantInt *Zero = ConstantInt::get(Context, APInt(32, 0));
+    ConstantInt *One = ConstantInt::get(Context, APInt(32, 1));
+
+    // Add a basic block entry to the scheduler, %i counts iterations of the region
+    entryBB = BasicBlock::Create(Context, "entry", scheduler);
+    AllocaInst* iVar = new AllocaInst(Type::getInt32Ty(Context), "i", entryBB);
+    new StoreInst(Zero, iVar, entryBB);
+
+    bb1 = BasicBlock::Create(Context, "bb", scheduler);
+    BranchInst::Create(bb1, entryBB);
+
+    // Add a basic block return that return %i
+    returnBB = BasicBlock::Create(Context, "return", scheduler);
+    LoadInst* loadIRet = new LoadInst(iVar, "i_ret", returnBB);
+    ReturnInst::Create(Context, loadIRet, returnBB);
+
+    // Add a basic block inc that increments %i and branch to bb
+    incBB = BasicBlock::Create(Context, "inc_i", scheduler);
+    LoadInst* loadIInc = new LoadInst(iVar, "i_load", incBB);
+    BinaryOperator* iAdd = BinaryOperator::CreateNSWAdd(loadIInc, One, "i_add", incBB);
+    new StoreInst(iAdd, iVar, incBB);
+    BranchInst::Create(bb1, incBB);
+
+    // Fifos of the region are opened and closed once per call
+    list<Instance*>::iterator it;
+    list<Instance*>* instances = region->getInstances();
+    for (it = instances->begin(); it != instances->end(); it++){
+        copyFifoAccesses(*it, entryBB->getTerminator(), returnBB->getTerminator());
+    }
+
+    // Test the border of the region for a whole iteration
+    Pattern input;
+    Pattern output;
+    createBorderPatterns(region, &input, &output);
+
+    BasicBlock* skipBB = BasicBlock::Create(Context, "skip", scheduler);
+    BranchInst::Create(returnBB, skipBB);
+
+    BasicBlock* BB = checkInputPattern(&input, scheduler, skipBB, bb1);
+    BB = checkOutputPattern(&output, scheduler, skipBB, BB);
+
+    // Fire instances following the order of the region
+    for (it = instances->begin(); it != instances->end(); it++){
+        BB = createLoop(*it, region->getRepetition(*it), BB, scheduler);
+    }
+
+    // A region without border can't be tested, fire it once per call
+    if (input.isEmpty() && output.isEmpty()){
+        BranchInst::Create(returnBB, BB);
+    }else{
+        BranchInst::Create(incBB, BB);
+    }
+
+    return scheduler;
+}
+
+void StaticRegionScheduler::copyFifoAccesses(Instance* instance, Instruction* open, Instruction* close){
+    Function* scheduler = instance->getActionScheduler()->getSchedulerFunction();
+    Function::iterator itBB;
+
+    for (itBB = scheduler->begin(); itBB != scheduler->end(); itBB++){
+        BasicBlock* BB = itBB;
+        Instruction* insertPos;
+
+        // Fifos are opened in the entry block and closed in the return block
+        if (BB == &scheduler->getEntryBlock()){
+            insertPos = open;
+        }else if (isa<ReturnInst>(BB->getTerminator())){
+            insertPos = close;
+        }else{
+            continue;
+        }
+
+        BasicBlock::iterator itInst;
+        for (itInst = BB->begin(); itInst != BB->end(); itInst++){
+            CallInst* call = dyn_cast<CallInst>(itInst);
+
+            if (call != NULL && isFifoAccess(call->getCalledFunction(), instance)){
+                CallInst::Create(call->getCalledFunction(), "", insertPos);
+            }
+        }
+    }
+}
+
+void StaticRegionScheduler::createBorderPatterns(StaticRegion* region, Pattern* input, Pattern* output){
+    list<Instance*>::iterator it;
+    list<Instance*>* instances = region->getInstances();
+
+    for (it = instances->begin(); it != instances->end(); it++){
+        Instance* instance = *it;
+        map<string, Port*>* portMaps[2] = {instance->getInputs(), instance->getOutputs()};
+        Pattern* patterns[2] = {input, output};
+
+        for (int i = 0; i < 2; i++){
+            map<string, Port*>::iterator itPort;
+            for (itPort = portMaps[i]->begin(); itPort != portMaps[i]->end(); itPort++){
+                Port* port = itPort->second;
+                int tokens = region->getTokens(port);
+
+                if (tokens == 0){
+                    continue;
+                }
+
+                // Only ports with a connection outside of the region are tested
+                list<Connection*>::iterator itConn;
+                list<Connection*>* connections = port->getConnections();
+                for (itConn = connections->begin(); itConn != connections->end(); itConn++){
+                    if (!region->isInternal(*itConn)){
+                        patterns[i]->setNumTokens(port, ConstantInt::get(Type::getInt32Ty(Context), tokens));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+BasicBlock* StaticRegionScheduler::createLoop(Instance* instance, int repetition, BasicBlock* BB, Function* function){
+    CSDFMoC* moc = (CSDFMoC*)instance->getMoC();
+
+    if (repetition == 1){
+        createActionsCall(moc, BB);
+        return BB;
+    }
+
+    ConstantInt* zero = ConstantInt::get(Type::getInt32Ty(Context), 0);
+    ConstantInt* one = ConstantInt::get(Type::getInt32Ty(Context), 1);
+    ConstantInt* count = ConstantInt::get(Type::getInt32Ty(Context), repetition);
+
+    BasicBlock* loopBB = BasicBlock::Create(Context, "loop_" + instance->getId(), function);
+    BasicBlock* exitBB = BasicBlock::Create(Context, "fired_" + instance->getId(), function);
+    BranchInst::Create(loopBB, BB);
+
+    // Fire the instance until its repetition is reached
+    PHINode* firing = PHINode::Create(Type::getInt32Ty(Context), 2, "firing", loopBB);
+    createActionsCall(moc, loopBB);
+    BinaryOperator* next = BinaryOperator::CreateNSWAdd(firing, one, "", loopBB);
+    ICmpInst* test = new ICmpInst(*loopBB, ICmpInst::ICMP_ULT, next, count, "");
+    BranchInst::Create(loopBB, exitBB, test, loopBB);
+
+    firing->addIncoming(zero, BB);
+    firing->addIncoming(next, loopBB);
+
+    return exitBB;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2009, IETR/INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of the IETR/INSA of Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+@brief Description of the StaticRegionScheduler interface
+@author agent
+@file StaticRegionScheduler.h
+@version 1.0
+@date 17/10/2026
+*/
+
+//------------------------------
+#ifndef STATICREGIONSCHEDULER_H
+#define STATICREGIONSCHEDULER_H
+
+#include "CSDFScheduler.h"
+
+class StaticRegion;
+//------------------------------
+
+/**
+ * @brief  This class defines a looped scheduler for a static region.
+ *
+ * The scheduler of a region tests the tokens and rooms of the ports that
+ * cross the border of the region for a whole iteration, then fires the
+ * actions of each instance of the region in order, as many times as given
+ * by the repetition vector of the region.
+ *
+ * Instances of the region must already own a CSDF action scheduler, the
+ * fifo accesses of their ports are shared with the region scheduler.
+ *
+ * @author agent
+ *
+ */
+class StaticRegionScheduler : public CSDFScheduler {
+public:
+    /**
+     *  @brief Constructor
+     *
+     *  Create a new scheduler for static regions
+     *
+     *  @param C : the llvm::Context
+     *
+     *  @param decoder : the Decoder where the region scheduler is inserted
+     */
+    StaticRegionScheduler(llvm::LLVMContext& C, Decoder* decoder);
+    ~StaticRegionScheduler(){}
+
+    /**
+     *  @brief Create the scheduler of a static region
+     *
+     *  @param region : the StaticRegion to schedule
+     *
+     *  @return the scheduling llvm::Function of the region
+     */
+    llvm::Function* createRegionScheduler(StaticRegion* region);
+
+private:
+    /**
+     *  @brief Copy the fifo accesses of the action scheduler of an instance
+     *
+     *  Only the calls to the functions opening and closing the fifos of the ports
+     *    of the instance are copied.
+     *
+     *  @param instance : the Instance of the region
+     *
+     *  @param open : llvm::Instruction before which fifos are opened
+     *
+     *  @param close : llvm::Instruction before which fifos are closed
+     */
+    void copyFifoAccesses(Instance* instance, llvm::Instruction* open, llvm::Instruction* close);
+
+    /**
+     *  @brief Create the patterns tested at the border of the region
+     *
+     *  @param region : the StaticRegion
+     *
+     *  @param input : the Pattern that receives the tokens needed by an iteration
+     *
+     *  @param output : the Pattern that receives the rooms needed by an iteration
+     */
+    void createBorderPatterns(StaticRegion* region, Pattern* input, Pattern* output);
+
+    /**
+     *  @brief Fire all the actions of an instance a given number of times
+     *
+     *  @param instance : the Instance to fire
+     *
+     *  @param repetition : number of firings of the instance
+     *
+     *  @param BB : llvm::BasicBlock where the firings are added
+     *
+     *  @param function : llvm::Function of the region scheduler
+     *
+     *  @return the llvm::BasicBlock following the firings
+     */
+    llvm::BasicBlock* createLoop(Instance* instance, int repetition, llvm::BasicBlock* BB, llvm::Function* function);
+};
+
+#endif
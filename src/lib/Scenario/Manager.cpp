@@ -39,6 +39,7 @@
 #include <iostream>
 
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/CommandLine.h"
 
 #include "lib/RVCEngine/RVCEngine.h"
 #include "lib/XDFSerialize/XDFParser.h"
@@ -47,15 +48,14 @@
 
 #include "ScenarioParser.h"
 
-extern "C" {
-extern char* input_file;
-}
-
 //------------------------------
 
 using namespace std;
 using namespace llvm;
 
+extern cl::opt<bool> HotReconfigure;
+extern cl::opt<int> DecoderPool;
+
 Manager::Manager(RVCEngine* engine, int optLevel, bool verify, bool verbose){
     this->engine = engine;
     this->verbose = verbose;
@@ -136,13 +136,14 @@ bool Manager::runLoadEvent(LoadEvent* loadEvent){
         cout << "-> Execute load event :" << endl;
         cout << "--> Parsing network :" << endl;
     }
-    //Load network
-    LLVMContext &Context = getGlobalContext();
+    //Load network in a context of its own
+    LLVMContext* Context = new LLVMContext();
     XDFParser xdfParser(verbose);
-    Network* network = xdfParser.parseFile(loadEvent->getFile(), Context);
+    Network* network = xdfParser.parseFile(loadEvent->getFile(), *Context);
 
     if (network == NULL){
         cerr << "Event error ! No network load." << endl;
+        delete Context;
         return false;
     }
 
@@ -189,9 +190,8 @@ bool Manager::runStartEvent(StartEvent* startEvent) {
         return false;
     }
 
-    //Set input file
+    //Get input file
     string input = startEvent->getInput();
-    input_file = (char*)input.c_str();
 
     string mappingFile = startEvent->mappingFile();
     if(!mappingFile.empty()) {
@@ -204,7 +204,7 @@ bool Manager::runStartEvent(StartEvent* startEvent) {
     }
 
     //Execute network
-    engine->run(netPtr->second);
+    engine->run(netPtr->second, input);
 
     if (verbose){
         cout << "-> Decoder started in :"<< (clock () - timer) * 1000 / CLOCKS_PER_SEC <<" ms." << endl;
@@ -327,13 +327,23 @@ bool Manager::runSetEvent(SetEvent* setEvent){
         cout << "--> Start parsing network :" << endl;
     }
 
-    //Load network
-    LLVMContext &Context = getGlobalContext();
+    //Decoders built aside the running one need a context of their own,
+    //otherwise the network is parsed in the context of the decoder it reconfigures
+    LLVMContext* Context = netPtr->second->getContext();
+    bool ownContext = HotReconfigure || DecoderPool > 0 || Context == NULL;
+
+    if (ownContext){
+        Context = new LLVMContext();
+    }
+
     XDFParser xdfParser(verbose);
-    Network* network = xdfParser.parseFile(setEvent->getFile(), Context);
+    Network* network = xdfParser.parseFile(setEvent->getFile(), *Context);
 
     if (network == NULL){
         cout << "No network load." << endl;
+        if (ownContext){
+            delete Context;
+        }
         return false;
     }
 
@@ -344,7 +354,7 @@ bool Manager::runSetEvent(SetEvent* setEvent){
     }
 
     //Reconfiguration decoder
-    engine->reconfigure(netPtr->second, network);
+    engine->reconfigure(netPtr->second, network, optLevel);
 
     if (verbose){
         cout << "--> Decoder reconfigured in : "<< (clock () - timer1) * 1000 / CLOCKS_PER_SEC <<" ms." << endl;
@@ -303,7 +303,8 @@ Vertex* NetworkParser::getVertex(string vertexName, string portName, string kind
             exit(1);
         }
 
-        return new Vertex(it->second);
+        // Connect the vertex of the instance so that the graph sees its edges
+        return it->second->getVertex();
     }
 
 }
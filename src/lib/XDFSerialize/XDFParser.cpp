@@ -49,12 +49,24 @@ XDFParser::XDFParser (bool verbose){
 
 Network* XDFParser::parseFile (string filename, llvm::LLVMContext& C){
     NetworkParser networkParser(C);
-    return networkParser.parseNetworkFile(filename);
+    Network* network = networkParser.parseNetworkFile(filename);
+
+    if (network != NULL){
+        network->setContext(&C);
+    }
+
+    return network;
 }
 
 Network* XDFParser::parseChar (char* XML, llvm::LLVMContext& C){
     NetworkParser networkParser(C);
-    return networkParser.parseXML(XML);
+    Network* network = networkParser.parseXML(XML);
+
+    if (network != NULL){
+        network->setContext(&C);
+    }
+
+    return network;
 }
 
 XDFParser::~XDFParser (){
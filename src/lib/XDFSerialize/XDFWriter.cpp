@@ -238,8 +238,7 @@ TiXmlElement* XDFWriter::writeType(IRType* type){
     }else if(type->isIntType()){
         name = XDFNetwork::TYPE_INT;
         size = ((IntType*)type)->getSize();
-        llvm::LLVMContext &Context = llvm::getGlobalContext();
-        typeElt->LinkEndChild(writeEntry(XDFNetwork::TYPE_SIZE, new IntExpr(Context, size)));
+        typeElt->LinkEndChild(writeEntry(XDFNetwork::TYPE_SIZE, size));
     }else if(type->isListType()){
         name = XDFNetwork::TYPE_LIST;
         cerr << "List type is not supported yet";
@@ -248,8 +247,7 @@ TiXmlElement* XDFWriter::writeType(IRType* type){
     }else if(type->isUintType()){
         name = XDFNetwork::TYPE_UINT;
         size = ((UIntType*)type)->getSize();
-        llvm::LLVMContext &Context = llvm::getGlobalContext();
-        typeElt->LinkEndChild(writeEntry(XDFNetwork::TYPE_SIZE, new IntExpr(Context, size)));
+        typeElt->LinkEndChild(writeEntry(XDFNetwork::TYPE_SIZE, size));
     }else if(type->isVoidType()){
         cerr << "void type is invalid in XDF";
     }else{
@@ -269,3 +267,19 @@ TiXmlElement* XDFWriter::writeEntry(string name, Expr *expr){
 
     return entry;
 }
+
+TiXmlElement* XDFWriter::writeEntry(string name, int value){
+    TiXmlElement* entry = new TiXmlElement(XDFNetwork::ENTRY);
+    TiXmlElement* exprElt = new TiXmlElement(XDFNetwork::EXPR);
+
+    entry->SetAttribute(XDFNetwork::KIND, XDFNetwork::KIND_TYPE);
+    entry->SetAttribute(XDFNetwork::NAME, name.c_str());
+    entry->LinkEndChild(exprElt);
+
+    // Networks not built by the XDF parser have no context to create an expression in
+    exprElt->SetAttribute(XDFNetwork::KIND, XDFNetwork::KIND_LITERAL);
+    exprElt->SetAttribute(XDFNetwork::LITERAL_KIND, XDFNetwork::LITERAL_INT);
+    exprElt->SetAttribute(XDFNetwork::LITERAL_VALUE, value);
+
+    return entry;
+}